@@ -1,9 +1,17 @@
 #include "Arena.h"
-#include <random>
 #include <cmath>
 #include <algorithm>
 #include <iostream>
 
+// Spatial grid covering the playable world (meters). Anything outside is
+// clamped into the border cells, so it stays correct, just less selective.
+constexpr float GRID_MIN_X = -32.0f;
+constexpr float GRID_MAX_X =  32.0f;
+constexpr float GRID_MIN_Y = -32.0f;
+constexpr float GRID_MAX_Y =  24.0f;
+constexpr float GRID_CELL_SIZE = 1.0f;
+
+#ifndef STICKBRAWL_HEADLESS
 // ============================================================
 // PLATFORM TYPE COLORS
 // ============================================================
@@ -31,6 +39,7 @@ sf::Color Arena::outlineColorForType(PlatformType type) {
         default: return sf::Color(150, 150, 150);
     }
 }
+#endif // STICKBRAWL_HEADLESS
 
 // ============================================================
 // LEVEL MANAGEMENT
@@ -48,20 +57,61 @@ std::string Arena::getLevelName(int index) {
     }
 }
 
-void Arena::addPlatform(Physics& physics, float cx, float cy, float hw, float hh, PlatformType type) {
+Arena::Arena() {
+    m_grid.reset(GRID_MIN_X, GRID_MIN_Y, GRID_MAX_X, GRID_MAX_Y, GRID_CELL_SIZE);
+}
+
+int Arena::addPlatform(Physics& physics, float cx, float cy, float hw, float hh, PlatformType type) {
     Platform p;
     p.cx = cx; p.cy = cy; p.halfWidth = hw; p.halfHeight = hh;
-    p.bodyId = physics.createStaticBox(cx, cy, hw, hh, CAT_PLATFORM);
     p.alive = true;
     p.type = type;
-    m_platforms.push_back(p);
+    p.group = static_cast<int>(m_groupBodies.size());
+    m_groupBodies.push_back(physics.createStaticBody(0.0f, 0.0f));
+    attachShape(physics, p);
+    m_batchDirty = true;
+    return insertPlatform(p);
+}
+
+// Group bodies sit at the origin, so the box is placed in world coordinates
+void Arena::attachShape(Physics& physics, Platform& p) {
+    p.shapeId = physics.addStaticBoxShape(m_groupBodies[p.group], p.cx, p.cy,
+                                          p.halfWidth, p.halfHeight, CAT_PLATFORM);
+}
+
+// Stores a live platform in a free slot (or a new one) and indexes it
+int Arena::insertPlatform(const Platform& p) {
+    int id;
+    if (!m_freeSlots.empty()) {
+        id = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_platforms[id] = p;
+    } else {
+        id = static_cast<int>(m_platforms.size());
+        m_platforms.push_back(p);
+    }
+    m_grid.insert(id, p.cx - p.halfWidth, p.cy - p.halfHeight, p.cx + p.halfWidth, p.cy + p.halfHeight);
+    return id;
+}
+
+// Marks a slot dead and unindexes it; the caller owns the Box2D shape
+void Arena::removePlatform(int id) {
+    Platform& p = m_platforms[id];
+    m_grid.remove(id, p.cx - p.halfWidth, p.cy - p.halfHeight, p.cx + p.halfWidth, p.cy + p.halfHeight);
+    p.alive = false;
+    m_freeSlots.push_back(id);
 }
 
 void Arena::createLevel(Physics& physics, int levelIndex) {
     m_physics = &physics;
     m_platforms.clear();
+    m_freeSlots.clear();
+    m_grid.clear();
+    m_groupBodies.clear();
     m_spawnPoints.clear();
     m_currentLevel = levelIndex;
+    m_batchDirty = true;
+    m_bitmap.reset();
 
     switch (levelIndex) {
         case 0: buildClassic(physics); break;
@@ -72,7 +122,39 @@ void Arena::createLevel(Physics& physics, int levelIndex) {
     }
 
     std::cout << "[Arena] Built level: " << getLevelName(levelIndex)
-              << " (" << m_platforms.size() << " platforms)\n";
+              << " (" << getPlatformCount() << " platforms)\n";
+
+    if (m_useBitmap) rasterizeToBitmap(physics);
+}
+
+// Replaces the box platforms with a pixel mask of the same layout. Later
+// platforms overwrite earlier ones, matching the draw order.
+void Arena::rasterizeToBitmap(Physics& physics) {
+    m_bitmap = std::make_unique<BitmapTerrain>();
+    for (const auto& p : m_platforms) {
+        if (!p.alive) continue;
+        m_bitmap->fillRect(p.cx - p.halfWidth, p.cy - p.halfHeight,
+                           p.cx + p.halfWidth, p.cy + p.halfHeight,
+                           static_cast<uint8_t>(static_cast<int>(p.type) + 1));
+    }
+    for (b2BodyId body : m_groupBodies) b2DestroyBody(body);
+    m_groupBodies.clear();
+    m_platforms.clear();
+    m_freeSlots.clear();
+    m_grid.clear();
+    m_bitmap->rebuildDirtyChunks(physics);
+
+#ifndef STICKBRAWL_HEADLESS
+    std::array<sf::Color, 8> fill{}, outline{};
+    for (int t = 0; t <= static_cast<int>(PlatformType::Roof); t++) {
+        fill[t + 1]    = fillColorForType(static_cast<PlatformType>(t));
+        outline[t + 1] = outlineColorForType(static_cast<PlatformType>(t));
+    }
+    m_bitmap->setPalette(fill, outline);
+#endif
+
+    std::cout << "[Arena] Rasterized to " << m_bitmap->getCols() << "x"
+              << m_bitmap->getRows() << " terrain bitmap\n";
 }
 
 // ============================================================
@@ -210,19 +292,24 @@ void Arena::buildSkyscrapers(Physics& physics) {
 // RANDOM PLATFORM TOP
 // ============================================================
 
-b2Vec2 Arena::getRandomPlatformTop() const {
+b2Vec2 Arena::getRandomPlatformTop(Rng& rng) const {
+    if (m_bitmap) {
+        for (int attempt = 0; attempt < 32; attempt++) {
+            float x = rng.uniform(BitmapTerrain::MIN_X + 1.0f, BitmapTerrain::MAX_X - 1.0f);
+            float y;
+            if (m_bitmap->findSurface(x, y)) return {x, y + 0.5f};
+        }
+        return {0.0f, 0.0f};
+    }
+
     std::vector<size_t> aliveIdx;
     for (size_t i = 0; i < m_platforms.size(); i++) {
         if (m_platforms[i].alive && m_platforms[i].halfWidth > 0.5f) aliveIdx.push_back(i);
     }
     if (aliveIdx.empty()) return {0.0f, 0.0f};
 
-    static std::mt19937 rng(std::random_device{}());
-    std::uniform_int_distribution<size_t> dist(0, aliveIdx.size() - 1);
-    const auto& p = m_platforms[aliveIdx[dist(rng)]];
-
-    std::uniform_real_distribution<float> xDist(-p.halfWidth * 0.8f, p.halfWidth * 0.8f);
-    return {p.cx + xDist(rng), p.cy + p.halfHeight + 0.5f};
+    const auto& p = m_platforms[aliveIdx[rng.uniformInt(0, static_cast<int>(aliveIdx.size()) - 1)]];
+    return {p.cx + rng.uniform(-p.halfWidth * 0.8f, p.halfWidth * 0.8f), p.cy + p.halfHeight + 0.5f};
 }
 
 // ============================================================
@@ -230,7 +317,7 @@ b2Vec2 Arena::getRandomPlatformTop() const {
 // ============================================================
 //
 // Carves a circular hole out of all overlapping platforms.
-// Each affected platform is destroyed and replaced by up to 4
+// Each affected platform's shape is destroyed and replaced by up to 4
 // axis-aligned remnant rectangles (left, right, top, bottom)
 // from the portions outside the carve circle's bounding box.
 //
@@ -241,12 +328,25 @@ b2Vec2 Arena::getRandomPlatformTop() const {
 //
 // Tiny remnants (< minimum size) are discarded. This gives a
 // chunky, blocky deformation that looks like Worms terrain.
+// Remnants stay on their parent's group body, so the body count
+// never grows past the level's platform count.
+//
+// Only platforms registered in the grid cells under the carve's
+// bounding box are tested, so cost scales with nearby fragments
+// rather than with every remnant the round has produced so far.
 
 int Arena::carveCircle(Physics& physics, float ex, float ey, float radius) {
     if (radius < 0.05f) return 0;
 
+    if (m_bitmap) {
+        if (!m_bitmap->carveCircle(ex, ey, radius)) return 0;
+        m_bitmap->rebuildDirtyChunks(physics);
+        return 1;
+    }
+
     int affected = 0;
-    std::vector<Platform> newPlatforms;
+    std::vector<Platform>& newPlatforms = m_carveRemnants;
+    newPlatforms.clear();
 
     // Carve bounding box
     float carveLeft   = ex - radius;
@@ -257,7 +357,14 @@ int Arena::carveCircle(Physics& physics, float ex, float ey, float radius) {
     constexpr float MIN_HW = 0.15f; // minimum half-width for a remnant
     constexpr float MIN_HH = 0.08f; // minimum half-height for a remnant
 
-    for (auto& plat : m_platforms) {
+    m_carveCandidates.clear();
+    m_grid.query(carveLeft, carveBottom, carveRight, carveTop, m_carveCandidates);
+    // Grid cell order depends on insert/remove history; sorting keeps carves
+    // identical after a state restore rebuilds the grid
+    std::sort(m_carveCandidates.begin(), m_carveCandidates.end());
+
+    for (int id : m_carveCandidates) {
+        Platform& plat = m_platforms[id];
         if (!plat.alive) continue;
 
         float pLeft   = plat.cx - plat.halfWidth;
@@ -278,8 +385,8 @@ int Arena::carveCircle(Physics& physics, float ex, float ey, float radius) {
 
         // This platform IS affected — destroy it
         affected++;
-        b2DestroyBody(plat.bodyId);
-        plat.alive = false;
+        b2DestroyShape(plat.shapeId, false);
+        removePlatform(id);
 
         PlatformType type = plat.type;
 
@@ -302,7 +409,8 @@ int Arena::carveCircle(Physics& physics, float ex, float ey, float radius) {
                 r.halfHeight = plat.halfHeight;
                 r.type = type;
                 r.alive = true;
-                r.bodyId = physics.createStaticBox(r.cx, r.cy, r.halfWidth, r.halfHeight, CAT_PLATFORM);
+                r.group = plat.group;
+                attachShape(physics, r);
                 newPlatforms.push_back(r);
             }
         }
@@ -320,7 +428,8 @@ int Arena::carveCircle(Physics& physics, float ex, float ey, float radius) {
                 r.halfHeight = plat.halfHeight;
                 r.type = type;
                 r.alive = true;
-                r.bodyId = physics.createStaticBox(r.cx, r.cy, r.halfWidth, r.halfHeight, CAT_PLATFORM);
+                r.group = plat.group;
+                attachShape(physics, r);
                 newPlatforms.push_back(r);
             }
         }
@@ -341,7 +450,8 @@ int Arena::carveCircle(Physics& physics, float ex, float ey, float radius) {
                 r.halfHeight = hh;
                 r.type = type;
                 r.alive = true;
-                r.bodyId = physics.createStaticBox(r.cx, r.cy, r.halfWidth, r.halfHeight, CAT_PLATFORM);
+                r.group = plat.group;
+                attachShape(physics, r);
                 newPlatforms.push_back(r);
             }
         }
@@ -362,70 +472,317 @@ int Arena::carveCircle(Physics& physics, float ex, float ey, float radius) {
                 r.halfHeight = hh;
                 r.type = type;
                 r.alive = true;
-                r.bodyId = physics.createStaticBox(r.cx, r.cy, r.halfWidth, r.halfHeight, CAT_PLATFORM);
+                r.group = plat.group;
+                attachShape(physics, r);
                 newPlatforms.push_back(r);
             }
         }
     }
 
-    // Clean up dead, add remnants
+    // Add remnants into the slots just freed, then tidy up around them
     if (affected > 0) {
-        m_platforms.erase(
-            std::remove_if(m_platforms.begin(), m_platforms.end(),
-                            [](const Platform& p) { return !p.alive; }),
-            m_platforms.end());
-        for (auto& np : newPlatforms) m_platforms.push_back(np);
+        m_carveNewIds.clear();
+        for (const auto& np : newPlatforms) m_carveNewIds.push_back(insertPlatform(np));
+        compactPlatforms(physics, m_carveNewIds);
+        enforceFragmentBudget(physics);
+        m_batchDirty = true;
     }
 
     return affected;
 }
 
+// ============================================================
+// TERRAIN COMPACTION
+// ============================================================
+//
+// Carving leaves neighbouring remnants that line up exactly, e.g. two
+// LEFT/RIGHT slivers of the same height sitting edge to edge. Each of
+// those is its own shape, so after a long round the broadphase
+// and the render batch fill up with tiny boxes. After every carve the
+// new remnants are greedily merged with any touching, co-planar
+// neighbour of the same PlatformType:
+//
+//   [AAAA][BB]   ->  [AAAAAA]     same bottom/top, shared vertical edge
+//
+//   [AA]             [AA]
+//   [BB]         ->  [AA]         same left/right, shared horizontal edge
+//
+// A merged box is immediately retried, so runs collapse in one pass.
+
+constexpr float MERGE_EPSILON = 0.01f;
+
+int Arena::mergeWithNeighbour(Physics& physics, int id) {
+    const Platform p = m_platforms[id];
+    float pLeft = p.cx - p.halfWidth, pRight = p.cx + p.halfWidth;
+    float pBottom = p.cy - p.halfHeight, pTop = p.cy + p.halfHeight;
+
+    m_mergeCandidates.clear();
+    m_grid.query(pLeft - MERGE_EPSILON, pBottom - MERGE_EPSILON,
+                 pRight + MERGE_EPSILON, pTop + MERGE_EPSILON, m_mergeCandidates);
+    std::sort(m_mergeCandidates.begin(), m_mergeCandidates.end());
+
+    for (int otherId : m_mergeCandidates) {
+        if (otherId == id) continue;
+        const Platform& o = m_platforms[otherId];
+        if (!o.alive || o.type != p.type) continue;
+
+        float oLeft = o.cx - o.halfWidth, oRight = o.cx + o.halfWidth;
+        float oBottom = o.cy - o.halfHeight, oTop = o.cy + o.halfHeight;
+
+        bool sameRows = std::fabs(oBottom - pBottom) < MERGE_EPSILON && std::fabs(oTop - pTop) < MERGE_EPSILON;
+        bool sameCols = std::fabs(oLeft - pLeft) < MERGE_EPSILON && std::fabs(oRight - pRight) < MERGE_EPSILON;
+        bool touchX = std::fabs(oRight - pLeft) < MERGE_EPSILON || std::fabs(pRight - oLeft) < MERGE_EPSILON;
+        bool touchY = std::fabs(oTop - pBottom) < MERGE_EPSILON || std::fabs(pTop - oBottom) < MERGE_EPSILON;
+        if (!(sameRows && touchX) && !(sameCols && touchY)) continue;
+
+        float left   = std::min(pLeft, oLeft);
+        float right  = std::max(pRight, oRight);
+        float bottom = std::min(pBottom, oBottom);
+        float top    = std::max(pTop, oTop);
+
+        b2DestroyShape(p.shapeId, false);
+        b2DestroyShape(o.shapeId, false);
+        removePlatform(id);
+        removePlatform(otherId);
+
+        Platform merged;
+        merged.cx = (left + right) / 2.0f;
+        merged.cy = (bottom + top) / 2.0f;
+        merged.halfWidth = (right - left) / 2.0f;
+        merged.halfHeight = (top - bottom) / 2.0f;
+        merged.type = p.type;
+        merged.alive = true;
+        merged.group = std::min(p.group, o.group);
+        attachShape(physics, merged);
+        return insertPlatform(merged);
+    }
+    return -1;
+}
+
+void Arena::compactPlatforms(Physics& physics, const std::vector<int>& ids) {
+    for (int id : ids) {
+        // Earlier merges may have consumed this slot
+        while (id >= 0 && m_platforms[id].alive)
+            id = mergeWithNeighbour(physics, id);
+    }
+}
+
+// Normally only the new remnants are merged. Once the live count passes
+// m_fragmentBudget, every fragment gets a merge pass in slot order, which
+// catches runs that only line up after several carves. Nothing is deleted:
+// dropping "small" pieces could pull the floor out from under a player, so
+// the budget may stay exceeded when nothing is left to merge.
+void Arena::enforceFragmentBudget(Physics& physics) {
+    if (m_fragmentBudget <= 0 || getPlatformCount() <= m_fragmentBudget) return;
+
+    m_budgetIds.clear();
+    for (int i = 0; i < static_cast<int>(m_platforms.size()); i++)
+        if (m_platforms[i].alive) m_budgetIds.push_back(i);
+    compactPlatforms(physics, m_budgetIds);
+}
+
+// ============================================================
+// STATE CAPTURE
+// ============================================================
+
+namespace {
+// Platform without its shape id, which is only valid in the world that made
+// it. Written field by field: the struct has tail padding.
+struct PlatformState {
+    static constexpr size_t BYTES = 4 * sizeof(float) + sizeof(int32_t) + sizeof(PlatformType) + sizeof(bool);
+
+    float cx, cy, halfWidth, halfHeight;
+    int32_t group;
+    PlatformType type;
+    bool alive;
+
+    void write(StateWriter& out) const {
+        out.write(cx);
+        out.write(cy);
+        out.write(halfWidth);
+        out.write(halfHeight);
+        out.write(group);
+        out.write(type);
+        out.write(alive);
+    }
+    void read(StateReader& in) {
+        in.read(cx);
+        in.read(cy);
+        in.read(halfWidth);
+        in.read(halfHeight);
+        in.read(group);
+        in.read(type);
+        in.read(alive);
+    }
+};
+} // namespace
+
+void Arena::saveState(StateWriter& out) const {
+    out.write(m_currentLevel);
+    out.write(static_cast<uint8_t>(m_bitmap ? 1 : 0));
+    if (m_bitmap) {
+        m_bitmap->saveState(out);
+        return;
+    }
+
+    out.write(static_cast<uint32_t>(m_platforms.size()));
+    for (const auto& p : m_platforms)
+        PlatformState{p.cx, p.cy, p.halfWidth, p.halfHeight, p.group, p.type, p.alive}.write(out);
+    out.writeVector(m_freeSlots);
+}
+
+bool Arena::loadState(StateReader& in, Physics& physics) {
+    int level = 0;
+    uint8_t bitmap = 0;
+    in.read(level);
+    in.read(bitmap);
+    if (!in.ok() || level != m_currentLevel || (bitmap != 0) != (m_bitmap != nullptr)) {
+        std::cerr << "[Arena] State does not match the current level\n";
+        return false;
+    }
+
+    if (m_bitmap) {
+        if (!m_bitmap->loadState(in)) return false;
+        m_bitmap->recreateColliders(physics);
+        return true;
+    }
+
+    uint32_t count = 0;
+    if (!in.read(count) || in.remaining() < static_cast<size_t>(count) * PlatformState::BYTES)
+        return false;
+
+    // Read and check everything before touching the live slots
+    const int groupCount = static_cast<int>(m_groupBodies.size());
+    std::vector<Platform>& loaded = m_loadScratch;
+    loaded.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+        PlatformState st;
+        st.read(in);
+        if (st.alive && (st.group < 0 || st.group >= groupCount)) {
+            std::cerr << "[Arena] Platform " << i << " has no group body\n";
+            return false;
+        }
+        Platform& p = loaded[i];
+        p.cx = st.cx; p.cy = st.cy;
+        p.halfWidth = st.halfWidth; p.halfHeight = st.halfHeight;
+        p.type = st.type;
+        p.alive = st.alive;
+        p.group = st.group;
+        p.shapeId = b2_nullShapeId;
+    }
+    if (!in.readVector(m_loadFreeSlots)) return false;
+    for (int id : m_loadFreeSlots) {
+        if (id < 0 || id >= static_cast<int>(count) || loaded[id].alive) {
+            std::cerr << "[Arena] Bad free slot " << id << "\n";
+            return false;
+        }
+    }
+
+    // The render batch only depends on what is drawn, so a load that brings
+    // back the same platforms (every checkpoint rebuild) keeps it
+    bool sameLook = loaded.size() == m_platforms.size();
+    for (size_t i = 0; sameLook && i < loaded.size(); i++) {
+        const Platform& a = loaded[i];
+        const Platform& b = m_platforms[i];
+        sameLook = a.alive == b.alive && (!a.alive ||
+                   (a.cx == b.cx && a.cy == b.cy && a.halfWidth == b.halfWidth &&
+                    a.halfHeight == b.halfHeight && a.type == b.type));
+    }
+
+    // The world was reset, so every group body and shape is recreated: group
+    // bodies in level order, then the boxes in slot order
+    for (b2BodyId& body : m_groupBodies) body = physics.createStaticBody(0.0f, 0.0f);
+    m_platforms.swap(loaded);
+    m_freeSlots.swap(m_loadFreeSlots);
+    for (Platform& p : m_platforms)
+        if (p.alive) attachShape(physics, p);
+
+    m_grid.clear();
+    for (int id = 0; id < static_cast<int>(m_platforms.size()); id++) {
+        const Platform& p = m_platforms[id];
+        if (p.alive)
+            m_grid.insert(id, p.cx - p.halfWidth, p.cy - p.halfHeight, p.cx + p.halfWidth, p.cy + p.halfHeight);
+    }
+    if (!sameLook) m_batchDirty = true;
+    return true;
+}
+
+#ifndef STICKBRAWL_HEADLESS
 // ============================================================
 // RENDERING
 // ============================================================
 
-void Arena::draw(sf::RenderTarget& target) const {
+// All platform geometry — outlines, fills and texture details — is baked
+// into one triangle list so the static level costs a single draw call. The
+// batch is only rebuilt after createLevel/carveCircle change m_platforms.
+// Per-platform emit order matches the old shape-by-shape drawing, so
+// overlapping platforms still layer the same way.
+
+static void appendRect(sf::VertexArray& va, float x, float y, float w, float h, sf::Color c) {
+    sf::Vertex tl{{x, y}, c}, tr{{x + w, y}, c};
+    sf::Vertex bl{{x, y + h}, c}, br{{x + w, y + h}, c};
+    va.append(tl); va.append(tr); va.append(br);
+    va.append(tl); va.append(br); va.append(bl);
+}
+
+static void appendDisc(sf::VertexArray& va, sf::Vector2f center, float radius, sf::Color c) {
+    constexpr int segs = 8;
+    for (int i = 0; i < segs; i++) {
+        float a0 = static_cast<float>(i) / segs * 6.2831853f;
+        float a1 = static_cast<float>(i + 1) / segs * 6.2831853f;
+        va.append(sf::Vertex{center, c});
+        va.append(sf::Vertex{{center.x + std::cos(a0) * radius, center.y + std::sin(a0) * radius}, c});
+        va.append(sf::Vertex{{center.x + std::cos(a1) * radius, center.y + std::sin(a1) * radius}, c});
+    }
+}
+
+void Arena::rebuildBatch() const {
     auto toScreen = [](float x, float y) -> sf::Vector2f {
         return {SCREEN_CX + x * PPM, SCREEN_CY - y * PPM};
     };
 
+    m_batch.clear();
+    m_batch.setPrimitiveType(sf::PrimitiveType::Triangles);
+
     for (const auto& p : m_platforms) {
         if (!p.alive) continue;
 
         float w = p.halfWidth * 2.0f * PPM;
         float h = p.halfHeight * 2.0f * PPM;
-        sf::RectangleShape rect({w, h});
-        rect.setPosition(toScreen(p.cx - p.halfWidth, p.cy + p.halfHeight));
+        sf::Vector2f tl = toScreen(p.cx - p.halfWidth, p.cy + p.halfHeight);
+
+        // 1px outline outside the fill, as sf::Shape draws it
+        sf::Color oc = outlineColorForType(p.type);
+        appendRect(m_batch, tl.x - 1.0f, tl.y - 1.0f, w + 2.0f, 1.0f, oc);
+        appendRect(m_batch, tl.x - 1.0f, tl.y + h,    w + 2.0f, 1.0f, oc);
+        appendRect(m_batch, tl.x - 1.0f, tl.y,        1.0f, h, oc);
+        appendRect(m_batch, tl.x + w,    tl.y,        1.0f, h, oc);
 
-        rect.setFillColor(fillColorForType(p.type));
-        rect.setOutlineColor(outlineColorForType(p.type));
-        rect.setOutlineThickness(1.0f);
-        target.draw(rect);
+        appendRect(m_batch, tl.x, tl.y, w, h, fillColorForType(p.type));
 
         // Texture details
-        sf::Vector2f tl = toScreen(p.cx - p.halfWidth, p.cy + p.halfHeight);
         if (p.type == PlatformType::Brick && w > 10.0f && h > 6.0f) {
-            for (float by = 6.0f; by < h; by += 6.0f) {
-                sf::VertexArray line(sf::PrimitiveType::Lines, 2);
-                line[0] = sf::Vertex{{tl.x + 1.0f, tl.y + by}, sf::Color(100, 35, 30, 80)};
-                line[1] = sf::Vertex{{tl.x + w - 1.0f, tl.y + by}, sf::Color(100, 35, 30, 80)};
-                target.draw(line);
-            }
+            for (float by = 6.0f; by < h; by += 6.0f)
+                appendRect(m_batch, tl.x + 1.0f, tl.y + by - 0.5f, w - 2.0f, 1.0f, sf::Color(100, 35, 30, 80));
         } else if (p.type == PlatformType::Wood && w > 8.0f) {
-            for (float wy = 4.0f; wy < h; wy += 5.0f) {
-                sf::VertexArray line(sf::PrimitiveType::Lines, 2);
-                line[0] = sf::Vertex{{tl.x + 2.0f, tl.y + wy}, sf::Color(80, 55, 25, 60)};
-                line[1] = sf::Vertex{{tl.x + w - 2.0f, tl.y + wy}, sf::Color(80, 55, 25, 60)};
-                target.draw(line);
-            }
+            for (float wy = 4.0f; wy < h; wy += 5.0f)
+                appendRect(m_batch, tl.x + 2.0f, tl.y + wy - 0.5f, w - 4.0f, 1.0f, sf::Color(80, 55, 25, 60));
         } else if (p.type == PlatformType::Metal && w > 8.0f) {
-            for (float rx = 6.0f; rx < w; rx += 12.0f) {
-                sf::CircleShape rivet(1.5f);
-                rivet.setOrigin({1.5f, 1.5f});
-                rivet.setPosition({tl.x + rx, tl.y + h * 0.5f});
-                rivet.setFillColor(sf::Color(180, 190, 210, 100));
-                target.draw(rivet);
-            }
+            for (float rx = 6.0f; rx < w; rx += 12.0f)
+                appendDisc(m_batch, {tl.x + rx, tl.y + h * 0.5f}, 1.5f, sf::Color(180, 190, 210, 100));
         }
     }
+
+    m_batchDirty = false;
+}
+
+void Arena::draw(sf::RenderTarget& target) const {
+    if (m_bitmap) {
+        m_bitmap->draw(target);
+        return;
+    }
+    if (m_batchDirty) rebuildBatch();
+    target.draw(m_batch);
 }
+
+#endif // STICKBRAWL_HEADLESS
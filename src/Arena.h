@@ -1,8 +1,15 @@
 #pragma once
 #include "Physics.h"
+#include "PlatformGrid.h"
+#include "BitmapTerrain.h"
+#include "Rng.h"
+#include "StateBuffer.h"
+#ifndef STICKBRAWL_HEADLESS
 #include <SFML/Graphics.hpp>
+#endif
 #include <vector>
 #include <string>
+#include <memory>
 
 enum class PlatformType {
     Ground,     // dark grey
@@ -13,8 +20,11 @@ enum class PlatformType {
     Roof,       // dark red
 };
 
+// One box of terrain. Every piece carved from the same level platform is a
+// shape on that platform's static body, so carving never adds bodies.
 struct Platform {
-    b2BodyId bodyId;
+    b2ShapeId shapeId;
+    int group = 0;      // index of the level platform it was carved from
     float halfWidth;
     float halfHeight;
     float cx, cy;
@@ -24,34 +34,95 @@ struct Platform {
 
 class Arena {
 public:
+    Arena();
+
     void createLevel(Physics& physics, int levelIndex);
+#ifndef STICKBRAWL_HEADLESS
     void draw(sf::RenderTarget& target) const;
+#endif
     const std::vector<b2Vec2>& getSpawnPoints() const { return m_spawnPoints; }
+
+    // Slot array: carved platforms leave dead entries (alive == false) that
+    // are reused by later remnants, so always check Platform::alive
     const std::vector<Platform>& getPlatforms() const { return m_platforms; }
+    int getPlatformCount() const { return static_cast<int>(m_platforms.size() - m_freeSlots.size()); }
+
+    // Adds a level platform (with its own static body) and returns its slot id
+    int addPlatform(Physics& physics, float cx, float cy, float hw, float hh,
+                    PlatformType type = PlatformType::Ground);
 
-    b2Vec2 getRandomPlatformTop() const;
+    b2Vec2 getRandomPlatformTop(Rng& rng) const;
 
     // Worms-style terrain carving: removes a circular chunk from all platforms
     // Returns number of platforms affected
     int carveCircle(Physics& physics, float cx, float cy, float radius);
 
+    // Soft cap on live platforms: a carve that leaves more than this re-merges
+    // every fragment with its neighbours, not just the new remnants. Terrain
+    // is never removed to meet it. 0 = unlimited.
+    void setFragmentBudget(int maxPlatforms) { m_fragmentBudget = maxPlatforms; }
+
+    // Bitmap mode rasterizes the level into a BitmapTerrain after building it;
+    // the platform list is then empty and carving/drawing go through the mask.
+    // Must be set before createLevel.
+    void setBitmapTerrain(bool enabled) { m_useBitmap = enabled; }
+    const BitmapTerrain* getBitmapTerrain() const { return m_bitmap.get(); }
+
+    // Platform slots (or the bitmap mask) for keyframes/snapshots. loadState
+    // expects the same level to be built already and the world to have just
+    // been reset (Physics::reset): it recreates every terrain body and shape.
+    void saveState(StateWriter& out) const;
+    bool loadState(StateReader& in, Physics& physics);
+
     static int getLevelCount();
     static std::string getLevelName(int index);
 
 private:
-    void addPlatform(Physics& physics, float cx, float cy, float hw, float hh,
-                     PlatformType type = PlatformType::Ground);
+    int  insertPlatform(const Platform& p);
+    void attachShape(Physics& physics, Platform& p);
+    void removePlatform(int id);
+
+    int  mergeWithNeighbour(Physics& physics, int id);
+    void compactPlatforms(Physics& physics, const std::vector<int>& ids);
+    void enforceFragmentBudget(Physics& physics);
 
     std::vector<Platform> m_platforms;
+    std::vector<int>      m_freeSlots;
+    PlatformGrid          m_grid;
+
+    // Scratch buffers reused across carves
+    std::vector<int>      m_carveCandidates;
+    std::vector<Platform> m_carveRemnants;
+    std::vector<int>      m_carveNewIds;
+    std::vector<int>      m_mergeCandidates;
+    std::vector<int>      m_budgetIds;
+    std::vector<Platform> m_loadScratch;
+    std::vector<int>      m_loadFreeSlots;
+
+    // One static body per level platform, indexed by Platform::group
+    std::vector<b2BodyId> m_groupBodies;
+
+    int m_fragmentBudget = 0;
+    bool m_useBitmap = false;
+    std::unique_ptr<BitmapTerrain> m_bitmap;
     std::vector<b2Vec2>   m_spawnPoints;
     Physics* m_physics = nullptr;
     int m_currentLevel = 0;
 
+    // Set whenever m_platforms changes; draw() rebuilds the render batch lazily
+    mutable bool m_batchDirty = true;
+
     void buildClassic(Physics& physics);
     void buildVillage(Physics& physics);
     void buildFortress(Physics& physics);
     void buildSkyscrapers(Physics& physics);
+    void rasterizeToBitmap(Physics& physics);
+
+#ifndef STICKBRAWL_HEADLESS
+    void rebuildBatch() const;
+    mutable sf::VertexArray m_batch;
 
     static sf::Color fillColorForType(PlatformType type);
     static sf::Color outlineColorForType(PlatformType type);
+#endif
 };
@@ -0,0 +1,726 @@
+// StickBrawlBench — microbenchmarks for simulation and render hot paths.
+// Every run is seeded, so the same build on the same machine replays the same
+// work; --json saves the results and --compare checks them against a saved
+// baseline.
+#include "Arena.h"
+#include "BitmapTerrain.h"
+#include "BotController.h"
+#include "GameSnapshot.h"
+#include "HUD.h"
+#include "ParticleSystem.h"
+#include "Physics.h"
+#include "Replay.h"
+#include "Replication.h"
+#include <SFML/Graphics.hpp>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using BenchClock = std::chrono::steady_clock;
+
+struct LatencyStats {
+    double meanUs = 0.0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+};
+
+static LatencyStats summarize(std::vector<double>& samplesUs) {
+    LatencyStats st;
+    if (samplesUs.empty()) return st;
+    std::sort(samplesUs.begin(), samplesUs.end());
+    double sum = 0.0;
+    for (double v : samplesUs) sum += v;
+    st.meanUs = sum / static_cast<double>(samplesUs.size());
+    st.p50Us = samplesUs[samplesUs.size() / 2];
+    st.p99Us = samplesUs[std::min(samplesUs.size() - 1, samplesUs.size() * 99 / 100)];
+    st.maxUs = samplesUs.back();
+    return st;
+}
+
+// ============================================================
+// RESULTS
+// ============================================================
+
+// One timed operation. `name` is the key --compare matches on, so keep it
+// stable, e.g. "carveCircle/1000".
+struct BenchResult {
+    std::string  name;
+    size_t       ops = 0;
+    LatencyStats stats;
+};
+
+static std::vector<BenchResult> g_results;
+static std::string g_filter;  // run only benchmarks whose name contains this
+
+static bool selected(const std::string& name) {
+    return g_filter.empty() || name.find(g_filter) != std::string::npos;
+}
+
+static LatencyStats record(const std::string& name, std::vector<double>& samplesUs) {
+    LatencyStats st = summarize(samplesUs);
+    g_results.push_back({name, samplesUs.size(), st});
+    return st;
+}
+
+static void printLine(const std::string& name, const std::string& detail, const LatencyStats& st) {
+    std::cout << std::fixed << std::setprecision(2)
+              << std::left << std::setw(24) << name << std::right << detail
+              << " | mean " << std::setw(8) << st.meanUs << " us"
+              << " | p50 " << std::setw(8) << st.p50Us << " us"
+              << " | p99 " << std::setw(8) << st.p99Us << " us"
+              << " | max " << std::setw(8) << st.maxUs << " us\n";
+}
+
+// Tiles `count` small platforms at constant density (so the number of
+// platforms near any carve is the same at every size) and times random
+// carves inside the tiled area.
+static void benchCarve(int count, int carves, unsigned int seed) {
+    constexpr float TILE_W = 0.5f;
+    constexpr float TILE_H = 0.3f;
+
+    Physics physics;
+    Arena arena;
+
+    int cols = std::max(1, static_cast<int>(std::sqrt(static_cast<float>(count) * TILE_H / TILE_W)));
+    int rows = (count + cols - 1) / cols;
+    float originX = -cols * TILE_W * 0.5f;
+    float originY = -rows * TILE_H * 0.5f;
+    for (int i = 0; i < count; i++) {
+        float cx = originX + (static_cast<float>(i % cols) + 0.5f) * TILE_W;
+        float cy = originY + (static_cast<float>(i / cols) + 0.5f) * TILE_H;
+        arena.addPlatform(physics, cx, cy, TILE_W * 0.48f, TILE_H * 0.48f, PlatformType::Stone);
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> xDist(originX, -originX);
+    std::uniform_real_distribution<float> yDist(originY, -originY);
+    std::uniform_real_distribution<float> rDist(0.3f, 0.8f);
+
+    std::vector<double> samples;
+    samples.reserve(static_cast<size_t>(carves));
+    int before = arena.getPlatformCount();
+    for (int i = 0; i < carves; i++) {
+        float x = xDist(rng), y = yDist(rng), r = rDist(rng);
+        auto t0 = BenchClock::now();
+        arena.carveCircle(physics, x, y, r);
+        samples.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - t0).count());
+    }
+    int after = arena.getPlatformCount();
+
+    LatencyStats st = record("carveCircle/" + std::to_string(count), samples);
+    std::cout << std::fixed << std::setprecision(2)
+              << "carveCircle  platforms " << std::setw(6) << before << " -> " << std::setw(6) << after
+              << " | " << carves << " carves"
+              << " | mean " << std::setw(8) << st.meanUs << " us"
+              << " | p50 " << std::setw(8) << st.p50Us << " us"
+              << " | p99 " << std::setw(8) << st.p99Us << " us"
+              << " | max " << std::setw(8) << st.maxUs << " us\n";
+}
+
+// Same carves against a solid bitmap slab: mask update plus re-tracing the
+// dirty chunks' chain colliders.
+static void benchBitmapCarve(int carves, unsigned int seed) {
+    Physics physics;
+    BitmapTerrain terrain;
+    terrain.fillRect(-15.0f, -6.0f, 15.0f, 2.0f, 1);
+    terrain.rebuildDirtyChunks(physics);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> xDist(-15.0f, 15.0f);
+    std::uniform_real_distribution<float> yDist(-6.0f, 2.0f);
+    std::uniform_real_distribution<float> rDist(0.3f, 0.8f);
+
+    std::vector<double> samples;
+    samples.reserve(static_cast<size_t>(carves));
+    for (int i = 0; i < carves; i++) {
+        float x = xDist(rng), y = yDist(rng), r = rDist(rng);
+        auto t0 = BenchClock::now();
+        terrain.carveCircle(x, y, r);
+        terrain.rebuildDirtyChunks(physics);
+        samples.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - t0).count());
+    }
+
+    LatencyStats st = record("carveBitmap", samples);
+    std::cout << std::fixed << std::setprecision(2)
+              << "carveBitmap  " << terrain.getCols() << "x" << terrain.getRows() << " cells"
+              << " | " << carves << " carves"
+              << " | mean " << std::setw(8) << st.meanUs << " us"
+              << " | p50 " << std::setw(8) << st.p50Us << " us"
+              << " | p99 " << std::setw(8) << st.p99Us << " us"
+              << " | max " << std::setw(8) << st.maxUs << " us\n";
+}
+
+// Bot match captured on every checkpoint tick the way rollback would; every
+// 60 ticks the match is rolled back to the oldest checkpoint in the ring and
+// carries on from there.
+static void benchSnapshot(const WeaponFactory& weapons, int ticks, unsigned int seed) {
+    GameRules rules;
+    Match match(rules, weapons);
+    std::vector<PlayerSetup> setups;
+    std::vector<BotController> bots;
+    for (int i = 0; i < 4; i++) {
+        setups.push_back({static_cast<CharacterType>(i), sf::Color::White});
+        bots.emplace_back(i, seed + static_cast<unsigned int>(i));
+    }
+    match.start(1, setups, false, seed);
+
+    constexpr uint32_t RING = 8;
+    std::vector<GameSnapshot> ring(RING);
+    std::vector<double> captureUs, restoreUs;
+    captureUs.reserve(static_cast<size_t>(ticks));
+    size_t maxBytes = 0;
+    PlayerInputs inputs;
+    for (int i = 0; i < ticks && !match.isRoundOver(); i++) {
+        uint32_t tick = match.getTick();
+        uint32_t slot = tick / Match::CHECKPOINT_INTERVAL % RING;
+        if (Match::isCheckpoint(tick)) {
+            auto t0 = BenchClock::now();
+            ring[slot].capture(match);
+            captureUs.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - t0).count());
+            maxBytes = std::max(maxBytes, ring[slot].getSize());
+        }
+
+        if (i % 60 == 59 && ring[(slot + 1) % RING].isValid()) {
+            // The next ring slot holds the oldest capture
+            auto t0 = BenchClock::now();
+            ring[(slot + 1) % RING].restore(match);
+            restoreUs.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - t0).count());
+        }
+
+        for (size_t b = 0; b < bots.size(); b++) inputs[b] = bots[b].think(match);
+        match.update(FIXED_DT, inputs);
+    }
+
+    for (auto* samples : {&captureUs, &restoreUs}) {
+        size_t ops = samples->size();
+        const char* name = samples == &captureUs ? "snapCapture" : "snapRestore";
+        LatencyStats st = record(name, *samples);
+        std::cout << std::fixed << std::setprecision(2)
+                  << name
+                  << "  " << std::setw(6) << ops << " ops, <= " << maxBytes << " bytes"
+                  << " | mean " << std::setw(8) << st.meanUs << " us"
+                  << " | p50 " << std::setw(8) << st.p50Us << " us"
+                  << " | p99 " << std::setw(8) << st.p99Us << " us"
+                  << " | max " << std::setw(8) << st.maxUs << " us\n";
+    }
+}
+
+// Whole Match::update on a 4-bot match, reported twice: every tick, and only
+// the checkpoint ticks that rebuild the physics world (the difference is the
+// rebuild's cost).
+static void benchMatchTick(const WeaponFactory& weapons, int ticks, unsigned int seed) {
+    GameRules rules;
+    Match match(rules, weapons);
+    std::vector<PlayerSetup> setups;
+    std::vector<BotController> bots;
+    for (int i = 0; i < 4; i++) {
+        setups.push_back({static_cast<CharacterType>(i), sf::Color::White});
+        bots.emplace_back(i, seed + static_cast<unsigned int>(i));
+    }
+    match.start(1, setups, false, seed);
+
+    std::vector<double> allUs, checkpointUs;
+    allUs.reserve(static_cast<size_t>(ticks));
+    PlayerInputs inputs;
+    for (int i = 0; i < ticks && !match.isRoundOver(); i++) {
+        for (size_t b = 0; b < bots.size(); b++) inputs[b] = bots[b].think(match);
+        bool checkpoint = Match::isCheckpoint(match.getTick());
+        auto t0 = BenchClock::now();
+        match.update(FIXED_DT, inputs);
+        double us = std::chrono::duration<double, std::micro>(BenchClock::now() - t0).count();
+        allUs.push_back(us);
+        if (checkpoint) checkpointUs.push_back(us);
+    }
+
+    printLine("matchTick", std::to_string(allUs.size()) + " ticks", record("matchTick", allUs));
+    printLine("matchTick/checkpoint", std::to_string(checkpointUs.size()) + " ticks",
+              record("matchTick/checkpoint", checkpointUs));
+}
+
+// Streams a match through one client's ReplicationEncoder/Decoder pair over a
+// simulated link (`rttTicks` round trip, `lossPercent` loss in each direction)
+// and reports the bandwidth that client would use. Every decoded packet is
+// checked against the state it was encoded from, and the carves the client
+// applied against the ones the server made.
+struct ReplicationLink {
+    int   rttTicks = 6;
+    float lossPercent = 2.0f;
+};
+
+static void benchReplication(const std::string& label, Match& match,
+                             const std::function<bool(PlayerInputs&)>& nextInputs,
+                             const ReplicationLink& link, unsigned int seed) {
+    struct InFlight {
+        uint32_t arriveTick;
+        std::vector<uint8_t> data;  // state packet, or empty for an ack
+        uint16_t ackSeq;
+    };
+
+    ReplicationBounds bounds(match.getRules());
+    ReplicationEncoder encoder;
+    ReplicationDecoder decoder;
+    ReplicatedState state;
+    std::vector<ReplicatedState> sentStates(ReplicationEncoder::HISTORY);
+    std::vector<CarveEvent> serverCarves, clientCarves;
+    std::deque<InFlight> toClient, toServer;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> lossDist(0.0f, 100.0f);
+    int oneWay = std::max(1, link.rttTicks / 2);
+
+    uint64_t packets = 0, bytes = 0, rawBytes = 0, fullPackets = 0, fullBytes = 0;
+    uint64_t decoded = 0, mismatches = 0;
+    std::vector<double> encodeUs;
+    std::vector<uint8_t> packet;
+    PlayerInputs inputs;
+
+    uint32_t now = 0;
+    while (!match.isRoundOver() && nextInputs(inputs)) {
+        match.update(FIXED_DT, inputs);
+        const auto& carves = match.getCarveEvents();
+        serverCarves.insert(serverCarves.end(), carves.begin(), carves.end());
+
+        auto t0 = BenchClock::now();
+        state.capture(match, bounds);
+        bool full = !encoder.hasBaseline();
+        uint16_t seq = encoder.getNextSeq();
+        packet.clear();
+        encoder.encode(state, carves, packet);
+        encodeUs.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - t0).count());
+        sentStates[seq % ReplicationEncoder::HISTORY] = state;
+
+        packets++;
+        bytes += packet.size();
+        if (full) { fullPackets++; fullBytes += packet.size(); }
+        // The same state as plain floats: tick, then per player 6 parts x
+        // (x, y, angle) and 7 scalar fields, 2 floats + weapon id per
+        // projectile and pickup, 4 floats + flag per explosion, 3 per carve
+        rawBytes += 4 + state.playerCount * (6 * 12 + 7 * 4) + state.projectiles.size() * 10 +
+                    state.pickups.size() * 10 + state.explosions.size() * 17 + carves.size() * 12;
+
+        if (lossDist(rng) >= link.lossPercent) toClient.push_back({now + oneWay, packet, 0});
+
+        while (!toClient.empty() && toClient.front().arriveTick <= now) {
+            const auto& in = toClient.front();
+            if (decoder.decode(in.data.data(), in.data.size())) {
+                decoded++;
+                if (!decoder.getState().samePayload(sentStates[decoder.getAckSeq() % ReplicationEncoder::HISTORY]))
+                    mismatches++;
+                const auto& fresh = decoder.getNewCarves();
+                clientCarves.insert(clientCarves.end(), fresh.begin(), fresh.end());
+                if (lossDist(rng) >= link.lossPercent) toServer.push_back({now + oneWay, {}, decoder.getAckSeq()});
+            }
+            toClient.pop_front();
+        }
+        while (!toServer.empty() && toServer.front().arriveTick <= now) {
+            encoder.acknowledge(toServer.front().ackSeq);
+            toServer.pop_front();
+        }
+        now++;
+    }
+
+    bool carvesMatch = clientCarves.size() <= serverCarves.size() &&
+        std::equal(clientCarves.begin(), clientCarves.end(), serverCarves.begin(),
+                   [](const CarveEvent& a, const CarveEvent& b) {
+                       return a.x == b.x && a.y == b.y && a.radius == b.radius;
+                   });
+
+    LatencyStats st = record("replicationEncode/" + label, encodeUs);
+    double seconds = std::max(1.0, static_cast<double>(packets)) * FIXED_DT;
+    std::cout << std::fixed << std::setprecision(2)
+              << "replication " << label << "  " << packets << " ticks, rtt " << link.rttTicks
+              << " ticks, loss " << link.lossPercent << "%\n"
+              << "  " << std::setw(8) << bytes / seconds / 1024.0 << " KiB/s per client"
+              << " | " << std::setw(6) << static_cast<double>(bytes) / std::max<uint64_t>(1, packets) << " B/packet"
+              << " | full " << std::setw(6) << static_cast<double>(fullBytes) / std::max<uint64_t>(1, fullPackets) << " B"
+              << " | raw floats " << std::setw(8) << rawBytes / seconds / 1024.0 << " KiB/s ("
+              << std::setprecision(1) << 100.0 * static_cast<double>(bytes) / std::max<uint64_t>(1, rawBytes) << "%)\n"
+              << std::setprecision(2)
+              << "  encode mean " << st.meanUs << " us, max " << st.maxUs << " us"
+              << " | decoded " << decoded << ", mismatches " << mismatches
+              << " | carves " << clientCarves.size() << "/" << serverCarves.size()
+              << (carvesMatch ? " in order" : " OUT OF ORDER") << "\n";
+}
+
+static void benchReplicationReplay(const WeaponFactory& weapons, const std::string& path,
+                                   const ReplicationLink& link, unsigned int seed) {
+    ReplayReader reader;
+    if (!reader.load(path)) {
+        std::cerr << "[Bench] Could not load replay " << path << "\n";
+        return;
+    }
+    const ReplayHeader& header = reader.getHeader();
+    auto match = std::make_unique<Match>(header.rules, weapons);
+    match->start(header.levelIndex, header.players, header.wrapAround, header.seed);
+    benchReplication(path, *match, [&](PlayerInputs& in) { return reader.next(in); }, link, seed);
+}
+
+static void benchReplicationBots(const WeaponFactory& weapons, int ticks,
+                                 const ReplicationLink& link, unsigned int seed) {
+    GameRules rules;
+    Match match(rules, weapons);
+    std::vector<PlayerSetup> setups;
+    std::vector<BotController> bots;
+    for (int i = 0; i < 4; i++) {
+        setups.push_back({static_cast<CharacterType>(i), sf::Color::White});
+        bots.emplace_back(i, seed + static_cast<unsigned int>(i));
+    }
+    match.start(1, setups, false, seed);
+    int remaining = ticks;
+    benchReplication("4 bots", match, [&](PlayerInputs& in) {
+        for (size_t b = 0; b < bots.size(); b++) in[b] = bots[b].think(match);
+        return remaining-- > 0;
+    }, link, seed);
+}
+
+// `count` bullets parked mid-air, clear of every player, so each pass runs
+// the full per-projectile path (wrap, hit tests, lifetime) without any of
+// them detonating. Dead slots are refilled between samples.
+static void benchProjectiles(const WeaponFactory& weapons, int count, int passes, unsigned int seed) {
+    const WeaponData* bullet = nullptr;
+    for (const auto& w : weapons.getAllWeapons())
+        if (w.type == WeaponType::Projectile) { bullet = &w; break; }
+    if (!bullet) {
+        std::cerr << "[Bench] No projectile weapon loaded, skipping updateProjectiles\n";
+        return;
+    }
+
+    GameRules rules;
+    rules.maxProjectiles = count;
+    Match match(rules, weapons);
+    std::vector<PlayerSetup> setups = {{CharacterType::Stick, sf::Color::White},
+                                       {CharacterType::Cat, sf::Color::White}};
+    match.start(1, setups, false, seed);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> xDist(-18.0f, 18.0f);
+    std::uniform_real_distribution<float> yDist(9.0f, 12.0f);
+
+    std::vector<double> samples;
+    samples.reserve(static_cast<size_t>(passes));
+    for (int i = 0; i < passes; i++) {
+        while (static_cast<int>(match.getProjectiles().getActive().size()) < count) {
+            Projectile* proj = match.fireProjectile(*bullet, -1, {xDist(rng), yDist(rng)}, {0.0f, 0.0f},
+                                                    0.15f, 0.1f);
+            if (!proj) break;
+            proj->lifetime = 1e6f;
+        }
+        auto t0 = BenchClock::now();
+        match.updateProjectiles(FIXED_DT);
+        samples.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - t0).count());
+    }
+
+    std::string name = "updateProjectiles/" + std::to_string(count);
+    printLine(name, std::to_string(passes) + " passes", record(name, samples));
+}
+
+// `count` live particles kept topped up from a nuke-sized burst; only the
+// update (integration and expiry) is timed
+static void benchParticles(int count, int passes) {
+    ParticleEmitter debris;
+    debris.count = count;
+    debris.speed = 12.0f;
+    debris.lifetime = 1.5f;
+
+    ParticleSystem particles;
+    std::vector<double> samples;
+    samples.reserve(static_cast<size_t>(passes));
+    for (int i = 0; i < passes; i++) {
+        debris.count = count - particles.getCount();
+        particles.emit(debris, 0.0f, 0.0f);
+        auto t0 = BenchClock::now();
+        particles.update(FIXED_DT);
+        samples.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - t0).count());
+    }
+
+    std::string name = "updateParticles/" + std::to_string(count);
+    printLine(name, std::to_string(passes) + " passes", record(name, samples));
+}
+
+// `ragdolls` figures dropped in rows onto one wide floor and left to settle
+// and stand; only the world step is timed.
+static void benchPhysicsStep(const WeaponFactory& weapons, int ragdolls, int ticks) {
+    Physics physics;
+    Arena arena;
+    arena.addPlatform(physics, 0.0f, -8.0f, 20.0f, 0.5f, PlatformType::Stone);
+
+    std::vector<std::unique_ptr<StickFigure>> figures;
+    constexpr int PER_ROW = 16;
+    for (int i = 0; i < ragdolls; i++) {
+        float x = -18.0f + 36.0f * (static_cast<float>(i % PER_ROW) + 0.5f) / PER_ROW;
+        float y = -5.0f + 3.0f * static_cast<float>(i / PER_ROW);
+        figures.push_back(std::make_unique<StickFigure>(i % MAX_PLAYERS, physics, x, y, sf::Color::White,
+                                                        static_cast<CharacterType>(i % CHARACTER_TYPE_COUNT)));
+        figures.back()->equipWeapon(weapons.getDefaultWeapon());
+    }
+
+    std::vector<double> samples;
+    samples.reserve(static_cast<size_t>(ticks));
+    for (int t = 0; t < ticks; t++) {
+        for (auto& f : figures) f->update(FIXED_DT);
+        auto t0 = BenchClock::now();
+        physics.step(FIXED_DT);
+        samples.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - t0).count());
+    }
+
+    std::string name = "physicsStep/" + std::to_string(ragdolls);
+    printLine(name, std::to_string(ticks) + " ticks", record(name, samples));
+}
+
+// JSON parse + validation per weapon file, then the whole directory load
+static void benchWeaponLoading(const std::string& dir, int reps) {
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec))
+        if (entry.path().extension() == ".json") files.push_back(entry.path().string());
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        std::cerr << "[Bench] No weapon files in " << dir << ", skipping weapon loading\n";
+        return;
+    }
+
+    std::vector<double> fileUs, dirUs;
+    fileUs.reserve(files.size() * static_cast<size_t>(reps));
+    for (int r = 0; r < reps; r++) {
+        for (const auto& path : files) {
+            auto t0 = BenchClock::now();
+            WeaponData data = loadWeaponFromFile(path);
+            fileUs.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - t0).count());
+            (void)data;
+        }
+        WeaponFactory factory;
+        auto t0 = BenchClock::now();
+        factory.loadWeaponsFromDirectory(dir);
+        dirUs.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - t0).count());
+    }
+
+    printLine("loadWeaponFromFile", std::to_string(files.size()) + " files x " + std::to_string(reps),
+              record("loadWeaponFromFile", fileUs));
+    printLine("loadWeaponsFromDirectory", std::to_string(reps) + " loads",
+              record("loadWeaponsFromDirectory", dirUs));
+}
+
+// CPU cost of building and submitting each character's draw calls into an
+// offscreen target. The target is cleared between samples but never read
+// back, so GPU time is not included.
+static void benchFigureDraw(sf::RenderTexture& target, const WeaponFactory& weapons, int draws) {
+    const WeaponData* ranged = nullptr;
+    for (const auto& w : weapons.getAllWeapons())
+        if (w.type != WeaponType::Melee) { ranged = &w; break; }
+
+    for (int c = 0; c < CHARACTER_TYPE_COUNT; c++) {
+        auto type = static_cast<CharacterType>(c);
+        Physics physics;
+        StickFigure figure(0, physics, 0.0f, 0.0f, sf::Color(220, 80, 80), type);
+        figure.equipWeapon(ranged ? *ranged : weapons.getDefaultWeapon());  // includes the aim indicator
+
+        std::vector<double> samples;
+        samples.reserve(static_cast<size_t>(draws));
+        for (int i = 0; i < draws; i++) {
+            target.clear();
+            auto t0 = BenchClock::now();
+            figure.draw(target);
+            samples.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - t0).count());
+        }
+        target.display();
+
+        std::string name = std::string("drawFigure/") + characterTypeName(type);
+        printLine(name, std::to_string(draws) + " draws", record(name, samples));
+    }
+}
+
+static void benchHudDraw(sf::RenderTexture& target, const WeaponFactory& weapons, int draws) {
+    HUD hud;
+    hud.init();
+    Physics physics;
+    std::vector<std::unique_ptr<StickFigure>> players;
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        players.push_back(std::make_unique<StickFigure>(i, physics, -8.0f + 4.0f * static_cast<float>(i), 0.0f,
+                                                        sf::Color::White, static_cast<CharacterType>(i)));
+        players.back()->equipWeapon(weapons.getDefaultWeapon());
+    }
+
+    std::vector<double> samples;
+    samples.reserve(static_cast<size_t>(draws));
+    for (int i = 0; i < draws; i++) {
+        target.clear();
+        auto t0 = BenchClock::now();
+        hud.draw(target, players, 90.0f - static_cast<float>(i) * FIXED_DT);
+        samples.push_back(std::chrono::duration<double, std::micro>(BenchClock::now() - t0).count());
+    }
+    target.display();
+
+    printLine("drawHud", std::to_string(MAX_PLAYERS) + " players, " + std::to_string(draws) + " draws",
+              record("drawHud", samples));
+}
+
+// ============================================================
+// JSON / BASELINE
+// ============================================================
+
+static bool writeResults(const std::string& path, unsigned int seed) {
+    nlohmann::json root;
+    root["seed"] = seed;
+#ifdef NDEBUG
+    root["optimized"] = true;
+#else
+    root["optimized"] = false;
+#endif
+    auto& list = root["results"] = nlohmann::json::array();
+    for (const auto& r : g_results) {
+        list.push_back({{"name", r.name}, {"ops", r.ops}, {"mean_us", r.stats.meanUs},
+                        {"p50_us", r.stats.p50Us}, {"p99_us", r.stats.p99Us}, {"max_us", r.stats.maxUs}});
+    }
+
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "[Bench] Cannot write " << path << "\n";
+        return false;
+    }
+    out << root.dump(2) << "\n";
+    std::cout << "[Bench] Wrote " << g_results.size() << " results to " << path << "\n";
+    return true;
+}
+
+// Compares medians, which move far less run to run than means or tails.
+// Returns the number of benchmarks that got slower by more than
+// `thresholdPct`, or -1 if the baseline could not be read.
+static int compareWithBaseline(const std::string& path, unsigned int seed, double thresholdPct) {
+    nlohmann::json root;
+    try {
+        std::ifstream in(path);
+        in >> root;
+        if (!root.contains("results")) throw std::runtime_error("no results array");
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[Bench] Cannot read baseline " << path << ": " << e.what() << "\n";
+        return -1;
+    }
+    if (root.value("seed", 0u) != seed)
+        std::cout << "[Bench] Baseline was run with seed " << root.value("seed", 0u)
+                  << "; results may not be comparable\n";
+
+    std::cout << "\n=== Compare with " << path << " (p50, threshold " << thresholdPct << "%) ===\n";
+    int regressions = 0;
+    for (const auto& r : g_results) {
+        const nlohmann::json* base = nullptr;
+        for (const auto& b : root["results"])
+            if (b.value("name", "") == r.name) { base = &b; break; }
+
+        std::cout << std::left << std::setw(32) << r.name << std::right;
+        if (!base) {
+            std::cout << "   (new)\n";
+            continue;
+        }
+        double was = base->value("p50_us", 0.0);
+        double now = r.stats.p50Us;
+        double deltaPct = was > 0.0 ? (now - was) / was * 100.0 : 0.0;
+        std::cout << std::fixed << std::setprecision(2) << std::setw(10) << was << " -> "
+                  << std::setw(10) << now << " us  " << std::showpos << std::setprecision(1)
+                  << std::setw(7) << deltaPct << "%" << std::noshowpos;
+        if (deltaPct > thresholdPct) {
+            std::cout << "  REGRESSED";
+            regressions++;
+        } else if (deltaPct < -thresholdPct) {
+            std::cout << "  faster";
+        }
+        std::cout << "\n";
+    }
+    std::cout << regressions << " regression(s)\n";
+    return regressions;
+}
+
+static void printUsage() {
+    std::cout << "Usage: StickBrawlBench [options]\n"
+              << "  --seed N         seed for every benchmark (default 1234)\n"
+              << "  --carves N       carves per terrain benchmark (default 2000)\n"
+              << "  --filter TEXT    run only benchmarks whose name contains TEXT\n"
+              << "  --no-render      skip the offscreen draw benchmarks\n"
+              << "  --replay FILE    stream a recorded match through replication (repeatable)\n"
+              << "  --rtt TICKS      replication link round trip (default 6)\n"
+              << "  --loss PCT       replication link loss per direction (default 2)\n"
+              << "  --json FILE      save the results\n"
+              << "  --compare FILE   compare against saved results; exit 2 on a regression\n"
+              << "  --threshold PCT  slowdown that counts as a regression (default 10)\n";
+}
+
+int main(int argc, char** argv) {
+    unsigned int seed = 1234;
+    int carves = 2000;
+    bool render = true;
+    std::vector<std::string> replays;
+    std::string jsonPath, baselinePath;
+    double thresholdPct = 10.0;
+    ReplicationLink link;
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--carves") && i + 1 < argc) carves = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--filter") && i + 1 < argc) g_filter = argv[++i];
+        else if (!std::strcmp(argv[i], "--no-render")) render = false;
+        else if (!std::strcmp(argv[i], "--replay") && i + 1 < argc) replays.push_back(argv[++i]);
+        else if (!std::strcmp(argv[i], "--rtt") && i + 1 < argc) link.rttTicks = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--loss") && i + 1 < argc) link.lossPercent = static_cast<float>(std::atof(argv[++i]));
+        else if (!std::strcmp(argv[i], "--json") && i + 1 < argc) jsonPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--compare") && i + 1 < argc) baselinePath = argv[++i];
+        else if (!std::strcmp(argv[i], "--threshold") && i + 1 < argc) thresholdPct = std::atof(argv[++i]);
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::cout << "=== StickBrawl benchmarks (seed " << seed << ") ===\n";
+    for (int count : {100, 1000, 10000})
+        if (selected("carveCircle/" + std::to_string(count))) benchCarve(count, carves, seed);
+    if (selected("carveBitmap")) benchBitmapCarve(carves, seed);
+
+    if (selected("loadWeapon")) benchWeaponLoading("assets/weapons", 20);
+    WeaponFactory weapons;
+    weapons.loadWeaponsFromDirectory("assets/weapons");
+
+    for (int count : {10, 100, 1000})
+        if (selected("updateProjectiles/" + std::to_string(count))) benchProjectiles(weapons, count, 2000, seed);
+    for (int ragdolls : {5, 16, 32, 64})
+        if (selected("physicsStep/" + std::to_string(ragdolls))) benchPhysicsStep(weapons, ragdolls, 600);
+    for (int count : {1000, 8000})
+        if (selected("updateParticles/" + std::to_string(count))) benchParticles(count, 2000);
+    if (selected("snap")) benchSnapshot(weapons, 3600, seed);
+    if (selected("matchTick")) benchMatchTick(weapons, 3600, seed);
+
+    if (replays.empty()) {
+        if (selected("replicationEncode/4 bots")) benchReplicationBots(weapons, 3600, link, seed);
+    }
+    for (const auto& path : replays)
+        if (selected("replicationEncode/" + path)) benchReplicationReplay(weapons, path, link, seed);
+
+    if (render && (selected("drawFigure") || selected("drawHud"))) {
+        sf::RenderTexture target;
+        if (!target.resize({static_cast<unsigned int>(SCREEN_WIDTH), static_cast<unsigned int>(SCREEN_HEIGHT)})) {
+            std::cerr << "[Bench] No offscreen render target (no GL context?), skipping draw benchmarks\n";
+        } else {
+            if (selected("drawFigure")) benchFigureDraw(target, weapons, 2000);
+            if (selected("drawHud")) benchHudDraw(target, weapons, 2000);
+        }
+    }
+
+    if (!jsonPath.empty() && !writeResults(jsonPath, seed)) return 1;
+    if (!baselinePath.empty()) {
+        int regressions = compareWithBaseline(baselinePath, seed, thresholdPct);
+        if (regressions < 0) return 1;
+        if (regressions > 0) return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Bit-granular packing for network packets. Values are written LSB first
+// into a 64-bit accumulator and flushed a byte at a time, so the layout is
+// the same on every platform.
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    // Writes the low `bits` bits of `value` (bits <= 32)
+    void write(uint32_t value, int bits) {
+        if (bits < 32) value &= (1u << bits) - 1;
+        m_acc |= static_cast<uint64_t>(value) << m_count;
+        m_count += bits;
+        while (m_count >= 8) {
+            m_out.push_back(static_cast<uint8_t>(m_acc));
+            m_acc >>= 8;
+            m_count -= 8;
+        }
+    }
+
+    void writeBool(bool b) { write(b ? 1u : 0u, 1); }
+
+    // Two's complement in `bits` bits; the caller guarantees it fits
+    void writeSigned(int32_t value, int bits) { write(static_cast<uint32_t>(value), bits); }
+
+    void writeFloat(float f) {
+        uint32_t u;
+        std::memcpy(&u, &f, sizeof(u));
+        write(u, 32);
+    }
+
+    // Pads the last byte with zeros. Call once before sending.
+    void flush() {
+        if (m_count > 0) m_out.push_back(static_cast<uint8_t>(m_acc));
+        m_acc = 0;
+        m_count = 0;
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+    uint64_t m_acc = 0;
+    int      m_count = 0;
+};
+
+// Reads what BitWriter wrote. Reading past the end returns zeros and latches
+// ok() to false, so callers can check once at the end.
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    uint32_t read(int bits) {
+        while (m_count < bits) {
+            if (m_pos >= m_size) { m_ok = false; return 0; }
+            m_acc |= static_cast<uint64_t>(m_data[m_pos++]) << m_count;
+            m_count += 8;
+        }
+        uint32_t value = static_cast<uint32_t>(bits < 32 ? m_acc & ((1ull << bits) - 1) : m_acc);
+        m_acc >>= bits;
+        m_count -= bits;
+        return value;
+    }
+
+    bool readBool() { return read(1) != 0; }
+
+    int32_t readSigned(int bits) {
+        uint32_t u = read(bits);
+        if (bits < 32 && (u & (1u << (bits - 1)))) u |= ~((1u << bits) - 1);
+        return static_cast<int32_t>(u);
+    }
+
+    float readFloat() {
+        uint32_t u = read(32);
+        float f;
+        std::memcpy(&f, &u, sizeof(f));
+        return f;
+    }
+
+    bool ok() const { return m_ok; }
+
+private:
+    const uint8_t* m_data;
+    size_t   m_size;
+    size_t   m_pos = 0;
+    uint64_t m_acc = 0;
+    int      m_count = 0;
+    bool     m_ok = true;
+};
@@ -0,0 +1,366 @@
+#include "BitmapTerrain.h"
+#include <algorithm>
+#include <cmath>
+
+// ============================================================
+// MARCHING SQUARES TABLES
+// ============================================================
+//
+// Each square has samples a (bottom-left, bit 1), b (bottom-right, 2),
+// c (top-right, 4) and d (top-left, 8). Contour points sit on the edge
+// midpoints, stored in half-sample units relative to sample a:
+//
+//      d ---T--- c
+//      |         |
+//      L         R
+//      |         |
+//      a ---B--- b
+//
+// Segments are oriented with solid on the left, i.e. counter-clockwise
+// around solid ground, so Box2D's right-hand chain normals point out of
+// the terrain. Saddles (5, 10) keep the two solid corners separate.
+
+namespace {
+
+enum Edge { EB, ER, ET, EL };
+constexpr int EDGE_HX[4] = {1, 2, 1, 0};
+constexpr int EDGE_HY[4] = {0, 1, 2, 1};
+
+struct CaseSegments { int count; int seg[2][2]; };
+constexpr CaseSegments CASES[16] = {
+    {0, {{0, 0}, {0, 0}}},        // 0  empty
+    {1, {{EB, EL}, {0, 0}}},      // 1  a
+    {1, {{ER, EB}, {0, 0}}},      // 2  b
+    {1, {{ER, EL}, {0, 0}}},      // 3  a b
+    {1, {{ET, ER}, {0, 0}}},      // 4  c
+    {2, {{EB, EL}, {ET, ER}}},    // 5  a c (saddle)
+    {1, {{ET, EB}, {0, 0}}},      // 6  b c
+    {1, {{ET, EL}, {0, 0}}},      // 7  a b c
+    {1, {{EL, ET}, {0, 0}}},      // 8  d
+    {1, {{EB, ET}, {0, 0}}},      // 9  a d
+    {2, {{ER, EB}, {EL, ET}}},    // 10 b d (saddle)
+    {1, {{ER, ET}, {0, 0}}},      // 11 a b d
+    {1, {{EL, ER}, {0, 0}}},      // 12 c d
+    {1, {{EB, ER}, {0, 0}}},      // 13 a c d
+    {1, {{EL, EB}, {0, 0}}},      // 14 b c d
+    {0, {{0, 0}, {0, 0}}},        // 15 solid
+};
+
+// Half-sample coordinates can be slightly negative at the chunk border
+constexpr int KEY_BIAS = 8;
+
+int64_t pointKey(int hx, int hy) {
+    return (static_cast<int64_t>(hy + KEY_BIAS) << 32) | static_cast<uint32_t>(hx + KEY_BIAS);
+}
+
+void decodeKey(int64_t key, int& hx, int& hy) {
+    hx = static_cast<int>(key & 0xFFFFFFFF) - KEY_BIAS;
+    hy = static_cast<int>(key >> 32) - KEY_BIAS;
+}
+
+} // namespace
+
+BitmapTerrain::BitmapTerrain() {
+    m_cols = static_cast<int>(std::lround((MAX_X - MIN_X) * CELLS_PER_METER));
+    m_rows = static_cast<int>(std::lround((MAX_Y - MIN_Y) * CELLS_PER_METER));
+    m_chunkCols = (m_cols + CHUNK_CELLS - 1) / CHUNK_CELLS;
+    m_chunkRows = (m_rows + CHUNK_CELLS - 1) / CHUNK_CELLS;
+    m_cells.assign(static_cast<size_t>(m_cols) * m_rows, 0);
+    m_chunks.resize(static_cast<size_t>(m_chunkCols) * m_chunkRows);
+}
+
+// ============================================================
+// MASK EDITING
+// ============================================================
+
+void BitmapTerrain::fillRect(float left, float bottom, float right, float top, uint8_t material) {
+    // Cells whose centers fall inside the box
+    int x0 = std::max(0, static_cast<int>(std::ceil((left - MIN_X) * CELLS_PER_METER - 0.5f)));
+    int x1 = std::min(m_cols - 1, static_cast<int>(std::floor((right - MIN_X) * CELLS_PER_METER - 0.5f)));
+    int y0 = std::max(0, static_cast<int>(std::ceil((bottom - MIN_Y) * CELLS_PER_METER - 0.5f)));
+    int y1 = std::min(m_rows - 1, static_cast<int>(std::floor((top - MIN_Y) * CELLS_PER_METER - 0.5f)));
+    if (x0 > x1 || y0 > y1) return;
+
+    for (int y = y0; y <= y1; y++)
+        std::fill_n(m_cells.begin() + static_cast<size_t>(y) * m_cols + x0, x1 - x0 + 1, material);
+    markDirty(x0, y0, x1, y1);
+}
+
+bool BitmapTerrain::carveCircle(float cx, float cy, float radius) {
+    int x0 = std::max(0, static_cast<int>(std::floor((cx - radius - MIN_X) * CELLS_PER_METER)));
+    int x1 = std::min(m_cols - 1, static_cast<int>(std::floor((cx + radius - MIN_X) * CELLS_PER_METER)));
+    int y0 = std::max(0, static_cast<int>(std::floor((cy - radius - MIN_Y) * CELLS_PER_METER)));
+    int y1 = std::min(m_rows - 1, static_cast<int>(std::floor((cy + radius - MIN_Y) * CELLS_PER_METER)));
+    if (x0 > x1 || y0 > y1) return false;
+
+    // Work in cell units relative to the circle center
+    float ccx = (cx - MIN_X) * CELLS_PER_METER - 0.5f;
+    float ccy = (cy - MIN_Y) * CELLS_PER_METER - 0.5f;
+    float r2 = radius * radius * CELLS_PER_METER * CELLS_PER_METER;
+
+    bool changed = false;
+    for (int y = y0; y <= y1; y++) {
+        float dy = static_cast<float>(y) - ccy;
+        uint8_t* row = m_cells.data() + static_cast<size_t>(y) * m_cols;
+        for (int x = x0; x <= x1; x++) {
+            float dx = static_cast<float>(x) - ccx;
+            if (dx * dx + dy * dy <= r2 && row[x] != 0) {
+                row[x] = 0;
+                changed = true;
+            }
+        }
+    }
+    if (changed) markDirty(x0, y0, x1, y1);
+    return changed;
+}
+
+void BitmapTerrain::markDirty(int x0, int y0, int x1, int y1) {
+    // A chunk also traces the first column/row of the chunks right/above it
+    for (int cy = std::max(0, y0 - 1) / CHUNK_CELLS; cy <= y1 / CHUNK_CELLS; cy++)
+        for (int cx = std::max(0, x0 - 1) / CHUNK_CELLS; cx <= x1 / CHUNK_CELLS; cx++)
+            m_chunks[static_cast<size_t>(cy) * m_chunkCols + cx].dirty = true;
+
+    // Grow by one cell: edge shading depends on the neighbours
+    x0 = std::max(0, x0 - 1);
+    y0 = std::max(0, y0 - 1);
+    x1 = std::min(m_cols - 1, x1 + 1);
+    y1 = std::min(m_rows - 1, y1 + 1);
+    if (m_dirtyX0 > m_dirtyX1) {
+        m_dirtyX0 = x0; m_dirtyY0 = y0; m_dirtyX1 = x1; m_dirtyY1 = y1;
+    } else {
+        m_dirtyX0 = std::min(m_dirtyX0, x0);
+        m_dirtyY0 = std::min(m_dirtyY0, y0);
+        m_dirtyX1 = std::max(m_dirtyX1, x1);
+        m_dirtyY1 = std::max(m_dirtyY1, y1);
+    }
+}
+
+void BitmapTerrain::saveState(StateWriter& out) const {
+    out.writeVector(m_cells);
+}
+
+bool BitmapTerrain::loadState(StateReader& in) {
+    uint32_t count = 0;
+    if (!in.read(count) || count != m_cells.size()) return false;
+
+    // Restore row by row so an untouched mask costs no chunk rebuilds
+    std::vector<uint8_t>& row = m_rowScratch;
+    row.resize(static_cast<size_t>(m_cols));
+    for (int y = 0; y < m_rows; y++) {
+        if (!in.readBytes(row.data(), row.size())) return false;
+        uint8_t* dst = m_cells.data() + static_cast<size_t>(y) * m_cols;
+        int x0 = 0;
+        while (x0 < m_cols && dst[x0] == row[x0]) x0++;
+        if (x0 == m_cols) continue;
+        int x1 = m_cols - 1;
+        while (dst[x1] == row[x1]) x1--;
+        std::copy(row.begin() + x0, row.begin() + x1 + 1, dst + x0);
+        markDirty(x0, y, x1, y);
+    }
+    return true;
+}
+
+bool BitmapTerrain::isSolid(float x, float y) const {
+    int cx = static_cast<int>(std::floor((x - MIN_X) * CELLS_PER_METER));
+    int cy = static_cast<int>(std::floor((y - MIN_Y) * CELLS_PER_METER));
+    if (cx < 0 || cx >= m_cols || cy < 0 || cy >= m_rows) return false;
+    return cellAt(cx, cy) != 0;
+}
+
+bool BitmapTerrain::findSurface(float x, float& outY) const {
+    int cx = static_cast<int>(std::floor((x - MIN_X) * CELLS_PER_METER));
+    if (cx < 0 || cx >= m_cols) return false;
+    for (int cy = m_rows - 1; cy >= 0; cy--) {
+        if (cellAt(cx, cy) != 0) {
+            outY = MIN_Y + static_cast<float>(cy + 1) / CELLS_PER_METER;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================
+// COLLIDERS
+// ============================================================
+
+void BitmapTerrain::rebuildDirtyChunks(Physics& physics) {
+    for (int cy = 0; cy < m_chunkRows; cy++)
+        for (int cx = 0; cx < m_chunkCols; cx++)
+            if (m_chunks[static_cast<size_t>(cy) * m_chunkCols + cx].dirty)
+                traceChunk(physics, cx, cy);
+}
+
+void BitmapTerrain::recreateColliders(Physics& physics) {
+    for (int cy = 0; cy < m_chunkRows; cy++) {
+        for (int cx = 0; cx < m_chunkCols; cx++) {
+            Chunk& chunk = m_chunks[static_cast<size_t>(cy) * m_chunkCols + cx];
+            chunk.body = b2_nullBodyId;
+            chunk.chains.clear();
+            if (chunk.dirty) traceChunk(physics, cx, cy);
+            else createChains(physics, chunk);
+        }
+    }
+}
+
+// Traces closed loops around the solid cells of one chunk plus the first
+// column/row of its right/top neighbours. Samples beyond that count as empty,
+// so every contour closes on its own, and the one-cell overlap keeps surfaces
+// flat across chunk seams instead of leaving a notch where two loops meet.
+void BitmapTerrain::traceChunk(Physics& physics, int chunkX, int chunkY) {
+    Chunk& chunk = m_chunks[static_cast<size_t>(chunkY) * m_chunkCols + chunkX];
+    for (b2ChainId id : chunk.chains) b2DestroyChain(id);
+    chunk.chains.clear();
+    chunk.points.clear();
+    chunk.loopSizes.clear();
+    chunk.dirty = false;
+
+    int x0 = chunkX * CHUNK_CELLS;
+    int y0 = chunkY * CHUNK_CELLS;
+    int x1 = std::min(x0 + CHUNK_CELLS, m_cols - 1);
+    int y1 = std::min(y0 + CHUNK_CELLS, m_rows - 1);
+    auto solid = [&](int x, int y) {
+        return x >= x0 && x <= x1 && y >= y0 && y <= y1 && cellAt(x, y) != 0;
+    };
+
+    m_segments.clear();
+    m_segmentFrom.clear();
+    for (int sy = y0 - 1; sy <= y1; sy++) {
+        for (int sx = x0 - 1; sx <= x1; sx++) {
+            int idx = (solid(sx, sy)         ? 1 : 0)
+                    | (solid(sx + 1, sy)     ? 2 : 0)
+                    | (solid(sx + 1, sy + 1) ? 4 : 0)
+                    | (solid(sx, sy + 1)     ? 8 : 0);
+            const CaseSegments& cs = CASES[idx];
+            for (int k = 0; k < cs.count; k++) {
+                int e0 = cs.seg[k][0], e1 = cs.seg[k][1];
+                Segment seg;
+                seg.from = pointKey(2 * sx + EDGE_HX[e0], 2 * sy + EDGE_HY[e0]);
+                seg.to   = pointKey(2 * sx + EDGE_HX[e1], 2 * sy + EDGE_HY[e1]);
+                m_segmentFrom[seg.from] = static_cast<int>(m_segments.size());
+                m_segments.push_back(seg);
+            }
+        }
+    }
+    if (m_segments.empty()) return;
+
+    // Half-sample units -> world meters (sample i sits at the center of cell i)
+    auto toWorld = [](int hx, int hy) -> b2Vec2 {
+        return {MIN_X + (static_cast<float>(hx) * 0.5f + 0.5f) / CELLS_PER_METER,
+                MIN_Y + (static_cast<float>(hy) * 0.5f + 0.5f) / CELLS_PER_METER};
+    };
+
+    m_segmentUsed.assign(m_segments.size(), false);
+    for (size_t start = 0; start < m_segments.size(); start++) {
+        if (m_segmentUsed[start]) continue;
+
+        // Walk the loop, dropping points that sit on a straight run
+        m_loop.clear();
+        int first = static_cast<int>(start);
+        int cur = first;
+        do {
+            m_segmentUsed[cur] = true;
+            auto it = m_segmentFrom.find(m_segments[cur].to);
+            if (it == m_segmentFrom.end()) break;
+            int next = it->second;
+
+            int ax, ay, bx, by, nx, ny;
+            decodeKey(m_segments[cur].from, ax, ay);
+            decodeKey(m_segments[cur].to, bx, by);
+            decodeKey(m_segments[next].to, nx, ny);
+            int cross = (bx - ax) * (ny - by) - (by - ay) * (nx - bx);
+            if (cross != 0) m_loop.push_back(toWorld(bx, by));
+
+            cur = next;
+        } while (cur != first && !m_segmentUsed[cur]);
+
+        // Box2D loops need at least four vertices
+        if (m_loop.size() < 4) continue;
+
+        chunk.points.insert(chunk.points.end(), m_loop.begin(), m_loop.end());
+        chunk.loopSizes.push_back(static_cast<int>(m_loop.size()));
+    }
+    createChains(physics, chunk);
+}
+
+// One chain loop per traced contour, on the chunk's body (created on demand)
+void BitmapTerrain::createChains(Physics& physics, Chunk& chunk) {
+    if (chunk.loopSizes.empty()) return;
+
+    if (B2_IS_NULL(chunk.body)) {
+        b2BodyDef bd = b2DefaultBodyDef();
+        bd.type = b2_staticBody;
+        chunk.body = b2CreateBody(physics.getWorldId(), &bd);
+    }
+
+    size_t offset = 0;
+    for (int count : chunk.loopSizes) {
+        b2ChainDef def = b2DefaultChainDef();
+        def.points = chunk.points.data() + offset;
+        def.count = count;
+        def.isLoop = true;
+        def.filter.categoryBits = CAT_PLATFORM;
+        chunk.chains.push_back(b2CreateChain(chunk.body, &def));
+        offset += static_cast<size_t>(count);
+    }
+}
+
+// ============================================================
+// RENDERING
+// ============================================================
+
+#ifndef STICKBRAWL_HEADLESS
+void BitmapTerrain::setPalette(const std::array<sf::Color, 8>& fill, const std::array<sf::Color, 8>& outline) {
+    m_fill = fill;
+    m_outline = outline;
+    m_dirtyX0 = 0; m_dirtyY0 = 0; m_dirtyX1 = m_cols - 1; m_dirtyY1 = m_rows - 1;
+}
+
+void BitmapTerrain::uploadDirtyPixels() const {
+    if (m_dirtyX0 > m_dirtyX1) return;
+
+    int w = m_dirtyX1 - m_dirtyX0 + 1;
+    int h = m_dirtyY1 - m_dirtyY0 + 1;
+    m_pixelScratch.resize(static_cast<size_t>(w) * h * 4);
+
+    auto empty = [&](int x, int y) {
+        return x < 0 || x >= m_cols || y < 0 || y >= m_rows || cellAt(x, y) == 0;
+    };
+
+    // Texture row 0 is the top of the world
+    uint8_t* out = m_pixelScratch.data();
+    for (int y = m_dirtyY1; y >= m_dirtyY0; y--) {
+        for (int x = m_dirtyX0; x <= m_dirtyX1; x++) {
+            uint8_t c = cellAt(x, y);
+            sf::Color col = sf::Color::Transparent;
+            if (c != 0) {
+                bool edge = empty(x - 1, y) || empty(x + 1, y) || empty(x, y - 1) || empty(x, y + 1);
+                col = edge ? m_outline[c] : m_fill[c];
+            }
+            *out++ = col.r; *out++ = col.g; *out++ = col.b; *out++ = col.a;
+        }
+    }
+
+    m_texture->update(m_pixelScratch.data(),
+                      {static_cast<unsigned>(w), static_cast<unsigned>(h)},
+                      {static_cast<unsigned>(m_dirtyX0), static_cast<unsigned>(m_rows - 1 - m_dirtyY1)});
+    m_dirtyX0 = 0; m_dirtyY0 = 0; m_dirtyX1 = -1; m_dirtyY1 = -1;
+}
+
+void BitmapTerrain::draw(sf::RenderTarget& target) const {
+    if (!m_texture) {
+        m_texture.emplace();
+        if (!m_texture->resize({static_cast<unsigned>(m_cols), static_cast<unsigned>(m_rows)})) {
+            m_texture.reset();
+            return;
+        }
+        m_dirtyX0 = 0; m_dirtyY0 = 0; m_dirtyX1 = m_cols - 1; m_dirtyY1 = m_rows - 1;
+    }
+    uploadDirtyPixels();
+
+    sf::Sprite sprite(*m_texture);
+    float scale = PPM / CELLS_PER_METER;
+    sprite.setScale({scale, scale});
+    sprite.setPosition({SCREEN_CX + MIN_X * PPM, SCREEN_CY - MAX_Y * PPM});
+    target.draw(sprite);
+}
+#endif
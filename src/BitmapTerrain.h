@@ -0,0 +1,107 @@
+#pragma once
+#include "Physics.h"
+#include "StateBuffer.h"
+#ifndef STICKBRAWL_HEADLESS
+#include <SFML/Graphics.hpp>
+#include <optional>
+#endif
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Pixel-mask destructible terrain. The level is rasterized into an occupancy
+// grid (one byte per cell holding PlatformType + 1, 0 = empty). Carving just
+// clears cells inside the circle, so its cost only depends on the blast size.
+//
+// Collision comes from Box2D chain loops traced with marching squares. The
+// mask is split into fixed-size chunks that each own one static body; a carve
+// marks the chunks it touched dirty and only those are re-traced. Rendering
+// uses a texture the size of the mask, updated in place over the dirty rect.
+class BitmapTerrain {
+public:
+    static constexpr float CELLS_PER_METER = 10.0f;
+    static constexpr float MIN_X = -24.0f;
+    static constexpr float MAX_X =  24.0f;
+    static constexpr float MIN_Y = -20.0f;
+    static constexpr float MAX_Y =  16.0f;
+    static constexpr int   CHUNK_CELLS = 32;
+
+    BitmapTerrain();
+    BitmapTerrain(const BitmapTerrain&) = delete;
+    BitmapTerrain& operator=(const BitmapTerrain&) = delete;
+
+    // Fills every cell whose center lies inside the box with `material`
+    void fillRect(float left, float bottom, float right, float top, uint8_t material);
+
+    // Clears cells inside the circle; returns true if anything was removed
+    bool carveCircle(float cx, float cy, float radius);
+
+    // Re-traces colliders for chunks changed since the last call
+    void rebuildDirtyChunks(Physics& physics);
+
+    // For a freshly reset world: drops the old body/chain ids without
+    // destroying them and creates every chunk's colliders again, re-tracing
+    // only dirty chunks
+    void recreateColliders(Physics& physics);
+
+    // Top of the highest solid run in the column at x; false if the column is empty
+    bool findSurface(float x, float& outY) const;
+
+    bool isSolid(float x, float y) const;
+    int  getCols() const { return m_cols; }
+    int  getRows() const { return m_rows; }
+    const std::vector<uint8_t>& getCells() const { return m_cells; }
+
+    // Copies the mask in/out; loadState only dirties the rows that differ
+    void saveState(StateWriter& out) const;
+    bool loadState(StateReader& in);
+
+#ifndef STICKBRAWL_HEADLESS
+    // fill/outline colors per material (index = PlatformType + 1)
+    void setPalette(const std::array<sf::Color, 8>& fill, const std::array<sf::Color, 8>& outline);
+    void draw(sf::RenderTarget& target) const;
+#endif
+
+private:
+    struct Chunk {
+        b2BodyId body = b2_nullBodyId;
+        std::vector<b2ChainId> chains;
+        // Traced loops back to back, so recreateColliders can skip marching squares
+        std::vector<b2Vec2> points;
+        std::vector<int>    loopSizes;
+        bool dirty = true;
+    };
+
+    uint8_t cellAt(int x, int y) const { return m_cells[static_cast<size_t>(y) * m_cols + x]; }
+    void markDirty(int x0, int y0, int x1, int y1);
+    void traceChunk(Physics& physics, int chunkX, int chunkY);
+    void createChains(Physics& physics, Chunk& chunk);
+
+    int m_cols = 0;
+    int m_rows = 0;
+    int m_chunkCols = 0;
+    int m_chunkRows = 0;
+    std::vector<uint8_t> m_cells;
+    std::vector<Chunk>   m_chunks;
+
+    // Scratch buffers for marching squares, kept across rebuilds
+    struct Segment { int64_t from, to; };
+    std::vector<Segment> m_segments;
+    std::vector<bool>    m_segmentUsed;
+    std::unordered_map<int64_t, int> m_segmentFrom;
+    std::vector<b2Vec2>  m_loop;
+    std::vector<uint8_t> m_rowScratch;  // loadState
+
+#ifndef STICKBRAWL_HEADLESS
+    void uploadDirtyPixels() const;
+
+    std::array<sf::Color, 8> m_fill{};
+    std::array<sf::Color, 8> m_outline{};
+    mutable std::optional<sf::Texture> m_texture;
+    mutable std::vector<uint8_t> m_pixelScratch;
+#endif
+    // Cell rect (inclusive) whose pixels must be re-uploaded; x0 > x1 = clean
+    mutable int m_dirtyX0 = 0, m_dirtyY0 = 0, m_dirtyX1 = -1, m_dirtyY1 = -1;
+};
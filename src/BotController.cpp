@@ -0,0 +1,75 @@
+#include "BotController.h"
+#include "Match.h"
+#include <cmath>
+
+BotController::BotController(int playerIndex, unsigned int seed)
+    : m_playerIndex(playerIndex), m_rng(seed) {}
+
+PlayerInput BotController::think(const Match& match) {
+    PlayerInput pi;
+    const auto& players = match.getPlayers();
+    if (m_playerIndex < 0 || m_playerIndex >= static_cast<int>(players.size())) return pi;
+
+    const auto& self = players[m_playerIndex];
+    if (!self->isAlive() || self->isWaitingToRespawn()) {
+        m_prevJump = m_prevAttack = false;
+        return pi;
+    }
+    b2Vec2 sp = self->getPosition();
+    const auto& weapon = self->getCurrentWeapon();
+
+    // Nearest living enemy
+    const StickFigure* target = nullptr;
+    float bestDist = 1e9f;
+    for (const auto& p : players) {
+        if (p->getPlayerIndex() == m_playerIndex) continue;
+        if (!p->isAlive() || p->isWaitingToRespawn()) continue;
+        b2Vec2 tp = p->getPosition();
+        float d = std::hypot(tp.x - sp.x, tp.y - sp.y);
+        if (d < bestDist) { bestDist = d; target = p.get(); }
+    }
+
+    b2Vec2 goal = target ? target->getPosition() : sp;
+
+    // Still on fists: detour to a pickup if one is closer than the enemy
+    if (weapon.name == "Fists") {
+        for (const auto& pickup : match.getPickups()) {
+            if (!pickup.alive) continue;
+            float d = std::hypot(pickup.position.x - sp.x, pickup.position.y - sp.y);
+            if (d < bestDist) { bestDist = d; goal = pickup.position; }
+        }
+    }
+
+    float dx = goal.x - sp.x;
+    float dy = goal.y - sp.y;
+    float engageRange = (weapon.type == WeaponType::Melee) ? weapon.range * 0.8f : 8.0f;
+    bool  inRange = target && std::fabs(dx) < engageRange && std::fabs(dy) < 2.5f;
+    float wantDir = (dx >= 0.0f) ? 1.0f : -1.0f;
+    bool  facing = static_cast<float>(self->getFacingDirection()) == wantDir;
+
+    if (!inRange || !facing) {
+        if (std::fabs(dx) > 0.3f) {
+            pi.moveLeft  = dx < 0.0f;
+            pi.moveRight = dx > 0.0f;
+        }
+    }
+
+    // Ranged weapons track the target vertically
+    if (weapon.type != WeaponType::Melee && target) {
+        float want = std::atan2(dy, std::fabs(dx));
+        if (want > self->getAimAngle() + 0.1f) pi.aimUp = true;
+        else if (want < self->getAimAngle() - 0.1f) pi.aimDown = true;
+    }
+
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    pi.jump = (dy > 1.5f && chance(m_rng) < 0.2f) || chance(m_rng) < 0.01f;
+
+    // Release between presses so attackPressed fires on alternate ticks
+    pi.attack = inRange && facing && !m_prevAttack;
+
+    pi.jumpPressed   = pi.jump && !m_prevJump;
+    pi.attackPressed = pi.attack && !m_prevAttack;
+    m_prevJump   = pi.jump;
+    m_prevAttack = pi.attack;
+    return pi;
+}
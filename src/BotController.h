@@ -0,0 +1,21 @@
+#pragma once
+#include "PlayerInput.h"
+#include <random>
+
+class Match;
+
+// Simple scripted opponent used to drive headless balance-testing matches.
+// Chases the nearest living enemy (or a pickup while still on fists), aims
+// at it and attacks whenever it is in weapon range.
+class BotController {
+public:
+    BotController(int playerIndex, unsigned int seed);
+
+    PlayerInput think(const Match& match);
+
+private:
+    int          m_playerIndex;
+    std::mt19937 m_rng;
+    bool         m_prevJump = false;
+    bool         m_prevAttack = false;
+};
@@ -0,0 +1,254 @@
+#include "CharacterPreviews.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+// One sheet cell, and where the preview's anchor sits inside it. The widest
+// art (the crocodile) spans 40 px either side; the tallest runs from the
+// stick heads 64 px above the anchor to the legs 30 px below.
+constexpr sf::Vector2i CELL = {96, 112};
+constexpr sf::Vector2f CELL_ANCHOR = {48.0f, 74.0f};
+constexpr int SHEET_COLUMNS = 8;
+
+// Sheets are drawn with alpha blending onto a transparent texture, which
+// leaves their colors premultiplied
+const sf::BlendMode BLEND_PREMULTIPLIED(sf::BlendMode::Factor::One, sf::BlendMode::Factor::OneMinusSrcAlpha);
+
+sf::Color rainbow(float phase) {
+    float r = std::sin(phase) * 0.5f + 0.5f;
+    float g = std::sin(phase + 2.094f) * 0.5f + 0.5f;
+    float b = std::sin(phase + 4.189f) * 0.5f + 0.5f;
+    return sf::Color(static_cast<uint8_t>(r * 255), static_cast<uint8_t>(g * 255), static_cast<uint8_t>(b * 255));
+}
+}
+
+bool CharacterPreviews::isAnimated(CharacterType type) {
+    return type == CharacterType::Unicorn || type == CharacterType::Crocodile || type == CharacterType::StickLady;
+}
+
+const CharacterPreviews::Sheet* CharacterPreviews::getSheet(CharacterType type, sf::Color color) {
+    for (const auto& sheet : m_sheets)
+        if (sheet->type == type && sheet->color == color) return sheet.get();
+    if (m_offscreenFailed) return nullptr;
+
+    auto sheet = std::make_unique<Sheet>();
+    sheet->type = type;
+    sheet->color = color;
+    sheet->frames = isAnimated(type) ? ANIMATED_FRAMES : 1;
+    int columns = std::min(sheet->frames, SHEET_COLUMNS);
+    int rows = (sheet->frames + columns - 1) / columns;
+    if (!sheet->texture.resize({static_cast<unsigned>(columns * CELL.x), static_cast<unsigned>(rows * CELL.y)})) {
+        std::cerr << "[CharacterPreviews] No offscreen render target, drawing previews directly\n";
+        m_offscreenFailed = true;
+        return nullptr;
+    }
+
+    sheet->texture.clear(sf::Color::Transparent);
+    for (int frame = 0; frame < sheet->frames; frame++) {
+        sf::Vector2f cell = {static_cast<float>((frame % columns) * CELL.x),
+                             static_cast<float>((frame / columns) * CELL.y)};
+        float time = LOOP_SECONDS * static_cast<float>(frame) / static_cast<float>(sheet->frames);
+        m_batch.clear();
+        drawArt(m_batch, type, color, cell + CELL_ANCHOR, time);
+        m_batch.draw(sheet->texture);
+    }
+    sheet->texture.display();
+
+    m_sheets.push_back(std::move(sheet));
+    return m_sheets.back().get();
+}
+
+void CharacterPreviews::draw(sf::RenderTarget& target, CharacterType type, sf::Color color, sf::Vector2f anchor,
+                             float time) {
+    const Sheet* sheet = getSheet(type, color);
+    if (!sheet) {
+        m_batch.clear();
+        drawArt(m_batch, type, color, anchor, time);
+        m_batch.draw(target);
+        return;
+    }
+
+    float phase = std::fmod(time, LOOP_SECONDS) / LOOP_SECONDS;
+    int frame = std::clamp(static_cast<int>(phase * static_cast<float>(sheet->frames)), 0, sheet->frames - 1);
+    int columns = std::min(sheet->frames, SHEET_COLUMNS);
+    float u = static_cast<float>((frame % columns) * CELL.x);
+    float v = static_cast<float>((frame / columns) * CELL.y);
+
+    // Whole-pixel placement keeps the texels one-to-one with the screen
+    float l = std::round(anchor.x - CELL_ANCHOR.x), t = std::round(anchor.y - CELL_ANCHOR.y);
+    float r = l + static_cast<float>(CELL.x), b = t + static_cast<float>(CELL.y);
+    float ur = u + static_cast<float>(CELL.x), vb = v + static_cast<float>(CELL.y);
+    m_quad[0] = {{l, t}, sf::Color::White, {u, v}};
+    m_quad[1] = {{r, t}, sf::Color::White, {ur, v}};
+    m_quad[2] = {{l, b}, sf::Color::White, {u, vb}};
+    m_quad[3] = {{l, b}, sf::Color::White, {u, vb}};
+    m_quad[4] = {{r, t}, sf::Color::White, {ur, v}};
+    m_quad[5] = {{r, b}, sf::Color::White, {ur, vb}};
+
+    sf::RenderStates states(&sheet->texture.getTexture());
+    states.blendMode = BLEND_PREMULTIPLIED;
+    target.draw(m_quad, 6, sf::PrimitiveType::Triangles, states);
+}
+
+// ============================================================================
+// Preview art, around `anchor` (cx, previewY)
+// ============================================================================
+
+void CharacterPreviews::drawArt(ShapeBatch& batch, CharacterType type, sf::Color pc, sf::Vector2f anchor,
+                                float time) {
+    const float cx = anchor.x;
+    const float previewY = anchor.y;
+
+    switch (type) {
+        case CharacterType::Stick: {
+            batch.circle({cx, previewY - 50.0f}, 12.0f, sf::Color::Transparent, 30, pc, 2.0f);
+            batch.line({cx, previewY - 38.0f}, {cx, previewY}, pc);
+            for (float s : {-1.0f, 1.0f}) {
+                batch.line({cx, previewY - 28.0f}, {cx + s * 18.0f, previewY - 15.0f}, pc);
+                batch.line({cx, previewY}, {cx + s * 14.0f, previewY + 22.0f}, pc);
+            }
+            break;
+        }
+        case CharacterType::Cat: {
+            // Body, head, ears
+            batch.ellipse({cx, previewY}, 18.0f * 1.2f, 18.0f * 0.8f, pc, sf::Color::Black, 1.0f);
+            batch.circle({cx + 16.0f, previewY - 14.0f}, 12.0f, pc, 30, sf::Color::Black, 1.0f);
+            for (float es : {-1.0f, 1.0f}) {
+                batch.convex({{cx + 16.0f + es * 6.0f, previewY - 24.0f},
+                              {cx + 16.0f + es * 3.0f, previewY - 36.0f},
+                              {cx + 16.0f + es * 10.0f, previewY - 28.0f}},
+                             pc);
+            }
+            break;
+        }
+        case CharacterType::Cobra: {
+            // Coil, neck, hood, eyes
+            batch.ellipse({cx, previewY + 15.0f}, 16.0f * 1.2f, 16.0f * 0.6f, pc, sf::Color::Black, 1.0f);
+            batch.rect({cx + 3.0f, previewY + 5.0f}, {5.0f, 35.0f}, {2.5f, 35.0f}, 0.0f, pc);
+            float shy = previewY - 28.0f;
+            batch.convex({{cx - 14.0f, shy + 5.0f}, {cx - 8.0f, shy - 6.0f}, {cx, shy - 10.0f},
+                          {cx + 8.0f, shy - 6.0f}, {cx + 14.0f, shy + 5.0f}},
+                         pc, sf::Color::Black, 1.0f);
+            for (float es : {-1.0f, 1.0f})
+                batch.circle({cx + es * 4.0f, shy - 6.0f}, 2.0f, sf::Color::Red);
+            break;
+        }
+        case CharacterType::Unicorn: {
+            sf::Color dark(pc.r / 2, pc.g / 2, pc.b / 2);
+            batch.rect({cx, previewY + 5.0f}, {40.0f, 22.0f}, {20.0f, 11.0f}, 0.0f, pc, dark, 1.0f);
+            batch.ellipse({cx + 22.0f, previewY - 15.0f}, 9.0f * 1.3f, 9.0f, pc, dark, 1.0f);
+
+            // Horn (rainbow)
+            constexpr int hs = 8;
+            sf::Vertex horn[hs + 1];
+            for (int hi = 0; hi <= hs; hi++) {
+                float hf = static_cast<float>(hi) / static_cast<float>(hs);
+                float spiral = std::sin(hf * 10.0f + time * 3.0f) * (2.0f - hf * 1.5f);
+                horn[hi] = sf::Vertex{{cx + 24.0f + hf * 4.0f + spiral * 0.3f, previewY - 22.0f - hf * 20.0f},
+                                      rainbow(time * 2.0f + hf * 6.28f)};
+            }
+            batch.lineStrip(horn, hs + 1);
+
+            // Mane strands
+            for (int ms = 0; ms < 4; ms++) {
+                float mf = static_cast<float>(ms) / 4.0f;
+                sf::Color c = rainbow(time * 2.0f + mf * 6.28f);
+                float mx = cx + 14.0f - mf * 10.0f;
+                float my = previewY - 12.0f - mf * 6.0f;
+                float wave = std::sin(time * 3.0f + mf * 5.0f) * 5.0f;
+                sf::Vertex mane[3] = {{{mx, my}, c},
+                                      {{mx - 10.0f, my - 5.0f + wave}, c},
+                                      {{mx - 18.0f, my - 2.0f + wave * 1.3f}, c}};
+                batch.lineStrip(mane, 3);
+            }
+
+            for (float lx : {-0.3f, -0.1f, 0.1f, 0.3f})
+                batch.line({cx + lx * 40.0f, previewY + 16.0f}, {cx + lx * 40.0f, previewY + 30.0f}, pc);
+            break;
+        }
+        case CharacterType::Crocodile: {
+            // Body (long, low) and snout
+            batch.convex({{cx - 22.0f, previewY - 5.0f}, {cx + 10.0f, previewY - 7.0f},
+                          {cx + 18.0f, previewY - 3.0f}, {cx + 18.0f, previewY + 6.0f},
+                          {cx - 8.0f, previewY + 8.0f}, {cx - 22.0f, previewY + 4.0f}},
+                         pc, sf::Color::Black, 1.0f);
+            batch.convex({{cx + 18.0f, previewY - 5.0f}, {cx + 40.0f, previewY - 2.0f},
+                          {cx + 38.0f, previewY + 2.0f}, {cx + 18.0f, previewY + 4.0f}},
+                         pc, sf::Color::Black, 1.0f);
+            for (int ti = 0; ti < 4; ti++) {
+                float ttx = cx + 22.0f + static_cast<float>(ti) * 4.5f;
+                batch.convex({{ttx - 1.0f, previewY + 1.0f}, {ttx, previewY + 4.5f}, {ttx + 1.0f, previewY + 1.0f}},
+                             sf::Color(240, 235, 210));
+            }
+            batch.circle({cx + 14.0f, previewY - 7.0f}, 2.0f, sf::Color(200, 180, 50));
+
+            // Scutes
+            sf::Color scuteColor(pc.r * 3 / 4, pc.g * 3 / 4, pc.b * 3 / 4);
+            for (int si = 0; si < 4; si++) {
+                float ssx = cx - 14.0f + static_cast<float>(si) * 7.0f;
+                batch.convex({{ssx - 2.0f, previewY - 5.0f}, {ssx, previewY - 10.0f}, {ssx + 2.0f, previewY - 5.0f}},
+                             scuteColor);
+            }
+
+            // Tail
+            sf::Vertex tail[5];
+            for (int tti = 0; tti < 5; tti++) {
+                float ttf = static_cast<float>(tti) / 4.0f;
+                float wave = std::sin(time * 2.0f + ttf * 3.0f) * 4.0f * ttf;
+                tail[tti] = sf::Vertex{{cx - 22.0f - ttf * 18.0f, previewY + wave}, pc};
+            }
+            batch.lineStrip(tail, 5);
+
+            // Stubby legs
+            for (float clx : {-0.2f, 0.0f, 0.2f, 0.4f})
+                batch.line({cx + clx * 35.0f, previewY + 6.0f}, {cx + clx * 35.0f, previewY + 16.0f}, pc);
+            break;
+        }
+        case CharacterType::StickLady: {
+            batch.circle({cx, previewY - 50.0f}, 12.0f, sf::Color::Transparent, 30, pc, 2.0f);
+
+            // Hair strands
+            for (int hi = 0; hi < 5; hi++) {
+                float hfrac = static_cast<float>(hi) / 4.0f;
+                float hx = cx - 6.0f + hfrac * 3.0f;
+                float wave = std::sin(time * 2.0f + hfrac * 2.0f) * 3.0f;
+                sf::Vertex hair[3] = {{{hx, previewY - 52.0f + hfrac * 4.0f}, pc},
+                                      {{hx - 8.0f + wave, previewY - 40.0f}, pc},
+                                      {{hx - 10.0f + wave, previewY - 28.0f}, sf::Color(pc.r, pc.g, pc.b, 150)}};
+                batch.lineStrip(hair, 3);
+            }
+
+            // Eye and lashes
+            batch.circle({cx + 4.0f, previewY - 51.0f}, 1.5f, pc);
+            for (int li = 0; li < 3; li++) {
+                float la = -0.4f + static_cast<float>(li) * 0.4f;
+                batch.line({cx + 4.0f, previewY - 53.0f},
+                           {cx + 4.0f + std::sin(la) * 4.0f, previewY - 53.0f - std::cos(la) * 4.0f}, pc);
+            }
+
+            // Body and arms
+            batch.line({cx, previewY - 38.0f}, {cx, previewY - 5.0f}, pc);
+            for (float s : {-1.0f, 1.0f})
+                batch.line({cx, previewY - 28.0f}, {cx + s * 18.0f, previewY - 15.0f}, pc);
+
+            // Triangle skirt, swaying with the hair
+            float skirtSway = std::sin(time * 2.0f) * 2.0f;
+            sf::Color skirtC(static_cast<uint8_t>(std::min(255, pc.r + 30)),
+                             static_cast<uint8_t>(std::min(255, pc.g + 10)),
+                             static_cast<uint8_t>(std::min(255, pc.b + 40)));
+            batch.convex({{cx - 4.0f, previewY - 6.0f}, {cx + 4.0f, previewY - 6.0f}, {cx + skirtSway, previewY + 14.0f}},
+                         skirtC, pc, 1.0f);
+
+            // Legs below skirt
+            for (float s : {-1.0f, 1.0f})
+                batch.line({cx + s * 4.0f, previewY + 14.0f}, {cx + s * 10.0f, previewY + 28.0f}, pc);
+
+            // Purse
+            float purseSwing = std::sin(time * 3.0f) * 8.0f;
+            batch.rect({cx + 18.0f, previewY - 13.0f}, {8.0f, 6.0f}, {4.0f, 0.0f}, purseSwing,
+                       sf::Color(200, 80, 150), sf::Color(150, 50, 100), 1.0f);
+            break;
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "StickFigure.h"
+#include "ShapeBatch.h"
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+// Character-select portraits. The first time a (character, color) pair is
+// shown, its animation is baked into a sprite sheet: ANIMATED_FRAMES cells
+// spread over one LOOP_SECONDS cycle, or a single cell for the characters
+// that hold still. After that a preview is one textured quad per frame.
+class CharacterPreviews {
+public:
+    // Every preview animation runs at whole multiples of 1 rad/s, so they all
+    // repeat after 2*pi seconds
+    static constexpr float LOOP_SECONDS = 6.2831853f;
+    static constexpr int   ANIMATED_FRAMES = 64;
+
+    // `anchor` is the preview's hip line, as laid out by character select;
+    // `time` picks the frame
+    void draw(sf::RenderTarget& target, CharacterType type, sf::Color color, sf::Vector2f anchor, float time);
+
+    // Drops every baked sheet (they are rebuilt on next view)
+    void clear() { m_sheets.clear(); }
+
+private:
+    struct Sheet {
+        CharacterType     type;
+        sf::Color         color;
+        int               frames = 1;
+        sf::RenderTexture texture;
+    };
+
+    // nullptr when no offscreen target could be created
+    const Sheet* getSheet(CharacterType type, sf::Color color);
+
+    static bool isAnimated(CharacterType type);
+    static void drawArt(ShapeBatch& batch, CharacterType type, sf::Color color, sf::Vector2f anchor, float time);
+
+    std::vector<std::unique_ptr<Sheet>> m_sheets;
+    bool        m_offscreenFailed = false;
+    ShapeBatch  m_batch;
+    sf::Vertex  m_quad[6];
+};
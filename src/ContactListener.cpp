@@ -1,40 +1,46 @@
 #include "ContactListener.h"
+#include <algorithm>
+#include <iostream>
+
+ContactListener::ContactListener(int capacity)
+    : m_events(static_cast<size_t>(std::max(1, capacity))) {}
 
 void ContactListener::processEvents(b2WorldId worldId) {
+    m_count = 0;
+
     // Box2D 3.x: poll contact events after each world step
     b2ContactEvents events = b2World_GetContactEvents(worldId);
 
-    // Process begin-touch events
+    size_t needed = static_cast<size_t>(events.beginCount) + static_cast<size_t>(events.endCount);
+    if (needed > m_events.size()) {
+        size_t grown = std::max(needed, m_events.size() * 2);
+        std::cout << "[ContactListener] Step produced " << needed << " contact events, growing buffer "
+                  << m_events.size() << " -> " << grown << "\n";
+        m_events.resize(grown);
+    }
+
     for (int i = 0; i < events.beginCount; i++) {
         const b2ContactBeginTouchEvent& e = events.beginEvents[i];
 
-        b2BodyId bodyA = b2Shape_GetBody(e.shapeIdA);
-        b2BodyId bodyB = b2Shape_GetBody(e.shapeIdB);
-
-        if (m_beginCallback) {
-            CollisionEvent evt;
-            evt.bodyA = bodyA;
-            evt.bodyB = bodyB;
-            if (e.manifold.pointCount > 0) {
-                evt.contactPoint = e.manifold.points[0].point;
-                evt.normal = e.manifold.normal;
-            }
-            m_beginCallback(evt);
+        CollisionEvent evt;
+        evt.type = CollisionEventType::Begin;
+        evt.a = unpackBodyTag(b2Shape_GetUserData(e.shapeIdA));
+        evt.b = unpackBodyTag(b2Shape_GetUserData(e.shapeIdB));
+        if (e.manifold.pointCount > 0) {
+            evt.contactPoint = e.manifold.points[0].point;
+            evt.normal = e.manifold.normal;
         }
+        m_events[m_count++] = evt;
     }
 
-    // Process end-touch events
+    // End events can reference shapes destroyed during the step (carving)
     for (int i = 0; i < events.endCount; i++) {
         const b2ContactEndTouchEvent& e = events.endEvents[i];
 
-        b2BodyId bodyA = b2Shape_GetBody(e.shapeIdA);
-        b2BodyId bodyB = b2Shape_GetBody(e.shapeIdB);
-
-        if (m_endCallback) {
-            CollisionEvent evt;
-            evt.bodyA = bodyA;
-            evt.bodyB = bodyB;
-            m_endCallback(evt);
-        }
+        CollisionEvent evt;
+        evt.type = CollisionEventType::End;
+        if (b2Shape_IsValid(e.shapeIdA)) evt.a = unpackBodyTag(b2Shape_GetUserData(e.shapeIdA));
+        if (b2Shape_IsValid(e.shapeIdB)) evt.b = unpackBodyTag(b2Shape_GetUserData(e.shapeIdB));
+        m_events[m_count++] = evt;
     }
 }
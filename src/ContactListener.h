@@ -1,29 +1,42 @@
 #pragma once
 #include "Physics.h"
-#include <functional>
 #include <vector>
 
+enum class CollisionEventType : uint8_t {
+    Begin,
+    End,
+};
+
+// One contact between two shapes, with both sides already resolved to the
+// gameplay object they belong to (BodyKind::None for platforms/terrain)
 struct CollisionEvent {
-    b2BodyId bodyA;
-    b2BodyId bodyB;
-    b2Vec2 contactPoint = {0.0f, 0.0f};
-    b2Vec2 normal = {0.0f, 0.0f};
+    CollisionEventType type = CollisionEventType::Begin;
+    BodyTag a;
+    BodyTag b;
+    b2Vec2 contactPoint = {0.0f, 0.0f};   // Begin only
+    b2Vec2 normal = {0.0f, 0.0f};         // Begin only, points from A to B
 };
 
 // Box2D 3.x uses a polling event model instead of callback listeners.
-// Call processEvents() each frame after b2World_Step to handle collisions.
+// processEvents() runs right after each world step and copies that step's
+// contact events into a buffer sized once up front; gameplay systems then
+// iterate the batch. A step with more events than the buffer holds grows it
+// (and says so) rather than losing any: projectile hits come from the Begin
+// events. Tags come from shape user data (Physics::tagBody), so no body
+// lookups happen per event.
 class ContactListener {
 public:
-    using BeginCallback = std::function<void(const CollisionEvent&)>;
-    using EndCallback   = std::function<void(const CollisionEvent&)>;
-
-    void setBeginCallback(BeginCallback cb) { m_beginCallback = std::move(cb); }
-    void setEndCallback(EndCallback cb)     { m_endCallback = std::move(cb); }
+    explicit ContactListener(int capacity = 1024);
 
-    // Call after b2World_Step each frame
+    // Replaces the buffer contents with the events of the latest step
     void processEvents(b2WorldId worldId);
 
+    int size() const { return m_count; }
+    const CollisionEvent& operator[](int i) const { return m_events[i]; }
+
+    int getCapacity() const { return static_cast<int>(m_events.size()); }
+
 private:
-    BeginCallback m_beginCallback;
-    EndCallback   m_endCallback;
+    std::vector<CollisionEvent> m_events;
+    int m_count = 0;
 };
@@ -1,44 +1,23 @@
 #pragma once
-#include "Physics.h"
 #include "Renderer.h"
-#include "Arena.h"
-#include "StickFigure.h"
+#include "Match.h"
 #include "Input.h"
 #include "WeaponFactory.h"
 #include "RulesEngine.h"
 #include "HUD.h"
+#include "Replay.h"
+#include "GameSnapshot.h"
+#include "RollbackSession.h"
+#include "ProfilerOverlay.h"
+#include "ShapeBatch.h"
+#include "ParticleSystem.h"
+#include "CharacterPreviews.h"
 #include <vector>
 #include <memory>
 #include <array>
+#include <cstdint>
 
-enum class GameState { CharSelect, Playing, RoundOver, GameOver };
-
-struct Projectile {
-    b2BodyId bodyId;
-    WeaponData weapon;
-    int ownerIndex = -1;
-    float lifetime = 0.0f;
-    bool alive = true;
-    bool isPoison = false;
-    float poisonDps = 0.0f;
-    float poisonDuration = 0.0f;
-};
-
-struct WeaponPickup {
-    b2Vec2 position;
-    WeaponData weapon;
-    float bobTimer = 0.0f;
-    bool alive = true;
-};
-
-struct ExplosionEffect {
-    float x, y;              // world position
-    float radius;            // blast radius in meters
-    float timer = 0.0f;      // time since detonation
-    float duration = 1.5f;   // how long the effect lasts
-    bool isNuke = false;     // nuke gets special visuals
-    bool alive = true;
-};
+enum class GameState { CharSelect, Connecting, Playing, RoundOver, GameOver };
 
 // Per-player selection state during character select
 struct PlayerSelectState {
@@ -53,6 +32,10 @@ public:
     Game();
     ~Game();
 
+    // Online versus: skips character select and waits for the peer instead.
+    // Call before init().
+    void configureOnline(const RollbackConfig& config, const SessionParams& params);
+
     bool init();
     void run();
 
@@ -61,45 +44,63 @@ private:
     void processCharSelectEvents();
     void updateCharSelect(float dt);
     void renderCharSelect();
+    void drawCharSelectLayer(sf::RenderTarget& target);
+    uint64_t charSelectLayerKey() const;
     bool allPlayersReady() const;
     void startGame();
+    void saveReplay();
+
+    // Online versus
+    void startOnlineGame();
+    void updateOnline();
 
     // Gameplay
     void processEvents();
     void update(float dt);
     void render();
-
-    void handlePlayerInput(float dt);
-    void handleMeleeAttack(StickFigure& attacker);
-    void spawnProjectile(StickFigure& shooter);
-    void updateProjectiles(float dt);
-    void checkFallDeath();
-    void updateWeaponSpawns(float dt);
-    void updateWeaponPickups(float dt);
-    void checkRoundEnd();
+    void renderExplosions();
+    void emitEffects(float dt);
 
     GameState m_state = GameState::CharSelect;
-    float     m_roundTimer = 0.0f;
-    float     m_weaponSpawnTimer = 0.0f;
 
     Renderer      m_renderer;
-    Physics       m_physics;
-    Arena         m_arena;
     Input         m_input;
     WeaponFactory m_weaponFactory;
     RulesEngine   m_rulesEngine;
     HUD           m_hud;
+    ShapeBatch    m_shapes;         // refilled by render(), one draw call per layer
+    ParticleSystem m_particles;
+    uint32_t      m_effectTick = 0;  // last match tick turned into particles
+#ifdef STICKBRAWL_PROFILE
+    ProfilerOverlay m_profilerOverlay;  // F3
+#endif
+
+    // Rebuilt on every startGame so each round gets a fresh Box2D world
+    std::unique_ptr<Match> m_match;
 
-    std::vector<std::unique_ptr<StickFigure>> m_players;
-    std::vector<Projectile> m_projectiles;
-    std::vector<WeaponPickup> m_pickups;
-    std::vector<ExplosionEffect> m_explosions;
+    // Every match is recorded from its first tick to the end of the round
+    ReplayWriter m_recorder;
+
+    // Match as it was before its first tick; R restores it instead of
+    // rebuilding the level
+    GameSnapshot m_roundStart;
+
+    // Set for online versus; the peer's inputs arrive through it
+    std::unique_ptr<RollbackSession> m_session;
+    RollbackConfig m_onlineConfig;
+    SessionParams  m_onlineParams;
 
     // Character select state
     std::array<PlayerSelectState, MAX_PLAYERS> m_selectState;
     float m_selectAnimTimer = 0.0f;
     int   m_selectedLevel = 0;
     bool  m_wrapAround = false;  // fall-through wrap-around mode
+    CharacterPreviews m_previews;
+
+    // Backdrop of character select; redrawn only when its key changes
+    sf::RenderTexture m_selectLayer;
+    bool     m_selectLayerAvailable = false;
+    uint64_t m_selectLayerKey = UINT64_MAX;
 
     static constexpr sf::Color m_playerColors[MAX_PLAYERS] = {
         sf::Color(100, 180, 255),  // Blue
@@ -0,0 +1,21 @@
+#include "GameSnapshot.h"
+#include <iostream>
+
+GameSnapshot::GameSnapshot(size_t capacity) {
+    m_buffer.reserve(capacity);
+}
+
+void GameSnapshot::capture(const Match& match) {
+    match.saveState(m_buffer);
+    m_tick = match.getTick();
+    m_valid = true;
+}
+
+bool GameSnapshot::restore(Match& match) const {
+    if (!m_valid) return false;
+    if (!match.loadState(m_buffer.data(), m_buffer.size())) {
+        std::cerr << "[GameSnapshot] Restore of tick " << m_tick << " failed\n";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "Match.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A captured Match: every Box2D body it owns (ragdolls, platforms, bullets),
+// the platform slots, pickups, explosions, timers and the RNG, serialized
+// into one flat buffer. The buffer is reserved up front and reused, so
+// capturing every checkpoint (rollback) does not allocate once it has grown
+// to the match's working size.
+//
+// A snapshot can only be restored into the Match it came from, or one started
+// with the same level, players and rules. Restoring rebuilds the Box2D world;
+// a snapshot captured on a checkpoint tick (Match::isCheckpoint) then steps
+// exactly as the match did after the capture.
+class GameSnapshot {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    explicit GameSnapshot(size_t capacity = DEFAULT_CAPACITY);
+
+    void capture(const Match& match);
+    bool restore(Match& match) const;
+
+    void clear() { m_buffer.clear(); m_valid = false; }
+
+    bool     isValid() const { return m_valid; }
+    uint32_t getTick() const { return m_tick; }  // Match::getTick() at capture
+    size_t   getSize() const { return m_buffer.size(); }
+
+private:
+    std::vector<uint8_t> m_buffer;
+    uint32_t m_tick = 0;
+    bool     m_valid = false;
+};
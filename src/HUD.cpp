@@ -1,7 +1,28 @@
 #include "HUD.h"
 #include "StickFigure.h"
-#include <sstream>
-#include <iomanip>
+#include <cstdio>
+
+namespace {
+constexpr float BAR_WIDTH = 180.0f;
+constexpr float BAR_HEIGHT = 18.0f;
+constexpr float MARGIN = 15.0f;
+
+// Every font page keeps a white 2x2 block at its origin (sf::Text draws
+// underlines from it), so untextured quads can share the glyph draw
+constexpr sf::Vector2f WHITE_TEXEL = {1.0f, 1.0f};
+
+void appendQuad(std::vector<sf::Vertex>& out, sf::FloatRect rect, sf::Color color,
+                sf::Vector2f uv0 = WHITE_TEXEL, sf::Vector2f uv1 = WHITE_TEXEL) {
+    float l = rect.position.x, t = rect.position.y;
+    float r = l + rect.size.x, b = t + rect.size.y;
+    out.push_back({{l, t}, color, {uv0.x, uv0.y}});
+    out.push_back({{r, t}, color, {uv1.x, uv0.y}});
+    out.push_back({{l, b}, color, {uv0.x, uv1.y}});
+    out.push_back({{l, b}, color, {uv0.x, uv1.y}});
+    out.push_back({{r, t}, color, {uv1.x, uv0.y}});
+    out.push_back({{r, b}, color, {uv1.x, uv1.y}});
+}
+}
 
 bool HUD::init() {
     // SFML 3: Font constructor takes a path and throws on failure
@@ -23,99 +44,155 @@ bool HUD::init() {
         }
     }
 
+    // Rasterize printable ASCII up front so the first frames of a match
+    // don't stall on glyph uploads
+    if (m_fontLoaded) {
+        for (unsigned size : {LABEL_SIZE, TIMER_SIZE})
+            for (char32_t c = 32; c < 127; c++) m_font->getGlyph(c, size, false);
+    }
+
     return true;
 }
 
-void HUD::draw(sf::RenderTarget& target, const std::vector<std::unique_ptr<StickFigure>>& players,
-               float roundTime) {
-    float barWidth = 180.0f;
-    float barHeight = 18.0f;
-    float margin = 15.0f;
-
-    float screenW = static_cast<float>(target.getSize().x);
-    float screenH = static_cast<float>(target.getSize().y);
-
-    // Dynamic layout: top row and bottom row, distributing players
-    // Up to 5 players: top-left, top-right, bottom-left, bottom-right, top-center
-    struct HudSlot { float x; float y; };
-    std::vector<HudSlot> slots;
-    size_t n = players.size();
-    if (n <= 2) {
-        slots.push_back({ margin, margin });
-        slots.push_back({ screenW - margin - barWidth, margin });
-    } else if (n <= 4) {
-        slots.push_back({ margin, margin });
-        slots.push_back({ screenW - margin - barWidth, margin });
-        slots.push_back({ margin, screenH - margin - 50.0f });
-        slots.push_back({ screenW - margin - barWidth, screenH - margin - 50.0f });
-    } else {
-        slots.push_back({ margin, margin });
-        slots.push_back({ screenW - margin - barWidth, margin });
-        slots.push_back({ margin, screenH - margin - 50.0f });
-        slots.push_back({ screenW - margin - barWidth, screenH - margin - 50.0f });
-        slots.push_back({ (screenW - barWidth) / 2.0f, margin }); // top-center
+// Up to 5 players: top-left, top-right, bottom-left, bottom-right, top-center
+void HUD::layoutSlots(sf::Vector2u targetSize, size_t playerCount) {
+    float screenW = static_cast<float>(targetSize.x);
+    float screenH = static_cast<float>(targetSize.y);
+    const sf::Vector2f slots[MAX_PLAYERS] = {
+        {MARGIN, MARGIN},
+        {screenW - MARGIN - BAR_WIDTH, MARGIN},
+        {MARGIN, screenH - MARGIN - 50.0f},
+        {screenW - MARGIN - BAR_WIDTH, screenH - MARGIN - 50.0f},
+        {(screenW - BAR_WIDTH) / 2.0f, MARGIN},
+    };
+    // Two players keep the top corners; three or four fill the corners
+    size_t used = playerCount <= 2 ? 2 : (playerCount <= 4 ? 4 : 5);
+
+    for (size_t i = 0; i < m_players.size(); i++) {
+        PlayerElement& element = m_players[i];
+        element.placed = i < used;
+        if (element.placed) element.position = slots[i];
+        element.health = -1.0f;  // force a rebuild at the new position
+        element.weapon = nullptr;
     }
+    m_timerSeconds = -1;  // re-center the timer
+    m_layoutSize = targetSize;
+    m_layoutCount = playerCount;
+}
 
-    for (size_t i = 0; i < players.size() && i < slots.size(); i++) {
-        const auto& p = players[i];
-        float x = slots[i].x;
-        float y = slots[i].y;
-
-        float healthPct = p->getHealth() / p->getMaxHealth();
-        drawHealthBar(target, x, y, barWidth, barHeight, healthPct, p->getColor());
-
-        if (m_fontLoaded && m_font) {
-            std::stringstream ss;
-            ss << "P" << (i + 1) << " | " << p->getCurrentWeapon().name
-               << " | Lives: " << p->getLives();
-            if (p->getAmmo() >= 0) {
-                ss << " | Ammo: " << p->getAmmo();
-            }
-
-            // SFML 3: Text constructor takes (font, string, charSize)
-            sf::Text label(*m_font, ss.str(), 14);
-            label.setFillColor(p->getColor());
-            label.setPosition({x, y + barHeight + 2.0f});
-            target.draw(label);
+void HUD::updateElement(PlayerElement& element, const StickFigure& player, int index) {
+    float health = player.getHealth();
+    sf::Color color = player.getColor();
+    if (health != element.health || color != element.color) {
+        element.health = health;
+        element.bar.clear();
+        buildHealthBar(element.bar, element.position, BAR_WIDTH, BAR_HEIGHT, health / player.getMaxHealth(), color);
+    }
+
+    const WeaponData* weapon = &player.getCurrentWeapon();
+    int lives = player.getLives();
+    int ammo = player.getAmmo();
+    if (weapon != element.weapon || lives != element.lives || ammo != element.ammo || color != element.color) {
+        element.weapon = weapon;
+        element.lives = lives;
+        element.ammo = ammo;
+        element.label.clear();
+        if (m_fontLoaded) {
+            char text[128];
+            if (ammo >= 0)
+                std::snprintf(text, sizeof(text), "P%d | %s | Lives: %d | Ammo: %d", index + 1, weapon->name.c_str(),
+                              lives, ammo);
+            else
+                std::snprintf(text, sizeof(text), "P%d | %s | Lives: %d", index + 1, weapon->name.c_str(), lives);
+            layoutText(element.label, text, LABEL_SIZE, {element.position.x, element.position.y + BAR_HEIGHT + 2.0f},
+                       color);
         }
     }
+    element.color = color;
+}
+
+void HUD::draw(sf::RenderTarget& target, const std::vector<std::unique_ptr<StickFigure>>& players,
+               float roundTime) {
+    if (target.getSize() != m_layoutSize || players.size() != m_layoutCount)
+        layoutSlots(target.getSize(), players.size());
+
+    m_labelBatch.clear();
+    for (size_t i = 0; i < players.size() && i < m_players.size(); i++) {
+        PlayerElement& element = m_players[i];
+        if (!element.placed) continue;
+        updateElement(element, *players[i], static_cast<int>(i));
+        m_labelBatch.insert(m_labelBatch.end(), element.bar.begin(), element.bar.end());
+        m_labelBatch.insert(m_labelBatch.end(), element.label.begin(), element.label.end());
+    }
 
     // Round timer
-    if (m_fontLoaded && m_font) {
-        int minutes = static_cast<int>(roundTime) / 60;
-        int seconds = static_cast<int>(roundTime) % 60;
-        std::stringstream ss;
-        ss << std::setfill('0') << std::setw(2) << minutes << ":"
-           << std::setfill('0') << std::setw(2) << seconds;
-
-        sf::Text timer(*m_font, ss.str(), 24);
-        timer.setFillColor(sf::Color::White);
-        sf::FloatRect bounds = timer.getLocalBounds();
-        timer.setPosition({(static_cast<float>(target.getSize().x) - bounds.size.x) / 2.0f, 15.0f});
-        target.draw(timer);
+    int wholeSeconds = static_cast<int>(roundTime);
+    if (m_fontLoaded && wholeSeconds != m_timerSeconds) {
+        m_timerSeconds = wholeSeconds;
+        char text[16];
+        std::snprintf(text, sizeof(text), "%02d:%02d", wholeSeconds / 60, wholeSeconds % 60);
+        m_timer.clear();
+        float width = layoutText(m_timer, text, TIMER_SIZE, {0.0f, 15.0f}, sf::Color::White);
+        float x = (static_cast<float>(target.getSize().x) - width) / 2.0f;
+        for (auto& v : m_timer) v.position.x += x;
+    }
+
+    sf::RenderStates labelStates;
+    if (m_fontLoaded) labelStates.texture = &m_font->getTexture(LABEL_SIZE);
+    if (!m_labelBatch.empty())
+        target.draw(m_labelBatch.data(), m_labelBatch.size(), sf::PrimitiveType::Triangles, labelStates);
+
+    if (m_fontLoaded && !m_timer.empty()) {
+        sf::RenderStates timerStates(&m_font->getTexture(TIMER_SIZE));
+        target.draw(m_timer.data(), m_timer.size(), sf::PrimitiveType::Triangles, timerStates);
     }
 }
 
-void HUD::drawHealthBar(sf::RenderTarget& target, float x, float y, float width, float height,
-                         float healthPercent, sf::Color color) {
-    // Background
-    sf::RectangleShape bg({width, height});
-    bg.setPosition({x, y});
-    bg.setFillColor(sf::Color(40, 40, 40));
-    bg.setOutlineColor(sf::Color(100, 100, 100));
-    bg.setOutlineThickness(1.0f);
-    target.draw(bg);
+// Same placement as sf::Text: the baseline sits one character size below
+// the top, with kerning between pairs and a 1 px texel pad around each glyph
+float HUD::layoutText(std::vector<sf::Vertex>& out, const char* text, unsigned size, sf::Vector2f position,
+                      sf::Color color) const {
+    constexpr float padding = 1.0f;
+    float x = 0.0f;
+    float baseline = static_cast<float>(size);
+    char32_t prev = 0;
+    for (const char* p = text; *p; p++) {
+        char32_t c = static_cast<unsigned char>(*p);
+        x += m_font->getKerning(prev, c, size);
+        prev = c;
 
-    // Health fill
-    sf::RectangleShape fill({width * healthPercent, height});
-    fill.setPosition({x, y});
+        const sf::Glyph& glyph = m_font->getGlyph(c, size, false);
+        if (c != U' ') {
+            sf::FloatRect rect = {{position.x + x + glyph.bounds.position.x - padding,
+                                   position.y + baseline + glyph.bounds.position.y - padding},
+                                  {glyph.bounds.size.x + 2.0f * padding, glyph.bounds.size.y + 2.0f * padding}};
+            sf::Vector2f uv0 = {static_cast<float>(glyph.textureRect.position.x) - padding,
+                                static_cast<float>(glyph.textureRect.position.y) - padding};
+            sf::Vector2f uv1 = {static_cast<float>(glyph.textureRect.position.x + glyph.textureRect.size.x) + padding,
+                                static_cast<float>(glyph.textureRect.position.y + glyph.textureRect.size.y) + padding};
+            appendQuad(out, rect, color, uv0, uv1);
+        }
+        x += glyph.advance;
+    }
+    return x;
+}
+
+void HUD::buildHealthBar(std::vector<sf::Vertex>& out, sf::Vector2f position, float width, float height,
+                         float healthPercent, sf::Color color) const {
+    // Background with a 1 px outline outside it
+    const sf::Color outline(100, 100, 100);
+    appendQuad(out, {{position.x - 1.0f, position.y - 1.0f}, {width + 2.0f, 1.0f}}, outline);
+    appendQuad(out, {{position.x - 1.0f, position.y + height}, {width + 2.0f, 1.0f}}, outline);
+    appendQuad(out, {{position.x - 1.0f, position.y}, {1.0f, height}}, outline);
+    appendQuad(out, {{position.x + width, position.y}, {1.0f, height}}, outline);
+    appendQuad(out, {position, {width, height}}, sf::Color(40, 40, 40));
 
+    // Health fill
     sf::Color healthColor = color;
     if (healthPercent < 0.3f) {
         healthColor = sf::Color(200, 50, 50);
     } else if (healthPercent < 0.6f) {
         healthColor = sf::Color(200, 150, 50);
     }
-    fill.setFillColor(healthColor);
-    target.draw(fill);
+    appendQuad(out, {position, {width * healthPercent, height}}, healthColor);
 }
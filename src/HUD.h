@@ -1,21 +1,64 @@
 #pragma once
+#include "PlayerInput.h"
 #include <SFML/Graphics.hpp>
+#include <array>
 #include <vector>
 #include <memory>
 #include <optional>
 
 class StickFigure;
+struct WeaponData;
 
+// Health bars, player labels and the round timer. Every element is retained:
+// its vertices are rebuilt only when the value it shows changes (health,
+// weapon, lives, ammo, the timer's whole seconds), and glyphs come straight
+// from the font's atlas, prewarmed in init(). A frame is two textured draws
+// (one per character size) and allocates nothing once warm.
 class HUD {
 public:
     bool init();
     void draw(sf::RenderTarget& target, const std::vector<std::unique_ptr<StickFigure>>& players,
               float roundTime);
 
+    // Also used by character select; nullptr when no font could be loaded
+    const sf::Font* getFont() const { return m_fontLoaded ? &*m_font : nullptr; }
+
 private:
+    static constexpr unsigned LABEL_SIZE = 14;
+    static constexpr unsigned TIMER_SIZE = 24;
+
+    struct PlayerElement {
+        sf::Vector2f position;
+        sf::Color    color;
+        bool         placed = false;
+
+        float health = -1.0f;
+        std::vector<sf::Vertex> bar;
+
+        const WeaponData* weapon = nullptr;
+        int lives = -1;
+        int ammo = -2;
+        std::vector<sf::Vertex> label;
+    };
+
+    void layoutSlots(sf::Vector2u targetSize, size_t playerCount);
+    void updateElement(PlayerElement& element, const StickFigure& player, int index);
+    void buildHealthBar(std::vector<sf::Vertex>& out, sf::Vector2f position, float width, float height,
+                        float healthPercent, sf::Color color) const;
+    // Appends `text` as glyph quads with its top-left at `position`; returns
+    // the advance width
+    float layoutText(std::vector<sf::Vertex>& out, const char* text, unsigned size, sf::Vector2f position,
+                     sf::Color color) const;
+
     std::optional<sf::Font> m_font;
     bool m_fontLoaded = false;
 
-    void drawHealthBar(sf::RenderTarget& target, float x, float y, float width, float height,
-                       float healthPercent, sf::Color color);
+    std::array<PlayerElement, MAX_PLAYERS> m_players;
+    sf::Vector2u m_layoutSize;
+    size_t       m_layoutCount = 0;
+
+    int m_timerSeconds = -1;
+    std::vector<sf::Vertex> m_timer;
+
+    std::vector<sf::Vertex> m_labelBatch;  // bars and labels, LABEL_SIZE atlas
 };
@@ -1,20 +1,8 @@
 #pragma once
+#include "PlayerInput.h"
 #include <SFML/Window.hpp>
 #include <array>
 
-constexpr int MAX_PLAYERS = 5;
-
-struct PlayerInput {
-    bool moveLeft = false;
-    bool moveRight = false;
-    bool jump = false;
-    bool attack = false;
-    bool aimUp = false;
-    bool aimDown = false;
-    bool jumpPressed = false;
-    bool attackPressed = false;
-};
-
 class Input {
 public:
     Input();
@@ -0,0 +1,187 @@
+#include "Lobby.h"
+#include "ServerProtocol.h"
+#include <algorithm>
+#include <iostream>
+
+Lobby::Lobby(uint32_t id, const GameRules& rules, const WeaponFactory& weapons, int playersToStart)
+    : m_id(id), m_rules(rules), m_weapons(weapons),
+      m_playersToStart(std::clamp(playersToStart, 1, MAX_PLAYERS)), m_bounds(rules) {}
+
+// ============================================================
+// MEMBERS
+// ============================================================
+
+int Lobby::addClient(const NetAddress& addr, CharacterType character) {
+    for (int i = 0; i < MAX_PLAYERS; i++)
+        if (m_members[i].used && !m_members[i].bot && m_members[i].addr == addr) return i;
+    if (isRunning()) return -1;
+
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        Member& m = m_members[i];
+        if (m.used) continue;
+        m = Member{};
+        m.used = true;
+        m.addr = addr;
+        m.character = character;
+        m.lastHeard = Clock::now();
+        std::cout << "[Lobby " << m_id << "] " << addr.toString() << " joined as slot " << i << "\n";
+        return i;
+    }
+    return -1;
+}
+
+void Lobby::addBot(CharacterType character, unsigned int seed) {
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        Member& m = m_members[i];
+        if (m.used) continue;
+        m = Member{};
+        m.used = true;
+        m.bot = true;
+        m.character = character;
+        m.botController.emplace(i, seed);
+        return;
+    }
+}
+
+void Lobby::removeClient(int slot, const NetAddress& from) {
+    if (slot < 0 || slot >= MAX_PLAYERS) return;
+    Member& m = m_members[slot];
+    if (!m.used || m.bot || m.addr != from) return;
+    std::cout << "[Lobby " << m_id << "] " << from.toString() << " left slot " << slot << "\n";
+    // A running match keeps the player; it just stops moving
+    m.used = false;
+    m.input = PlayerInput{};
+}
+
+void Lobby::setInput(int slot, const NetAddress& from, const PlayerInput& input) {
+    if (slot < 0 || slot >= MAX_PLAYERS) return;
+    Member& m = m_members[slot];
+    if (!m.used || m.bot || m.addr != from) return;
+    m.input = input;
+    m.lastHeard = Clock::now();
+}
+
+void Lobby::acknowledgeState(int slot, const NetAddress& from, uint16_t seq) {
+    if (slot < 0 || slot >= MAX_PLAYERS) return;
+    Member& m = m_members[slot];
+    if (!m.used || m.bot || m.addr != from) return;
+    m.replication.acknowledge(seq);
+}
+
+int Lobby::dropSilentClients(float timeoutSeconds) {
+    auto now = Clock::now();
+    int dropped = 0;
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        Member& m = m_members[i];
+        if (!m.used || m.bot) continue;
+        if (std::chrono::duration<float>(now - m.lastHeard).count() < timeoutSeconds) continue;
+        std::cout << "[Lobby " << m_id << "] " << m.addr.toString() << " timed out\n";
+        m.used = false;
+        m.input = PlayerInput{};
+        dropped++;
+    }
+    return dropped;
+}
+
+int Lobby::getMemberCount() const {
+    int n = 0;
+    for (const auto& m : m_members) n += m.used ? 1 : 0;
+    return n;
+}
+
+int Lobby::getClientCount() const {
+    int n = 0;
+    for (const auto& m : m_members) n += (m.used && !m.bot) ? 1 : 0;
+    return n;
+}
+
+bool Lobby::hasClients() const {
+    return getClientCount() > 0;
+}
+
+bool Lobby::isReadyToStart() const {
+    return !isRunning() && getMemberCount() >= m_playersToStart;
+}
+
+// ============================================================
+// MATCH
+// ============================================================
+
+void Lobby::startMatch(uint64_t seed, int levelIndex) {
+    std::vector<PlayerSetup> setups;
+    for (auto& m : m_members) {
+        m.playerIndex = -1;
+        m.replication.startMatch();  // the new match's terrain starts uncarved
+        if (!m.used) continue;
+        m.playerIndex = static_cast<int>(setups.size());
+        setups.push_back({m.character, sf::Color::White});
+    }
+
+    m_match.reset();  // free the old world first; Box2D caps live worlds
+    m_match = std::make_unique<Match>(m_rules, m_weapons);
+    m_match->start(levelIndex, setups, false, seed);
+    m_roundOverTicks = 0;
+
+    // Bots are bound to their player index, which may have shifted
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        Member& m = m_members[i];
+        if (m.used && m.bot) m.botController.emplace(m.playerIndex, static_cast<unsigned int>(seed) + i);
+    }
+}
+
+void Lobby::endMatch() {
+    m_match.reset();
+    m_roundOverTicks = 0;
+}
+
+void Lobby::tick(UdpSocket& socket) {
+    if (!m_match) return;
+    auto t0 = Clock::now();
+
+    bool simulated = !m_match->isRoundOver();
+    if (!simulated) {
+        m_roundOverTicks++;
+    } else {
+        PlayerInputs inputs{};
+        for (auto& m : m_members) {
+            if (!m.used || m.playerIndex < 0) continue;
+            inputs[m.playerIndex] = m.bot ? m.botController->think(*m_match) : m.input;
+        }
+        m_match->update(FIXED_DT, inputs);
+    }
+    broadcastState(socket, simulated);
+
+    double us = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+    m_timing.totalUs += us;
+    m_timing.maxUs = std::max(m_timing.maxUs, us);
+    m_timing.ticks++;
+}
+
+Lobby::Timing Lobby::takeTiming() {
+    Timing t = m_timing;
+    m_timing = Timing{};
+    return t;
+}
+
+// Every client gets its own packet, delta-encoded against what it last
+// acknowledged (see Replication.h)
+void Lobby::broadcastState(UdpSocket& socket, bool simulated) {
+    if (!hasClients()) return;
+
+    static const std::vector<CarveEvent> noCarves;
+    const auto& carves = simulated ? m_match->getCarveEvents() : noCarves;
+    m_state.capture(*m_match, m_bounds);
+
+    for (auto& m : m_members) {
+        if (!m.used || m.bot) continue;
+        m_packet.clear();
+        auto putLE = [&](uint64_t v, int bytes) {
+            for (int i = 0; i < bytes; i++) m_packet.push_back(static_cast<uint8_t>(v >> (8 * i)));
+        };
+        putLE(SERVER_MAGIC, 2);
+        putLE(static_cast<uint8_t>(ServerPacket::State), 1);
+        putLE(m_id, 4);
+        m.replication.encode(m_state, carves, m_packet);
+        socket.send(m.addr, m_packet.data(), m_packet.size());
+    }
+}
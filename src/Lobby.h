@@ -0,0 +1,94 @@
+#pragma once
+#include "Match.h"
+#include "BotController.h"
+#include "UdpSocket.h"
+#include "Replication.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+// One server-hosted match and the clients (or bots) playing it. The lobby
+// owns its Match outright, and with it a private Box2D world, arena, players
+// and projectiles, so lobbies share nothing mutable and tick in parallel.
+//
+// Threading: everything except tick() runs on the server's main thread
+// between ticks. Match creation and destruction stay there because creating
+// or destroying a Box2D world is not thread-safe.
+class Lobby {
+public:
+    Lobby(uint32_t id, const GameRules& rules, const WeaponFactory& weapons, int playersToStart);
+    Lobby(const Lobby&) = delete;
+    Lobby& operator=(const Lobby&) = delete;
+
+    uint32_t getId() const { return m_id; }
+
+    // Returns the member slot, or -1 when full or already playing. Joining
+    // again from the same address returns the existing slot.
+    int  addClient(const NetAddress& addr, CharacterType character);
+    void addBot(CharacterType character, unsigned int seed);
+    void removeClient(int slot, const NetAddress& from);
+    void setInput(int slot, const NetAddress& from, const PlayerInput& input);
+    // The client received state packet `seq`; later packets delta against it
+    void acknowledgeState(int slot, const NetAddress& from, uint16_t seq);
+
+    // Frees client slots that have been silent too long; returns how many
+    int dropSilentClients(float timeoutSeconds);
+
+    bool isRunning() const { return m_match != nullptr; }
+    bool isReadyToStart() const;
+    bool hasClients() const;
+    int  getMemberCount() const;
+    int  getClientCount() const;
+    bool isAcceptingPlayers() const { return !isRunning() && getMemberCount() < MAX_PLAYERS; }
+
+    void startMatch(uint64_t seed, int levelIndex);
+    void endMatch();
+
+    // Ticks spent on the round-over screen; the server restarts after a pause
+    int getRoundOverTicks() const { return m_roundOverTicks; }
+
+    // One fixed step plus the state broadcast. Safe to run concurrently with
+    // other lobbies' tick() (sendto on a shared socket is thread-safe).
+    void tick(UdpSocket& socket);
+
+    struct Timing {
+        double totalUs = 0.0;
+        double maxUs = 0.0;
+        int    ticks = 0;
+    };
+    // Tick timing accumulated since the previous call
+    Timing takeTiming();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Member {
+        bool used = false;
+        bool bot = false;
+        NetAddress addr;
+        CharacterType character = CharacterType::Stick;
+        PlayerInput input;
+        Clock::time_point lastHeard;
+        std::optional<BotController> botController;
+        int playerIndex = -1;  // index in the running Match
+        ReplicationEncoder replication;
+    };
+
+    void broadcastState(UdpSocket& socket, bool simulated);
+
+    uint32_t m_id;
+    GameRules m_rules;
+    const WeaponFactory& m_weapons;
+    int m_playersToStart;
+
+    std::array<Member, MAX_PLAYERS> m_members;
+    std::unique_ptr<Match> m_match;
+    int m_roundOverTicks = 0;
+
+    Timing m_timing;
+    ReplicationBounds m_bounds;
+    ReplicatedState m_state;        // quantized once per tick, shared by all clients
+    std::vector<uint8_t> m_packet;
+};
@@ -0,0 +1,696 @@
+#include "Match.h"
+#include "Profiler.h"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+Match::Match(const GameRules& rules, const WeaponFactory& weapons)
+    : m_rules(rules), m_weapons(weapons) {}
+
+void Match::start(int levelIndex, const std::vector<PlayerSetup>& players, bool wrapAround, uint64_t seed) {
+    // Empty world, so a match can be started over (ReplayReader::seek)
+    m_physics.reset();
+    m_seed = seed;
+    m_rng.seed(seed);
+    m_physics.setGravity(m_rules.gravityX, m_rules.gravityY);
+    m_arena.setFragmentBudget(m_rules.terrainFragmentBudget);
+    m_arena.setBitmapTerrain(m_rules.bitmapTerrain);
+    m_arena.createLevel(m_physics, levelIndex);
+    m_projectiles.init(m_physics, m_rules.maxProjectiles);
+    m_wrapAround = wrapAround;
+
+    const auto& spawns = m_arena.getSpawnPoints();
+    m_players.clear();
+    m_pickups.clear();
+    m_explosions.clear();
+    m_carveEvents.clear();
+    m_effectEvents.clear();
+
+    for (const auto& setup : players) {
+        int playerIdx = static_cast<int>(m_players.size());
+        if (playerIdx >= static_cast<int>(spawns.size())) break;
+
+        CharacterType ct = setup.type;
+        auto p = std::make_unique<StickFigure>(
+            playerIdx, m_physics, spawns[playerIdx].x, spawns[playerIdx].y,
+            setup.color, ct);
+        p->setLives(m_rules.livesPerPlayer);
+        p->setMaxHealth(m_rules.maxHealth);
+
+        // Give innate weapons
+        if (ct == CharacterType::Cobra) {
+            auto* poison = m_weapons.getWeapon("Poison Spit");
+            if (poison) p->equipWeapon(*poison);
+        } else if (ct == CharacterType::Unicorn) {
+            auto* horn = m_weapons.getWeapon("Horn Blast");
+            if (horn) p->equipWeapon(*horn);
+        } else if (ct == CharacterType::Crocodile) {
+            auto* jaw = m_weapons.getWeapon("Jaw Snap");
+            if (jaw) p->equipWeapon(*jaw);
+        } else if (ct == CharacterType::StickLady) {
+            auto* purse = m_weapons.getWeapon("Purse Swing");
+            if (purse) p->equipWeapon(*purse);
+        }
+
+        m_players.push_back(std::move(p));
+    }
+
+    m_tick = 0;
+    m_roundTimer = m_rules.roundTimeSeconds;
+    m_weaponSpawnTimer = m_rules.weaponSpawnInterval;
+    m_roundOver = false;
+    m_winner = -1;
+    m_worldFresh = false;
+}
+
+void Match::reseed(uint64_t seed) {
+    m_seed = seed;
+    m_rng.seed(seed);
+}
+
+void Match::restartRound() {
+    const auto& spawns = m_arena.getSpawnPoints();
+    for (size_t i = 0; i < m_players.size(); i++)
+        m_players[i]->respawn(spawns[i].x, spawns[i].y);
+    m_pickups.clear();
+    m_roundTimer = m_rules.roundTimeSeconds;
+    m_roundOver = false;
+    m_winner = -1;
+}
+
+// ============================================================
+// STATE CAPTURE
+// ============================================================
+
+namespace {
+constexpr uint32_t STATE_MAGIC = 0x54534253;  // "SBST"
+
+// The state structs below have padding, so they are written field by field
+// (see IsPaddingFree)
+struct MatchScalars {
+    uint32_t tick;
+    float roundTimer;
+    float weaponSpawnTimer;
+    bool  wrapAround;
+    bool  roundOver;
+    int   winner;
+    Rng   rng;
+
+    void write(StateWriter& w) const {
+        w.write(tick);
+        w.write(roundTimer);
+        w.write(weaponSpawnTimer);
+        w.write(wrapAround);
+        w.write(roundOver);
+        w.write(winner);
+        w.write(rng);
+    }
+    bool read(StateReader& r) {
+        r.read(tick);
+        r.read(roundTimer);
+        r.read(weaponSpawnTimer);
+        r.read(wrapAround);
+        r.read(roundOver);
+        r.read(winner);
+        r.read(rng);
+        return r.ok();
+    }
+};
+
+struct PickupState {
+    static constexpr size_t BYTES = sizeof(b2Vec2) + sizeof(WeaponId) + sizeof(float) + sizeof(bool);
+
+    b2Vec2   position;
+    WeaponId weaponId;
+    float    bobTimer;
+    bool     alive;
+
+    void write(StateWriter& w) const {
+        w.write(position);
+        w.write(weaponId);
+        w.write(bobTimer);
+        w.write(alive);
+    }
+    bool read(StateReader& r) {
+        r.read(position);
+        r.read(weaponId);
+        r.read(bobTimer);
+        r.read(alive);
+        return r.ok();
+    }
+};
+
+constexpr size_t EXPLOSION_BYTES = 5 * sizeof(float) + 2 * sizeof(bool);
+
+void writeExplosion(StateWriter& w, const ExplosionEffect& fx) {
+    w.write(fx.x);
+    w.write(fx.y);
+    w.write(fx.radius);
+    w.write(fx.timer);
+    w.write(fx.duration);
+    w.write(fx.isNuke);
+    w.write(fx.alive);
+}
+
+void readExplosion(StateReader& r, ExplosionEffect& fx) {
+    r.read(fx.x);
+    r.read(fx.y);
+    r.read(fx.radius);
+    r.read(fx.timer);
+    r.read(fx.duration);
+    r.read(fx.isNuke);
+    r.read(fx.alive);
+}
+} // namespace
+
+void Match::saveState(std::vector<uint8_t>& out) const {
+    out.clear();
+    StateWriter w(out);
+    w.write(STATE_MAGIC);
+    w.write(static_cast<uint32_t>(m_players.size()));
+    MatchScalars{m_tick, m_roundTimer, m_weaponSpawnTimer, m_wrapAround, m_roundOver, m_winner, m_rng}.write(w);
+
+    // Same order as start() creates bodies in; applyState rebuilds in blob order
+    m_arena.saveState(w);
+    for (const auto& p : m_players) p->saveState(w);
+    m_projectiles.saveState(w);
+
+    w.write(static_cast<uint32_t>(m_pickups.size()));
+    for (const auto& pk : m_pickups)
+        PickupState{pk.position, pk.weapon ? pk.weapon->id : INVALID_WEAPON_ID, pk.bobTimer, pk.alive}.write(w);
+    w.write(static_cast<uint32_t>(m_explosions.size()));
+    for (const auto& fx : m_explosions) writeExplosion(w, fx);
+}
+
+// A blob that fails halfway has already replaced the world, so the current
+// state is kept aside first and put back on failure
+bool Match::loadState(const uint8_t* data, size_t size) {
+    saveState(m_loadBackup);
+    if (applyState(data, size)) return true;
+
+    std::cerr << "[Match] Rejected state blob, keeping the current state\n";
+    applyState(m_loadBackup.data(), m_loadBackup.size());
+    return false;
+}
+
+// Box2D keeps history that no state blob carries: contact and warm-start
+// caches, fat AABBs, id free lists, island and solver-set order. Two worlds
+// with equal bodies but different pasts step differently, which is how a
+// rollback used to desync the peers. On checkpoint ticks the world is
+// rebuilt from the match's own state, the same way loadState builds it, so a
+// match restored from a checkpoint blob and one that ran straight through
+// step from identical worlds. Between checkpoints the world keeps its
+// caches, warm starting and sleep as usual.
+void Match::rebuildWorld() {
+    PROFILE_SCOPE(ProfileZone::WorldRebuild);
+    saveState(m_rebuildScratch);
+    if (!applyState(m_rebuildScratch.data(), m_rebuildScratch.size()))
+        std::cerr << "[Match] World rebuild failed at tick " << m_tick << "\n";
+}
+
+bool Match::applyState(const uint8_t* data, size_t size) {
+    m_carveEvents.clear();
+    m_effectEvents.clear();
+    StateReader r(data, size);
+    uint32_t magic = 0, playerCount = 0;
+    r.read(magic);
+    r.read(playerCount);
+    if (!r.ok() || magic != STATE_MAGIC || playerCount != m_players.size()) {
+        std::cerr << "[Match] State blob does not match this match\n";
+        return false;
+    }
+
+    MatchScalars s;
+    if (!s.read(r)) return false;
+
+    // Everything below recreates its bodies in the empty world, in blob order
+    m_physics.reset();
+    m_tick = s.tick;
+    m_roundTimer = s.roundTimer;
+    m_weaponSpawnTimer = s.weaponSpawnTimer;
+    m_wrapAround = s.wrapAround;
+    m_roundOver = s.roundOver;
+    m_winner = s.winner;
+    m_rng = s.rng;
+    m_worldFresh = true;
+
+    if (!m_arena.loadState(r, m_physics)) return false;
+    for (auto& p : m_players) p->loadState(r, m_weapons);
+    if (!r.ok() || !m_projectiles.loadState(r, m_weapons)) return false;
+
+    uint32_t pickupCount = 0;
+    if (!r.read(pickupCount) || r.remaining() < static_cast<size_t>(pickupCount) * PickupState::BYTES)
+        return false;
+    m_pickups.resize(pickupCount);
+    for (auto& pk : m_pickups) {
+        PickupState st;
+        st.read(r);
+        pk.position = st.position;
+        pk.weapon = st.weaponId == INVALID_WEAPON_ID ? nullptr : &m_weapons.getWeaponById(st.weaponId);
+        pk.bobTimer = st.bobTimer;
+        pk.alive = st.alive;
+    }
+    uint32_t explosionCount = 0;
+    if (!r.read(explosionCount) || r.remaining() < static_cast<size_t>(explosionCount) * EXPLOSION_BYTES)
+        return false;
+    m_explosions.resize(explosionCount);
+    for (auto& fx : m_explosions) readExplosion(r, fx);
+    return r.ok();
+}
+
+void Match::update(float dt, const PlayerInputs& inputs) {
+    PROFILE_SCOPE(ProfileZone::Tick);
+    m_carveEvents.clear();
+    m_effectEvents.clear();
+    if (m_roundOver) return;
+    // A world loaded on this tick is already the rebuilt one
+    if (isCheckpoint(m_tick) && !m_worldFresh) rebuildWorld();
+    m_worldFresh = false;
+    m_tick++;
+    m_roundTimer -= dt;
+    if (m_roundTimer <= 0.0f) { m_roundTimer = 0.0f; m_roundOver = true; return; }
+
+    {
+        PROFILE_SCOPE(ProfileZone::PlayerInput);
+        handlePlayerInput(inputs);
+    }
+    {
+        PROFILE_SCOPE(ProfileZone::FigureUpdate);
+        for (auto& p : m_players) p->update(dt);
+    }
+    {
+        PROFILE_SCOPE(ProfileZone::PhysicsStep);
+        m_physics.step(dt);
+    }
+    m_contacts.processEvents(m_physics.getWorldId());
+    {
+        PROFILE_SCOPE(ProfileZone::Projectiles);
+        collectProjectileHits();
+        updateProjectiles(dt);
+    }
+    {
+        PROFILE_SCOPE(ProfileZone::Pickups);
+        updateWeaponPickups(dt);
+    }
+    checkFallDeath();
+    updateWeaponSpawns(dt);
+    checkRoundEnd();
+}
+
+void Match::handlePlayerInput(const PlayerInputs& inputs) {
+    for (size_t i = 0; i < m_players.size(); i++) {
+        auto& player = m_players[i];
+        if (!player->isAlive()) continue;
+
+        const PlayerInput& pi = inputs[i];
+
+        if (pi.moveLeft) player->moveLeft();
+        else if (pi.moveRight) player->moveRight();
+        else player->stopMoving();
+
+        if (pi.jumpPressed) player->jump();
+
+        // Aiming
+        if (pi.aimUp) player->aimUp();
+        else if (pi.aimDown) player->aimDown();
+        else player->resetAim();
+
+        if (pi.attackPressed && player->canAttack()) {
+            const auto& weapon = player->getCurrentWeapon();
+            player->attack();
+            if (weapon.type == WeaponType::Melee)
+                handleMeleeAttack(*player);
+            else
+                spawnProjectile(*player);
+        }
+    }
+}
+
+void Match::handleMeleeAttack(StickFigure& attacker) {
+    const auto& weapon = attacker.getCurrentWeapon();
+    const auto& rules = m_rules;
+    b2Vec2 ap = attacker.getPosition();
+    float dir = static_cast<float>(attacker.getFacingDirection());
+
+    for (auto& target : m_players) {
+        if (target->getPlayerIndex() == attacker.getPlayerIndex()) continue;
+        if (!target->isAlive()) continue;
+
+        b2Vec2 tp = target->getPosition();
+        float dx = tp.x - ap.x, dy = tp.y - ap.y;
+        float dist = std::sqrt(dx * dx + dy * dy);
+        bool inRange = dist < weapon.range;
+        bool facing = dx * dir >= -0.3f;
+        bool close = dist < weapon.range * 0.5f;
+
+        if (inRange && (facing || close)) {
+            float dmg = weapon.damage * rules.damageMultiplier;
+            float kbX = weapon.knockbackForce * dir * rules.knockbackMultiplier;
+            float kbY = weapon.knockbackForce * 0.5f * rules.knockbackMultiplier;
+            target->takeDamage(dmg, kbX, kbY);
+            m_effectEvents.push_back({EffectEventType::Hit, tp.x, tp.y, dir, &weapon});
+        }
+    }
+
+    // Worms-style terrain carving from melee — small chip in front of attacker
+    float envR = weapon.envDamageRadius;
+    if (envR <= 0.0f) envR = weapon.damage * 0.015f; // small carve radius
+    float hitX = ap.x + dir * weapon.range * 0.6f;
+    float hitY = ap.y;
+    carveTerrain(hitX, hitY, envR);
+}
+
+void Match::spawnProjectile(StickFigure& shooter) {
+    const auto& weapon = shooter.getCurrentWeapon();
+    if (weapon.type == WeaponType::Melee) return;
+
+    b2Vec2 pos = shooter.getPosition();
+    float dir = static_cast<float>(shooter.getFacingDirection());
+    float baseAim = shooter.getAimAngle();
+    float spreadRad = weapon.spreadDegrees * 3.14159f / 180.0f;
+
+    int pellets = std::max(1, weapon.pelletCount);
+    for (int p = 0; p < pellets; p++) {
+        float aim = baseAim;
+
+        if (pellets > 1) {
+            // Even spread across the cone, with a little randomness
+            float evenSpread = -spreadRad + 2.0f * spreadRad * (static_cast<float>(p) / static_cast<float>(pellets - 1));
+            aim += evenSpread + m_rng.uniform(-spreadRad * 0.15f, spreadRad * 0.15f);
+        } else if (spreadRad > 0.0f) {
+            aim += m_rng.uniform(-spreadRad, spreadRad);
+        }
+
+        // Slight speed variance for multi-pellet
+        float speed = weapon.projectileSpeed;
+        if (pellets > 1) speed *= m_rng.uniform(0.85f, 1.15f);
+
+        float vx = speed * dir * std::cos(aim);
+        float vy = speed * std::sin(aim);
+
+        // Smaller pellets for shotgun
+        float radius = (pellets > 1) ? 0.08f : 0.15f;
+        float mass = (pellets > 1) ? 0.05f : 0.1f;
+
+        Projectile* proj = fireProjectile(weapon, shooter.getPlayerIndex(),
+                                          {pos.x + dir * 0.5f, pos.y + 0.3f}, {vx, vy}, radius, mass);
+        if (!proj) return;  // pool exhausted; drop the rest of the volley
+    }
+}
+
+Projectile* Match::fireProjectile(const WeaponData& weapon, int ownerIndex, b2Vec2 pos, b2Vec2 vel,
+                                  float radius, float mass) {
+    Projectile* proj = m_projectiles.spawn(pos, vel, radius, mass, weapon.affectedByGravity);
+    if (!proj) return nullptr;
+
+    proj->weapon = &weapon;
+    proj->ownerIndex = ownerIndex;
+    proj->lifetime = weapon.projectileLifetime;
+    proj->alive = true;
+
+    if (weapon.poisonDps > 0.0f && weapon.poisonDuration > 0.0f) {
+        proj->isPoison = true;
+        proj->poisonDps = weapon.poisonDps;
+        proj->poisonDuration = weapon.poisonDuration;
+    }
+    return proj;
+}
+
+void Match::updateProjectiles(float dt) {
+    for (int slot : m_projectiles.getActive()) {
+        Projectile& proj = m_projectiles[slot];
+        if (!proj.alive) continue;
+        proj.lifetime -= dt;
+
+        b2Vec2 pp = b2Body_GetPosition(proj.bodyId);
+
+        // Wrap projectiles around if enabled
+        if (m_wrapAround) {
+            float worldHalfW = SCREEN_WIDTH / PPM / 2.0f + 2.0f;
+            float worldTop   = SCREEN_HEIGHT / PPM / 2.0f + 2.0f;
+            float worldBot   = -20.0f;
+            bool wrapped = false;
+            if (pp.x < -worldHalfW)  { pp.x = worldHalfW - 1.0f; wrapped = true; }
+            if (pp.x > worldHalfW)   { pp.x = -worldHalfW + 1.0f; wrapped = true; }
+            if (pp.y < worldBot)     { pp.y = worldTop; wrapped = true; }
+            if (wrapped) {
+                b2Body_SetTransform(proj.bodyId, pp, b2Body_GetRotation(proj.bodyId));
+            }
+        }
+        bool isExplosive = (proj.weapon->type == WeaponType::Explosive);
+        float hitR = proj.weapon->explosionRadius;
+
+        // Check if explosive projectile has stopped moving (hit a platform)
+        bool contactDetonation = false;
+        if (isExplosive && proj.lifetime < proj.weapon->projectileLifetime - 0.1f) {
+            b2Vec2 vel = b2Body_GetLinearVelocity(proj.bodyId);
+            float speed = std::sqrt(vel.x * vel.x + vel.y * vel.y);
+            if (speed < 1.0f) contactDetonation = true;
+        }
+
+        // Lifetime expiry for explosives = detonate in place
+        bool expired = proj.lifetime <= 0.0f;
+        bool shouldDetonate = contactDetonation || (expired && isExplosive);
+
+        // Direct hit: the physics step reported this projectile touching an
+        // opponent's torso or head
+        int directHit = -1;
+        for (const auto& hit : m_projectileHits) {
+            if (hit.slot == slot) { directHit = hit.player; break; }
+        }
+
+        if (directHit >= 0 && !isExplosive) {
+            StickFigure& player = *m_players[directHit];
+            float kbDir = (player.getPosition().x > pp.x) ? 1.0f : -1.0f;
+            m_effectEvents.push_back({EffectEventType::Hit, pp.x, pp.y, kbDir, proj.weapon});
+            applyProjectileDamage(player, proj, pp, 1.0f);
+
+            // Carve terrain at impact point
+            float envR = proj.weapon->envDamageRadius;
+            if (envR <= 0.0f) envR = proj.weapon->damage * 0.02f;
+            carveTerrain(pp.x, pp.y, envR);
+            proj.alive = false;
+            continue;
+        }
+        if (directHit >= 0) shouldDetonate = true;
+
+        if (expired && !isExplosive) {
+            // Small carve where bullet lands
+            float envR = proj.weapon->envDamageRadius;
+            if (envR <= 0.0f) envR = proj.weapon->damage * 0.015f;
+            carveTerrain(pp.x, pp.y, envR);
+            proj.alive = false;
+            continue;
+        }
+
+        // Detonate explosive (contact, timer, or direct hit)
+        if (isExplosive && shouldDetonate) {
+            // Damage all players in blast radius. Only players the broadphase
+            // reports near the blast get the exact distance test.
+            uint32_t inBlast = playersNear(pp, hitR);
+            for (auto& player : m_players) {
+                if (!(inBlast & (1u << player->getPlayerIndex()))) continue;
+                if (player->getPlayerIndex() == proj.ownerIndex) continue;
+                if (!player->isAlive()) continue;
+                b2Vec2 plp = player->getPosition();
+                float dx = pp.x - plp.x, dy = pp.y - plp.y;
+                float dist = std::sqrt(dx * dx + dy * dy);
+                if (dist < hitR) {
+                    float falloff = 1.0f - (dist / hitR);
+                    applyProjectileDamage(*player, proj, pp, std::max(0.3f, falloff));
+                }
+            }
+
+            // Carve terrain — nuke uses full explosion radius, regular explosives a bit less
+            if (proj.weapon->destroysPlatforms) {
+                carveTerrain(pp.x, pp.y, proj.weapon->explosionRadius);
+            } else {
+                carveTerrain(pp.x, pp.y, proj.weapon->explosionRadius * 0.6f);
+            }
+
+            // Spawn visual explosion effect
+            ExplosionEffect fx;
+            fx.x = pp.x;
+            fx.y = pp.y;
+            fx.radius = proj.weapon->explosionRadius;
+            fx.timer = 0.0f;
+            fx.isNuke = proj.weapon->destroysPlatforms;
+            fx.duration = fx.isNuke ? 2.5f : 0.8f;
+            fx.alive = true;
+            m_explosions.push_back(fx);
+            m_effectEvents.push_back({EffectEventType::Explosion, fx.x, fx.y, 1.0f, proj.weapon});
+            PROFILE_MARK(TraceMarker::Explosion, fx.x, fx.y, fx.radius);
+
+            proj.alive = false;
+        }
+    }
+
+    m_projectileHits.clear();
+
+    // Deferred release: dead bullets go back to the pool disabled
+    m_projectiles.releaseDead();
+
+    // Update explosion effects
+    for (auto& fx : m_explosions) {
+        fx.timer += dt;
+        if (fx.timer >= fx.duration) fx.alive = false;
+    }
+    m_explosions.erase(
+        std::remove_if(m_explosions.begin(), m_explosions.end(),
+                        [](const ExplosionEffect& e) { return !e.alive; }),
+        m_explosions.end());
+}
+
+// Begin-touch events between a live projectile and a living opponent. Box2D
+// reports them in a deterministic order, so the first touch per projectile
+// is the same on every peer.
+void Match::collectProjectileHits() {
+    m_projectileHits.clear();
+    for (int i = 0; i < m_contacts.size(); i++) {
+        const CollisionEvent& evt = m_contacts[i];
+        if (evt.type != CollisionEventType::Begin) continue;
+
+        BodyTag proj = evt.a, target = evt.b;
+        if (proj.kind != BodyKind::Projectile) std::swap(proj, target);
+        if (proj.kind != BodyKind::Projectile || target.kind != BodyKind::Player) continue;
+        if (proj.index >= m_projectiles.getCapacity() || target.index >= static_cast<int>(m_players.size()))
+            continue;
+
+        const Projectile& p = m_projectiles[proj.index];
+        if (!p.alive || p.ownerIndex == target.index || !m_players[target.index]->isAlive()) continue;
+
+        bool seen = false;
+        for (const auto& hit : m_projectileHits) seen = seen || hit.slot == proj.index;
+        if (!seen) m_projectileHits.push_back({proj.index, target.index});
+    }
+}
+
+// Poison darts always do their flat tick; everything else scales with
+// `scale` (1 for direct hits, blast falloff for explosions)
+void Match::applyProjectileDamage(StickFigure& player, const Projectile& proj, b2Vec2 from, float scale) {
+    if (proj.isPoison) {
+        player.takeDamage(5.0f, 0.0f, 0.0f);
+        player.applyPoison(proj.poisonDps, proj.poisonDuration);
+        return;
+    }
+    float kbDir = (player.getPosition().x > from.x) ? 1.0f : -1.0f;
+    float dmg = proj.weapon->damage * m_rules.damageMultiplier * scale;
+    float kbX = proj.weapon->knockbackForce * kbDir * m_rules.knockbackMultiplier;
+    float kbY = proj.weapon->knockbackForce * 0.5f * m_rules.knockbackMultiplier;
+    player.takeDamage(dmg, kbX, kbY);
+}
+
+void Match::carveTerrain(float x, float y, float radius) {
+    PROFILE_SCOPE(ProfileZone::Carve);
+    m_arena.carveCircle(m_physics, x, y, radius);
+    m_carveEvents.push_back({x, y, radius});
+    PROFILE_MARK(TraceMarker::Carve, x, y, radius);
+}
+
+void Match::updateWeaponSpawns(float dt) {
+    const auto& rules = m_rules;
+    m_weaponSpawnTimer -= dt;
+    if (m_weaponSpawnTimer <= 0.0f && static_cast<int>(m_pickups.size()) < rules.weaponSpawnMax) {
+        // Innate character weapons are never offered as pickups
+        const WeaponData* weapon = m_weapons.getRandomPickupWeapon(m_rng);
+        if (!weapon) return;
+
+        WeaponPickup pickup;
+        pickup.position = m_arena.getRandomPlatformTop(m_rng);
+        pickup.weapon = weapon;
+        pickup.alive = true;
+        pickup.bobTimer = 0.0f;
+        m_pickups.push_back(pickup);
+        m_weaponSpawnTimer = rules.weaponSpawnInterval;
+    }
+}
+
+void Match::updateWeaponPickups(float dt) {
+    for (auto& pickup : m_pickups) {
+        if (!pickup.alive) continue;
+        pickup.bobTimer += dt;
+
+        for (auto& player : m_players) {
+            if (!player->isAlive()) continue;
+            b2Vec2 pp = player->getPosition();
+            float dx = pp.x - pickup.position.x;
+            float dy = pp.y - pickup.position.y;
+            float dist = std::sqrt(dx * dx + dy * dy);
+
+            if (dist < 1.5f) {
+                player->equipWeapon(*pickup.weapon);
+                pickup.alive = false;
+                m_effectEvents.push_back({EffectEventType::Pickup, pickup.position.x, pickup.position.y,
+                                          1.0f, pickup.weapon});
+                std::cout << "Player " << player->getPlayerIndex()
+                          << " picked up " << pickup.weapon->name << "!\n";
+                break;
+            }
+        }
+    }
+
+    m_pickups.erase(
+        std::remove_if(m_pickups.begin(), m_pickups.end(),
+                        [](const WeaponPickup& p) { return !p.alive; }),
+        m_pickups.end());
+}
+
+// Players with any body part whose broadphase AABB touches the circle's
+// bounding box (bit = player index). A superset of the players within
+// `radius` of their torso, so callers keep their exact distance check.
+uint32_t Match::playersNear(b2Vec2 center, float radius) const {
+    b2AABB box = {{center.x - radius, center.y - radius}, {center.x + radius, center.y + radius}};
+    return m_physics.overlapTags(box, CAT_PLAYER, BodyKind::Player);
+}
+
+void Match::checkFallDeath() {
+    const auto& rules = m_rules;
+    const auto& spawns = m_arena.getSpawnPoints();
+
+    // World bounds in meters (screen edges + margin)
+    float worldHalfW = SCREEN_WIDTH / PPM / 2.0f + 2.0f;  // ~23m
+    float worldTop   = SCREEN_HEIGHT / PPM / 2.0f + 2.0f;  // ~14m
+    float worldBot   = rules.fallDeathY;                     // -20m
+
+    for (auto& player : m_players) {
+        if (!player->isAlive() || player->isWaitingToRespawn()) continue;
+        b2Vec2 pos = player->getPosition();
+
+        if (m_wrapAround) {
+            // Vertical wrap: fell below bottom → appear at top
+            if (pos.y < worldBot) {
+                player->teleportTo(pos.x, worldTop);
+            }
+            // Horizontal wrap: off left/right → appear on opposite side
+            if (pos.x < -worldHalfW) {
+                player->teleportTo(worldHalfW - 1.0f, pos.y);
+            } else if (pos.x > worldHalfW) {
+                player->teleportTo(-worldHalfW + 1.0f, pos.y);
+            }
+        } else {
+            // Normal mode: fall = death
+            if (pos.y < worldBot) {
+                player->takeDamage(9999.0f, 0.0f, 0.0f);
+                int lives = player->getLives() - 1;
+                player->setLives(lives);
+                if (lives > 0) {
+                    size_t idx = static_cast<size_t>(player->getPlayerIndex());
+                    player->startRespawnTimer(rules.respawnDelay, spawns[idx].x, spawns[idx].y);
+                }
+            }
+        }
+    }
+}
+
+void Match::checkRoundEnd() {
+    int alive = 0; int last = -1;
+    for (const auto& p : m_players) {
+        if (p->isAlive() && p->getLives() > 0) { alive++; last = p->getPlayerIndex(); }
+    }
+    if (alive <= 1) {
+        m_roundOver = true;
+        m_winner = last;
+        if (last >= 0) std::cout << "Player " << last << " wins!\n";
+        else std::cout << "Draw!\n";
+    }
+}
@@ -0,0 +1,190 @@
+#pragma once
+#include "Physics.h"
+#include "Arena.h"
+#include "StickFigure.h"
+#include "PlayerInput.h"
+#include "WeaponFactory.h"
+#include "RulesEngine.h"
+#include "ProjectilePool.h"
+#include "ContactListener.h"
+#include "Rng.h"
+#include <vector>
+#include <memory>
+#include <array>
+#include <type_traits>
+
+// Fixed simulation step shared by the windowed game and the headless simulator
+constexpr float FIXED_DT = 1.0f / 60.0f;
+
+struct WeaponPickup {
+    b2Vec2 position;
+    const WeaponData* weapon = nullptr;  // interned in WeaponFactory
+    float bobTimer = 0.0f;
+    bool alive = true;
+};
+static_assert(std::is_trivially_copyable_v<WeaponPickup>, "WeaponPickup must stay trivially copyable");
+
+struct ExplosionEffect {
+    float x, y;              // world position
+    float radius;            // blast radius in meters
+    float timer = 0.0f;      // time since detonation
+    float duration = 1.5f;   // how long the effect lasts
+    bool isNuke = false;     // nuke gets special visuals
+    bool alive = true;
+};
+
+// A circle removed from the arena during a tick, in world meters
+struct CarveEvent {
+    float x, y;
+    float radius;
+};
+
+// Something worth a cosmetic effect that happened during a tick. Windowed
+// builds turn these into particles; the simulation never reads them back.
+enum class EffectEventType : uint8_t {
+    Hit,        // a player took a melee or projectile hit
+    Explosion,  // an explosive detonated
+    Pickup      // a player picked up a weapon
+};
+
+struct EffectEvent {
+    EffectEventType   type;
+    float             x, y;      // world position
+    float             dirX;      // +1 / -1: which way the blow or swing went
+    const WeaponData* weapon;    // interned in WeaponFactory
+};
+
+// One entry per joined player, in player-index order
+struct PlayerSetup {
+    CharacterType type = CharacterType::Stick;
+    sf::Color     color = sf::Color::White;
+};
+
+using PlayerInputs = std::array<PlayerInput, MAX_PLAYERS>;
+
+// A single round of gameplay: the Box2D world, the arena, the players and
+// everything in flight. Has no window, renderer or keyboard dependency, so it
+// is ticked by Game in the windowed build and by StickBrawlSim headless.
+//
+// Deterministic: given the same seed, rules, weapons and per-tick inputs,
+// update() produces bit-identical state on the same build. All randomness
+// comes from m_rng; nothing reads clocks or global random state. Every
+// CHECKPOINT_INTERVAL ticks the Box2D world is rebuilt out of the match
+// state, so a match restored from a checkpoint tick continues exactly as the
+// original did.
+class Match {
+public:
+    // Ticks between world rebuilds (see rebuildWorld)
+    static constexpr uint32_t CHECKPOINT_INTERVAL = 10;
+    static bool isCheckpoint(uint32_t tick) { return tick % CHECKPOINT_INTERVAL == 0; }
+
+    Match(const GameRules& rules, const WeaponFactory& weapons);
+    Match(const Match&) = delete;
+    Match& operator=(const Match&) = delete;
+
+    void start(int levelIndex, const std::vector<PlayerSetup>& players, bool wrapAround, uint64_t seed);
+    void restartRound();
+
+    // Starts the RNG over from `seed`, as start() would have. Only meaningful
+    // before the first update, e.g. on a restored round start.
+    void reseed(uint64_t seed);
+    void update(float dt, const PlayerInputs& inputs);
+
+    bool  isRoundOver() const { return m_roundOver; }
+    int   getWinner() const { return m_winner; }  // -1 = draw / undecided
+    float getRoundTimer() const { return m_roundTimer; }
+    bool  isWrapAround() const { return m_wrapAround; }
+    uint32_t getTick() const { return m_tick; }  // updates simulated since start()
+    uint64_t getSeed() const { return m_seed; }
+    const Rng& getRng() const { return m_rng; }
+
+    const Arena& getArena() const { return m_arena; }
+    const GameRules& getRules() const { return m_rules; }
+    const std::vector<std::unique_ptr<StickFigure>>& getPlayers() const { return m_players; }
+    const ProjectilePool& getProjectiles() const { return m_projectiles; }
+    const std::vector<WeaponPickup>& getPickups() const { return m_pickups; }
+    const std::vector<ExplosionEffect>& getExplosions() const { return m_explosions; }
+
+    // Contacts that began/ended during the latest physics step. Projectile
+    // hits on players are taken from these.
+    const ContactListener& getContacts() const { return m_contacts; }
+
+    // Terrain carves made during the latest update(), in order. Replaying them
+    // through Arena::carveCircle reproduces the server's terrain on a client.
+    const std::vector<CarveEvent>& getCarveEvents() const { return m_carveEvents; }
+
+    // Hits, detonations and pickups from the latest update(), in order
+    const std::vector<EffectEvent>& getEffectEvents() const { return m_effectEvents; }
+
+    // Whole-match state as a flat blob (replay keyframes, snapshots). `out` is
+    // cleared first but keeps its capacity. loadState needs a match started
+    // with the same level, players and rules; it returns false, with the
+    // match unchanged, on a mismatch or a truncated/corrupt blob. Loading
+    // rebuilds the physics world from the blob, the same way a checkpoint
+    // tick does (see rebuildWorld): a blob saved on a checkpoint tick steps
+    // bit-identically with a match that never rewound. Blobs from other
+    // ticks load fine but may drift.
+    void saveState(std::vector<uint8_t>& out) const;
+    bool loadState(const uint8_t* data, size_t size);
+
+    // One projectile of `weapon` owned by `ownerIndex`, or nullptr when the
+    // pool is full. Player attacks go through this; StickBrawlBench uses it
+    // and updateProjectiles directly to time the projectile pass on its own
+    // (without a step in between, so no direct hits are reported there).
+    Projectile* fireProjectile(const WeaponData& weapon, int ownerIndex, b2Vec2 pos, b2Vec2 vel,
+                               float radius, float mass);
+    void updateProjectiles(float dt);
+
+private:
+    void rebuildWorld();
+    bool applyState(const uint8_t* data, size_t size);
+    void handlePlayerInput(const PlayerInputs& inputs);
+    void handleMeleeAttack(StickFigure& attacker);
+    void spawnProjectile(StickFigure& shooter);
+    uint32_t playersNear(b2Vec2 center, float radius) const;
+    void collectProjectileHits();
+    void applyProjectileDamage(StickFigure& player, const Projectile& proj, b2Vec2 from, float scale);
+    void checkFallDeath();
+    void updateWeaponSpawns(float dt);
+    void updateWeaponPickups(float dt);
+    void checkRoundEnd();
+    void carveTerrain(float x, float y, float radius);
+
+    GameRules            m_rules;
+    const WeaponFactory& m_weapons;
+
+    Physics m_physics;
+    Arena   m_arena;
+    ContactListener m_contacts;
+
+    // Live projectiles that touched an opponent during the latest step, one
+    // entry per projectile (its first touch). Filled from m_contacts and
+    // consumed by updateProjectiles.
+    struct ProjectileHit {
+        int slot;
+        int player;
+    };
+    std::vector<ProjectileHit> m_projectileHits;
+
+    std::vector<std::unique_ptr<StickFigure>> m_players;
+    ProjectilePool m_projectiles;
+    std::vector<WeaponPickup> m_pickups;
+    std::vector<ExplosionEffect> m_explosions;
+    std::vector<CarveEvent> m_carveEvents;
+    std::vector<EffectEvent> m_effectEvents;
+
+    // Blob buffers for rebuildWorld and loadState's fallback
+    std::vector<uint8_t> m_rebuildScratch;
+    std::vector<uint8_t> m_loadBackup;
+
+    Rng      m_rng;
+    uint64_t m_seed = 0;
+
+    uint32_t m_tick = 0;
+    float m_roundTimer = 0.0f;
+    float m_weaponSpawnTimer = 0.0f;
+    bool  m_wrapAround = false;
+    bool  m_roundOver = false;
+    int   m_winner = -1;
+    bool  m_worldFresh = false;  // world built by applyState and not stepped since
+};
@@ -0,0 +1,126 @@
+#include "ParticleSystem.h"
+#include "Physics.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define STICKBRAWL_PARTICLES_SSE 1
+#endif
+
+ParticleSystem::ParticleSystem() : m_rng(0x5EED) {
+    for (auto* v : {&m_x, &m_y, &m_vx, &m_vy, &m_age, &m_ageRate, &m_gravity, &m_drag, &m_size})
+        v->resize(CAPACITY);
+    m_color.resize(CAPACITY);
+    m_colorEnd.resize(CAPACITY);
+    m_vertices.reserve(static_cast<size_t>(CAPACITY) * 6);
+}
+
+void ParticleSystem::emit(const ParticleEmitter& emitter, float x, float y, float facing, float countScale) {
+    int count = static_cast<int>(static_cast<float>(emitter.count) * countScale + m_rng.uniform01());
+    count = std::min(count, CAPACITY - m_count);
+    if (count <= 0) return;
+
+    constexpr float DEG = 3.14159265f / 180.0f;
+    float baseDeg = facing < 0.0f ? 180.0f - emitter.directionDegrees : emitter.directionDegrees;
+    float halfSpread = emitter.spreadDegrees * 0.5f;
+
+    for (int n = 0; n < count; n++) {
+        int i = m_count++;
+        float angle = (baseDeg + m_rng.uniform(-halfSpread, halfSpread)) * DEG;
+        float speed = emitter.speed * (1.0f + m_rng.uniform(-emitter.speedJitter, emitter.speedJitter));
+        float life = emitter.lifetime * (1.0f + m_rng.uniform(-emitter.lifetimeJitter, emitter.lifetimeJitter));
+
+        m_x[i] = x;
+        m_y[i] = y;
+        m_vx[i] = std::cos(angle) * speed;
+        m_vy[i] = std::sin(angle) * speed;
+        m_age[i] = 0.0f;
+        m_ageRate[i] = 1.0f / std::max(life, 0.01f);
+        m_gravity[i] = emitter.gravity;
+        m_drag[i] = emitter.drag;
+        m_size[i] = emitter.size;
+        m_color[i] = emitter.color;
+        m_colorEnd[i] = emitter.colorEnd;
+    }
+}
+
+void ParticleSystem::update(float dt) {
+    integrate(dt);
+
+    // Swap-remove the expired; the survivor pulled in is checked next
+    for (int i = 0; i < m_count;) {
+        if (m_age[i] >= 1.0f) kill(i);
+        else i++;
+    }
+}
+
+// v += (g - v * drag) * dt on each axis (gravity on y only), then x += v * dt
+void ParticleSystem::integrate(float dt) {
+    const int end = m_count;
+    int i = 0;
+#ifdef STICKBRAWL_PARTICLES_SSE
+    const __m128 vdt = _mm_set1_ps(dt);
+    for (; i + 4 <= end; i += 4) {
+        __m128 vx = _mm_loadu_ps(&m_vx[i]);
+        __m128 vy = _mm_loadu_ps(&m_vy[i]);
+        __m128 dragDt = _mm_mul_ps(_mm_loadu_ps(&m_drag[i]), vdt);
+        vx = _mm_sub_ps(vx, _mm_mul_ps(vx, dragDt));
+        vy = _mm_add_ps(_mm_sub_ps(vy, _mm_mul_ps(vy, dragDt)), _mm_mul_ps(_mm_loadu_ps(&m_gravity[i]), vdt));
+        _mm_storeu_ps(&m_vx[i], vx);
+        _mm_storeu_ps(&m_vy[i], vy);
+        _mm_storeu_ps(&m_x[i], _mm_add_ps(_mm_loadu_ps(&m_x[i]), _mm_mul_ps(vx, vdt)));
+        _mm_storeu_ps(&m_y[i], _mm_add_ps(_mm_loadu_ps(&m_y[i]), _mm_mul_ps(vy, vdt)));
+        _mm_storeu_ps(&m_age[i], _mm_add_ps(_mm_loadu_ps(&m_age[i]), _mm_mul_ps(_mm_loadu_ps(&m_ageRate[i]), vdt)));
+    }
+#endif
+    for (; i < end; i++) {
+        float dragDt = m_drag[i] * dt;
+        m_vx[i] -= m_vx[i] * dragDt;
+        m_vy[i] += m_gravity[i] * dt - m_vy[i] * dragDt;
+        m_x[i] += m_vx[i] * dt;
+        m_y[i] += m_vy[i] * dt;
+        m_age[i] += m_ageRate[i] * dt;
+    }
+}
+
+void ParticleSystem::kill(int index) {
+    int last = --m_count;
+    if (index == last) return;
+    m_x[index] = m_x[last];
+    m_y[index] = m_y[last];
+    m_vx[index] = m_vx[last];
+    m_vy[index] = m_vy[last];
+    m_age[index] = m_age[last];
+    m_ageRate[index] = m_ageRate[last];
+    m_gravity[index] = m_gravity[last];
+    m_drag[index] = m_drag[last];
+    m_size[index] = m_size[last];
+    m_color[index] = m_color[last];
+    m_colorEnd[index] = m_colorEnd[last];
+}
+
+void ParticleSystem::draw(sf::RenderTarget& target) {
+    if (m_count == 0) return;
+
+    m_vertices.resize(static_cast<size_t>(m_count) * 6);
+    sf::Vertex* v = m_vertices.data();
+    for (int i = 0; i < m_count; i++, v += 6) {
+        float t = m_age[i];
+        auto mix = [t](uint8_t a, uint8_t b) {
+            return static_cast<uint8_t>(static_cast<float>(a) + (static_cast<float>(b) - static_cast<float>(a)) * t);
+        };
+        const sf::Color& c0 = m_color[i];
+        const sf::Color& c1 = m_colorEnd[i];
+        sf::Color color(mix(c0.r, c1.r), mix(c0.g, c1.g), mix(c0.b, c1.b), mix(c0.a, c1.a));
+
+        float sx = SCREEN_CX + m_x[i] * PPM;
+        float sy = SCREEN_CY - m_y[i] * PPM;
+        float s = m_size[i];
+        sf::Vector2f tl = {sx - s, sy - s}, tr = {sx + s, sy - s};
+        sf::Vector2f bl = {sx - s, sy + s}, br = {sx + s, sy + s};
+        v[0] = {tl, color}; v[1] = {tr, color}; v[2] = {bl, color};
+        v[3] = {bl, color}; v[4] = {tr, color}; v[5] = {br, color};
+    }
+    target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles);
+}
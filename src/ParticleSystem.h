@@ -0,0 +1,43 @@
+#pragma once
+#include "Weapon.h"
+#include "Rng.h"
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Cosmetic particles: explosion debris, hit sparks, carve dust, swing trails.
+// Storage is structure-of-arrays with a fixed capacity, so the integration
+// step streams through flat float arrays four particles at a time (SSE where
+// available) and dead particles are swap-removed to keep the live range
+// packed. Simulated in world meters; draw() emits one quad per particle in a
+// single call. Has its own random stream so effects never disturb a match.
+class ParticleSystem {
+public:
+    static constexpr int CAPACITY = 8192;
+
+    ParticleSystem();
+
+    void clear() { m_count = 0; }
+    int  getCount() const { return m_count; }
+
+    // `facing` < 0 mirrors the emitter's direction; `countScale` scales its
+    // particle count (e.g. by blast radius). Bursts past CAPACITY are cut short.
+    void emit(const ParticleEmitter& emitter, float x, float y, float facing = 1.0f, float countScale = 1.0f);
+
+    void update(float dt);
+    void draw(sf::RenderTarget& target);
+
+private:
+    void integrate(float dt);
+    void kill(int index);
+
+    // One entry per live particle, [0, m_count)
+    std::vector<float> m_x, m_y, m_vx, m_vy;
+    std::vector<float> m_age;        // 0..1 of the particle's lifetime
+    std::vector<float> m_ageRate;    // 1 / lifetime
+    std::vector<float> m_gravity, m_drag, m_size;
+    std::vector<sf::Color> m_color, m_colorEnd;
+    int m_count = 0;
+
+    Rng m_rng;
+    std::vector<sf::Vertex> m_vertices;
+};
@@ -1,36 +1,86 @@
 #include "Physics.h"
 
 Physics::Physics() {
-    b2WorldDef worldDef = b2DefaultWorldDef();
-    worldDef.gravity = {0.0f, -20.0f};
-    m_worldId = b2CreateWorld(&worldDef);
+    m_worldId = createWorld();
 }
 
 Physics::~Physics() {
     b2DestroyWorld(m_worldId);
 }
 
+b2WorldId Physics::createWorld() const {
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity = m_gravity;
+    return b2CreateWorld(&worldDef);
+}
+
+void Physics::reset() {
+    b2DestroyWorld(m_worldId);
+    m_worldId = createWorld();
+}
+
 void Physics::setGravity(float gx, float gy) {
-    b2World_SetGravity(m_worldId, {gx, gy});
+    m_gravity = {gx, gy};
+    b2World_SetGravity(m_worldId, m_gravity);
 }
 
 void Physics::step(float dt) {
     b2World_Step(m_worldId, dt, m_subStepCount);
 }
 
+void Physics::tagBody(b2BodyId bodyId, BodyKind kind, int index) {
+    void* tag = packBodyTag(kind, index);
+    b2Body_SetUserData(bodyId, tag);
+
+    b2ShapeId shapes[4];
+    int count = b2Body_GetShapes(bodyId, shapes, 4);
+    for (int i = 0; i < count; i++) b2Shape_SetUserData(shapes[i], tag);
+}
+
+namespace {
+struct OverlapTagContext {
+    BodyKind kind;
+    uint32_t mask;
+};
+
+bool collectOverlapTag(b2ShapeId shapeId, void* context) {
+    auto* ctx = static_cast<OverlapTagContext*>(context);
+    BodyTag tag = unpackBodyTag(b2Shape_GetUserData(shapeId));
+    if (tag.kind == ctx->kind && tag.index >= 0 && tag.index < 32)
+        ctx->mask |= 1u << tag.index;
+    return true;  // keep going
+}
+} // namespace
+
+uint32_t Physics::overlapTags(b2AABB box, uint64_t maskBits, BodyKind kind) const {
+    b2QueryFilter filter = b2DefaultQueryFilter();
+    filter.maskBits = maskBits;
+    OverlapTagContext ctx{kind, 0};
+    b2World_OverlapAABB(m_worldId, box, filter, collectOverlapTag, &ctx);
+    return ctx.mask;
+}
+
 b2BodyId Physics::createStaticBox(float cx, float cy, float halfW, float halfH, uint64_t categoryBits) {
+    b2BodyId bodyId = createStaticBody(cx, cy);
+    addStaticBoxShape(bodyId, 0.0f, 0.0f, halfW, halfH, categoryBits);
+    return bodyId;
+}
+
+b2BodyId Physics::createStaticBody(float x, float y) {
     b2BodyDef bodyDef = b2DefaultBodyDef();
     bodyDef.type = b2_staticBody;
-    bodyDef.position = {cx, cy};
-    b2BodyId bodyId = b2CreateBody(m_worldId, &bodyDef);
+    bodyDef.position = {x, y};
+    return b2CreateBody(m_worldId, &bodyDef);
+}
 
-    b2Polygon box = b2MakeBox(halfW, halfH);
+b2ShapeId Physics::addStaticBoxShape(b2BodyId bodyId, float cx, float cy, float halfW, float halfH,
+                                     uint64_t categoryBits) {
+    b2Polygon box = (cx == 0.0f && cy == 0.0f) ? b2MakeBox(halfW, halfH)
+                                               : b2MakeOffsetBox(halfW, halfH, {cx, cy}, b2Rot_identity);
     b2ShapeDef shapeDef = b2DefaultShapeDef();
     shapeDef.material.friction = 0.6f;
     shapeDef.filter.categoryBits = categoryBits;
-    b2CreatePolygonShape(bodyId, &shapeDef, &box);
-
-    return bodyId;
+    return b2CreatePolygonShape(bodyId, &shapeDef, &box);
 }
 
 b2BodyId Physics::createDynamicCircle(float cx, float cy, float radius, float density,
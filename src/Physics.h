@@ -1,5 +1,6 @@
 #pragma once
 #include <box2d/box2d.h>
+#include <cstdint>
 
 // Pixels-to-meters conversion
 constexpr float PPM = 30.0f;
@@ -20,6 +21,33 @@ enum CollisionCategory : uint64_t {
     CAT_PICKUP     = 0x0008,
 };
 
+// What a body belongs to. Packed into the user data of the body and its
+// shapes, so query hits and contact events map straight back to gameplay
+// state without a lookup table.
+enum class BodyKind : uint8_t {
+    None,
+    Player,      // index = player index
+    Projectile,  // index = ProjectilePool slot
+};
+
+struct BodyTag {
+    BodyKind kind = BodyKind::None;
+    int      index = -1;
+};
+
+inline void* packBodyTag(BodyKind kind, int index) {
+    uintptr_t bits = (static_cast<uintptr_t>(kind) << 24) | (static_cast<uintptr_t>(index) & 0xFFFFFF);
+    return reinterpret_cast<void*>(bits);
+}
+
+inline BodyTag unpackBodyTag(const void* data) {
+    uintptr_t bits = reinterpret_cast<uintptr_t>(data);
+    BodyTag tag;
+    tag.kind = static_cast<BodyKind>((bits >> 24) & 0xFF);
+    tag.index = (tag.kind == BodyKind::None) ? -1 : static_cast<int>(bits & 0xFFFFFF);
+    return tag;
+}
+
 class Physics {
 public:
     Physics();
@@ -28,18 +56,40 @@ public:
     void setGravity(float gx, float gy);
     void step(float dt);
 
+    // Destroys the world and creates an empty one with the same settings.
+    // Every body, shape, chain and joint id handed out before is invalid
+    // afterwards; callers recreate what they need (see Match::rebuildWorld).
+    void reset();
+
     b2WorldId getWorldId() const { return m_worldId; }
 
     // Helper to create a static platform box (center x/y, half-extents)
     b2BodyId createStaticBox(float cx, float cy, float halfW, float halfH, uint64_t categoryBits = CAT_PLATFORM);
 
+    // Shapeless static body; platform boxes are then added to it as shapes
+    b2BodyId createStaticBody(float x, float y);
+    // Platform box on an existing static body (center in the body's frame)
+    b2ShapeId addStaticBoxShape(b2BodyId bodyId, float cx, float cy, float halfW, float halfH,
+                                uint64_t categoryBits = CAT_PLATFORM);
+
     // Helper to create dynamic bodies
     b2BodyId createDynamicCircle(float cx, float cy, float radius, float density = 1.0f,
                                   uint64_t categoryBits = CAT_PLAYER, uint64_t maskBits = 0xFFFFFFFF);
     b2BodyId createDynamicBox(float cx, float cy, float halfW, float halfH, float density = 1.0f,
                                uint64_t categoryBits = CAT_PLAYER, uint64_t maskBits = 0xFFFFFFFF);
 
+    // Stores the tag on the body and on every shape attached to it
+    void tagBody(b2BodyId bodyId, BodyKind kind, int index);
+
+    // Broadphase query: bit i is set when a shape tagged (kind, i) whose
+    // category is in maskBits has a fat AABB overlapping the box. Candidates
+    // only; callers still do their exact distance test. Indices >= 32 are skipped.
+    uint32_t overlapTags(b2AABB box, uint64_t maskBits, BodyKind kind) const;
+
 private:
+    b2WorldId createWorld() const;
+
     b2WorldId m_worldId;
+    b2Vec2 m_gravity = {0.0f, -20.0f};
     int m_subStepCount = 4;
 };
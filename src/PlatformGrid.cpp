@@ -0,0 +1,72 @@
+#include "PlatformGrid.h"
+#include <algorithm>
+#include <cmath>
+
+void PlatformGrid::reset(float minX, float minY, float maxX, float maxY, float cellSize) {
+    m_minX = minX;
+    m_minY = minY;
+    m_invCellSize = 1.0f / cellSize;
+    m_cols = std::max(1, static_cast<int>(std::ceil((maxX - minX) * m_invCellSize)));
+    m_rows = std::max(1, static_cast<int>(std::ceil((maxY - minY) * m_invCellSize)));
+    m_cells.assign(static_cast<size_t>(m_cols) * m_rows, {});
+    m_stamps.clear();
+    m_queryStamp = 0;
+}
+
+void PlatformGrid::clear() {
+    for (auto& cell : m_cells) cell.clear();
+    m_stamps.clear();
+    m_queryStamp = 0;
+}
+
+PlatformGrid::CellRange PlatformGrid::cellRange(float left, float bottom, float right, float top) const {
+    auto toCol = [&](float x) {
+        return std::clamp(static_cast<int>(std::floor((x - m_minX) * m_invCellSize)), 0, m_cols - 1);
+    };
+    auto toRow = [&](float y) {
+        return std::clamp(static_cast<int>(std::floor((y - m_minY) * m_invCellSize)), 0, m_rows - 1);
+    };
+    return {toCol(left), toRow(bottom), toCol(right), toRow(top)};
+}
+
+void PlatformGrid::insert(int id, float left, float bottom, float right, float top) {
+    CellRange r = cellRange(left, bottom, right, top);
+    for (int y = r.y0; y <= r.y1; y++)
+        for (int x = r.x0; x <= r.x1; x++)
+            m_cells[static_cast<size_t>(y) * m_cols + x].push_back(id);
+
+    if (id >= static_cast<int>(m_stamps.size())) m_stamps.resize(static_cast<size_t>(id) + 1, 0);
+}
+
+void PlatformGrid::remove(int id, float left, float bottom, float right, float top) {
+    CellRange r = cellRange(left, bottom, right, top);
+    for (int y = r.y0; y <= r.y1; y++) {
+        for (int x = r.x0; x <= r.x1; x++) {
+            auto& cell = m_cells[static_cast<size_t>(y) * m_cols + x];
+            auto it = std::find(cell.begin(), cell.end(), id);
+            if (it != cell.end()) {
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+}
+
+void PlatformGrid::query(float left, float bottom, float right, float top, std::vector<int>& out) const {
+    if (++m_queryStamp == 0) {
+        // Stamp counter wrapped — invalidate all old marks
+        std::fill(m_stamps.begin(), m_stamps.end(), 0);
+        m_queryStamp = 1;
+    }
+
+    CellRange r = cellRange(left, bottom, right, top);
+    for (int y = r.y0; y <= r.y1; y++) {
+        for (int x = r.x0; x <= r.x1; x++) {
+            for (int id : m_cells[static_cast<size_t>(y) * m_cols + x]) {
+                if (m_stamps[id] == m_queryStamp) continue;
+                m_stamps[id] = m_queryStamp;
+                out.push_back(id);
+            }
+        }
+    }
+}
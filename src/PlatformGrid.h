@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+// Uniform-grid broadphase over Arena platform slots. Each platform id is
+// registered in every cell its AABB touches, so a carve only has to look at
+// the platforms near the blast instead of the whole fragment list. Boxes
+// outside the grid bounds are clamped into the border cells.
+class PlatformGrid {
+public:
+    void reset(float minX, float minY, float maxX, float maxY, float cellSize);
+    void clear();
+
+    void insert(int id, float left, float bottom, float right, float top);
+    void remove(int id, float left, float bottom, float right, float top);
+
+    // Appends every id whose cells overlap the box, each id at most once
+    void query(float left, float bottom, float right, float top, std::vector<int>& out) const;
+
+private:
+    struct CellRange { int x0, y0, x1, y1; };
+    CellRange cellRange(float left, float bottom, float right, float top) const;
+
+    float m_minX = 0.0f;
+    float m_minY = 0.0f;
+    float m_invCellSize = 1.0f;
+    int   m_cols = 0;
+    int   m_rows = 0;
+    std::vector<std::vector<int>> m_cells;
+
+    // Per-id visit stamps used to dedupe ids spanning several cells
+    mutable std::vector<uint32_t> m_stamps;
+    mutable uint32_t m_queryStamp = 0;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+constexpr int MAX_PLAYERS = 5;
+
+// Per-tick input state for one player. Produced by Input (keyboard) in the
+// windowed game and by BotController in headless simulation runs.
+struct PlayerInput {
+    bool moveLeft = false;
+    bool moveRight = false;
+    bool jump = false;
+    bool attack = false;
+    bool aimUp = false;
+    bool aimDown = false;
+    bool jumpPressed = false;
+    bool attackPressed = false;
+};
@@ -0,0 +1,229 @@
+#include "Profiler.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+const char* profileZoneName(ProfileZone zone) {
+    switch (zone) {
+        case ProfileZone::Frame:         return "frame";
+        case ProfileZone::Tick:          return "tick";
+        case ProfileZone::WorldRebuild:  return "rebuild";
+        case ProfileZone::PlayerInput:   return "input";
+        case ProfileZone::FigureUpdate:  return "figures";
+        case ProfileZone::PhysicsStep:   return "physics";
+        case ProfileZone::Projectiles:   return "projectiles";
+        case ProfileZone::Carve:         return "carve";
+        case ProfileZone::Pickups:       return "pickups";
+        case ProfileZone::Render:        return "render";
+        case ProfileZone::ArenaDraw:     return "draw arena";
+        case ProfileZone::FigureDraw:    return "draw figures";
+        case ProfileZone::ExplosionDraw: return "draw fx";
+        case ProfileZone::Particles:     return "particles";
+        case ProfileZone::HudDraw:       return "draw hud";
+        default:                         return "?";
+    }
+}
+
+const char* traceMarkerName(TraceMarker marker) {
+    switch (marker) {
+        case TraceMarker::Carve:     return "carve";
+        case TraceMarker::Explosion: return "explosion";
+        case TraceMarker::Death:     return "death";
+        default:                     return "?";
+    }
+}
+
+#ifdef STICKBRAWL_PROFILE
+
+// ============================================================
+// LIVE SAMPLE RING
+// ============================================================
+
+void ProfileRing::push(const ProfileSample& sample) {
+    uint64_t index = m_head.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = m_slots[index & (CAPACITY - 1)];
+    slot.seq.store(2 * index + 1, std::memory_order_relaxed);  // being written
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.start.store(sample.startNs, std::memory_order_relaxed);
+    slot.packed.store(sample.durationNs | (static_cast<uint64_t>(sample.zone) << 32),
+                      std::memory_order_relaxed);
+    slot.seq.store(2 * index + 2, std::memory_order_release);
+}
+
+void ProfileRing::drain(std::vector<ProfileSample>& out) {
+    uint64_t head = m_head.load(std::memory_order_acquire);
+    if (head - m_tail > CAPACITY) {
+        m_dropped += head - CAPACITY - m_tail;
+        m_tail = head - CAPACITY;
+    }
+
+    for (; m_tail < head; m_tail++) {
+        const Slot& slot = m_slots[m_tail & (CAPACITY - 1)];
+        uint64_t expected = 2 * m_tail + 2;
+        uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq < expected) break;  // claimed but not finished; pick it up next time
+        if (seq > expected) { m_dropped++; continue; }
+
+        uint64_t start = slot.start.load(std::memory_order_relaxed);
+        uint64_t packed = slot.packed.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != expected) { m_dropped++; continue; }
+
+        out.push_back({start, static_cast<uint32_t>(packed), static_cast<ProfileZone>(packed >> 32)});
+    }
+}
+
+ProfileRing& Profiler::ring() {
+    static ProfileRing ring;
+    return ring;
+}
+
+uint64_t Profiler::nowNs() {
+    using Clock = std::chrono::steady_clock;
+    static const Clock::time_point epoch = Clock::now();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count());
+}
+
+void Profiler::setLive(bool on) {
+    if (on) s_flags.fetch_or(LIVE, std::memory_order_relaxed);
+    else    s_flags.fetch_and(~static_cast<uint32_t>(LIVE), std::memory_order_relaxed);
+}
+
+// ============================================================
+// TRACE CAPTURE
+// ============================================================
+
+namespace {
+
+struct TraceEvent {
+    uint64_t startNs;
+    uint32_t durationNs;
+    uint8_t  id;        // ProfileZone, or TraceMarker when instant
+    bool     instant;
+    float    args[3];
+};
+
+// One per thread that ever recorded. Owned by the registry rather than the
+// thread, so a pool worker that exits before writeTrace keeps its events.
+struct TraceBuffer {
+    uint32_t tid = 0;
+    std::string name;
+    std::vector<TraceEvent> events;
+    uint64_t dropped = 0;
+};
+
+// ~64 MB per thread; a long windowed session stops growing instead of swapping
+constexpr size_t MAX_EVENTS_PER_THREAD = size_t(1) << 21;
+
+std::mutex g_registryMutex;
+std::vector<std::unique_ptr<TraceBuffer>> g_buffers;
+
+TraceBuffer& localBuffer() {
+    thread_local TraceBuffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        g_buffers.push_back(std::make_unique<TraceBuffer>());
+        buffer = g_buffers.back().get();
+        buffer->tid = static_cast<uint32_t>(g_buffers.size());
+        buffer->name = "thread " + std::to_string(buffer->tid);
+        buffer->events.reserve(4096);
+    }
+    return *buffer;
+}
+
+void append(const TraceEvent& event) {
+    TraceBuffer& buffer = localBuffer();
+    if (buffer.events.size() >= MAX_EVENTS_PER_THREAD) { buffer.dropped++; return; }
+    buffer.events.push_back(event);
+}
+
+const char* markerArgName(TraceMarker marker, int arg) {
+    static const char* const NAMES[][3] = {
+        {"x", "y", "radius"},
+        {"x", "y", "radius"},
+        {"x", "y", "player"},
+    };
+    return NAMES[static_cast<int>(marker)][arg];
+}
+
+} // namespace
+
+void Profiler::beginTrace() {
+    {
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        for (auto& buffer : g_buffers) {
+            buffer->events.clear();
+            buffer->dropped = 0;
+        }
+    }
+    nowNs();  // pin the epoch before the first span
+    s_flags.fetch_or(TRACE, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const char* name) {
+    localBuffer().name = name;
+}
+
+void Profiler::recordSpan(ProfileZone zone, uint64_t startNs, uint32_t durationNs) {
+    append({startNs, durationNs, static_cast<uint8_t>(zone), false, {0.0f, 0.0f, 0.0f}});
+}
+
+void Profiler::mark(TraceMarker marker, float a, float b, float c) {
+    append({nowNs(), 0, static_cast<uint8_t>(marker), true, {a, b, c}});
+}
+
+bool Profiler::writeTrace(const std::string& path) {
+    s_flags.fetch_and(~static_cast<uint32_t>(TRACE), std::memory_order_acquire);
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        std::cerr << "[Profiler] Cannot write trace " << path << "\n";
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(g_registryMutex);
+    size_t total = 0;
+    uint64_t dropped = 0;
+    const char* sep = "\n";
+
+    // Chrome trace event format: complete events ("X") nest by time on each
+    // thread's track; timestamps are microseconds.
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", f);
+    for (const auto& buffer : g_buffers) {
+        std::fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                        "\"args\":{\"name\":\"%s\"}}", sep, buffer->tid, buffer->name.c_str());
+        sep = ",\n";
+        for (const auto& e : buffer->events) {
+            double ts = static_cast<double>(e.startNs) * 1e-3;
+            if (e.instant) {
+                auto marker = static_cast<TraceMarker>(e.id);
+                std::fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"event\",\"ph\":\"i\",\"s\":\"t\","
+                                "\"ts\":%.3f,\"pid\":1,\"tid\":%u,"
+                                "\"args\":{\"%s\":%g,\"%s\":%g,\"%s\":%g}}",
+                             traceMarkerName(marker), ts, buffer->tid,
+                             markerArgName(marker, 0), e.args[0], markerArgName(marker, 1), e.args[1],
+                             markerArgName(marker, 2), e.args[2]);
+            } else {
+                std::fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"zone\",\"ph\":\"X\","
+                                "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                             profileZoneName(static_cast<ProfileZone>(e.id)), ts,
+                             static_cast<double>(e.durationNs) * 1e-3, buffer->tid);
+            }
+        }
+        total += buffer->events.size();
+        dropped += buffer->dropped;
+    }
+    std::fputs("\n]}\n", f);
+    bool ok = std::ferror(f) == 0;
+    ok = (std::fclose(f) == 0) && ok;
+
+    std::cout << "[Profiler] Wrote " << total << " events from " << g_buffers.size()
+              << " thread(s) to " << path;
+    if (dropped > 0) std::cout << " (" << dropped << " dropped, buffer full)";
+    std::cout << "\n";
+    return ok;
+}
+
+#endif
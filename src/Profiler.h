@@ -0,0 +1,134 @@
+#pragma once
+#include <cstdint>
+
+// Phases timed by PROFILE_SCOPE. Zones nest (a carve runs inside
+// Projectiles, everything inside Frame), so each reports inclusive time.
+enum class ProfileZone : uint8_t {
+    Frame,          // one Game::run iteration
+    Tick,           // one fixed-step Match::update
+    WorldRebuild,   // Match::rebuildWorld
+    PlayerInput,
+    FigureUpdate,
+    PhysicsStep,
+    Projectiles,
+    Carve,
+    Pickups,
+    Render,
+    ArenaDraw,
+    FigureDraw,
+    ExplosionDraw,
+    Particles,      // particle update and draw
+    HudDraw,
+    Count
+};
+constexpr int PROFILE_ZONE_COUNT = static_cast<int>(ProfileZone::Count);
+
+const char* profileZoneName(ProfileZone zone);
+
+// Point events on the trace timeline, each with up to three float arguments
+enum class TraceMarker : uint8_t {
+    Carve,          // x, y, radius
+    Explosion,      // x, y, radius
+    Death,          // x, y, player index
+    Count
+};
+
+const char* traceMarkerName(TraceMarker marker);
+
+#ifdef STICKBRAWL_PROFILE
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+struct ProfileSample {
+    uint64_t    startNs;     // since the profiler's epoch
+    uint32_t    durationNs;
+    ProfileZone zone;
+};
+
+// Fixed-size sample ring shared by every thread that runs timed code. Writers
+// claim a slot with one fetch_add and publish it with a per-slot sequence
+// number, so they never block each other or the reader. When the reader falls
+// a whole ring behind, the oldest samples are overwritten and counted as
+// dropped.
+class ProfileRing {
+public:
+    static constexpr uint64_t CAPACITY = 1 << 14;
+
+    void push(const ProfileSample& sample);
+
+    // Appends every sample published since the last drain; single reader only
+    void drain(std::vector<ProfileSample>& out);
+
+    uint64_t getDropped() const { return m_dropped; }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq{0};   // 2 * index + 2 once the sample is complete
+        std::atomic<uint64_t> start{0};
+        std::atomic<uint64_t> packed{0};  // duration | zone << 32
+    };
+
+    std::array<Slot, CAPACITY> m_slots;
+    std::atomic<uint64_t> m_head{0};
+    uint64_t m_tail = 0;     // reader only
+    uint64_t m_dropped = 0;  // reader only
+};
+
+class Profiler {
+public:
+    // Collection targets; a scope costs nothing but a flag load while both are off
+    enum : uint32_t { LIVE = 1, TRACE = 2 };
+
+    static ProfileRing& ring();
+    static uint64_t nowNs();
+
+    static uint32_t flags() { return s_flags.load(std::memory_order_relaxed); }
+    static void setLive(bool on);
+
+    // Whole-run trace capture. Every thread records into its own buffer, so
+    // after a thread's first event tracing takes no locks. writeTrace stops
+    // capture and writes chrome://tracing JSON (Perfetto opens it too); call
+    // it once traced threads are idle, e.g. after the run or between frames.
+    static void beginTrace();
+    static bool writeTrace(const std::string& path);
+    static void setThreadName(const char* name);
+
+    static void recordSpan(ProfileZone zone, uint64_t startNs, uint32_t durationNs);
+    static void mark(TraceMarker marker, float a, float b, float c);
+
+private:
+    static inline std::atomic<uint32_t> s_flags{0};
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileZone zone)
+        : m_zone(zone), m_flags(Profiler::flags()), m_start(m_flags ? Profiler::nowNs() : 0) {}
+    ~ProfileScope() {
+        if (!m_flags) return;
+        uint32_t duration = static_cast<uint32_t>(Profiler::nowNs() - m_start);
+        if (m_flags & Profiler::LIVE) Profiler::ring().push({m_start, duration, m_zone});
+        if (m_flags & Profiler::TRACE) Profiler::recordSpan(m_zone, m_start, duration);
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileZone m_zone;
+    uint32_t    m_flags;
+    uint64_t    m_start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(zone) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(zone)
+#define PROFILE_MARK(marker, a, b, c) \
+    do { if (Profiler::flags() & Profiler::TRACE) Profiler::mark(marker, a, b, c); } while (0)
+#define PROFILE_THREAD_NAME(name) Profiler::setThreadName(name)
+#else
+#define PROFILE_SCOPE(zone) ((void)0)
+#define PROFILE_MARK(marker, a, b, c) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#endif
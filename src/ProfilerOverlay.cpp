@@ -0,0 +1,108 @@
+#include "ProfilerOverlay.h"
+#ifdef STICKBRAWL_PROFILE
+#include "Physics.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+constexpr int   REFRESH_FRAMES = 15;
+constexpr float PANEL_W = 360.0f;
+constexpr float GRAPH_H = 70.0f;
+constexpr float GRAPH_MAX_MS = 33.3f;   // top of the graph = two frame budgets
+constexpr float BUDGET_MS = 1000.0f / 60.0f;
+}
+
+void ProfilerOverlay::endFrame(float frameSeconds) {
+    m_samples.clear();
+    Profiler::ring().drain(m_samples);
+
+    for (auto& zone : m_zoneMs) zone[m_cursor] = 0.0f;
+    for (const auto& s : m_samples) {
+        int z = static_cast<int>(s.zone);
+        if (z < PROFILE_ZONE_COUNT) m_zoneMs[z][m_cursor] += s.durationNs * 1e-6f;
+    }
+    m_frameMs[m_cursor] = frameSeconds * 1000.0f;
+    m_cursor = (m_cursor + 1) % HISTORY;
+    m_filled = std::min(m_filled + 1, HISTORY);
+
+    if (++m_framesSinceRefresh >= REFRESH_FRAMES) {
+        m_framesSinceRefresh = 0;
+        refreshStats();
+    }
+}
+
+void ProfilerOverlay::refreshStats() {
+    auto summarize = [&](const std::array<float, HISTORY>& values) {
+        ZoneStats st;
+        if (m_filled == 0) return st;
+        m_sortScratch.assign(values.begin(), values.begin() + m_filled);
+        float sum = 0.0f;
+        for (float v : m_sortScratch) sum += v;
+        st.avgMs = sum / static_cast<float>(m_filled);
+        size_t p99 = std::min<size_t>(m_sortScratch.size() - 1, m_sortScratch.size() * 99 / 100);
+        std::nth_element(m_sortScratch.begin(), m_sortScratch.begin() + static_cast<std::ptrdiff_t>(p99),
+                         m_sortScratch.end());
+        st.p99Ms = m_sortScratch[p99];
+        return st;
+    };
+    for (int z = 0; z < PROFILE_ZONE_COUNT; z++) m_stats[z] = summarize(m_zoneMs[z]);
+    m_frameStats = summarize(m_frameMs);
+}
+
+void ProfilerOverlay::draw(sf::RenderTarget& target, const sf::Font* font) {
+    if (!m_visible) return;
+
+    const float lineH = 16.0f;
+    const float panelH = 34.0f + lineH * PROFILE_ZONE_COUNT + GRAPH_H + 16.0f;
+    const float x0 = SCREEN_CX - PANEL_W / 2.0f;
+    const float y0 = SCREEN_HEIGHT - panelH - 10.0f;
+
+    sf::RectangleShape panel({PANEL_W, panelH});
+    panel.setPosition({x0, y0});
+    panel.setFillColor(sf::Color(0, 0, 0, 190));
+    panel.setOutlineColor(sf::Color(90, 90, 100));
+    panel.setOutlineThickness(1.0f);
+    target.draw(panel);
+
+    if (font) {
+        char line[96];
+        std::snprintf(line, sizeof(line), "frame %5.2f ms avg  %5.2f p99   (%d frames)",
+                      m_frameStats.avgMs, m_frameStats.p99Ms, m_filled);
+        sf::Text header(*font, line, 13);
+        header.setPosition({x0 + 8.0f, y0 + 6.0f});
+        header.setFillColor(m_frameStats.p99Ms > BUDGET_MS ? sf::Color(255, 120, 100) : sf::Color::White);
+        target.draw(header);
+
+        for (int z = 0; z < PROFILE_ZONE_COUNT; z++) {
+            std::snprintf(line, sizeof(line), "%-13s %6.3f ms avg  %6.3f p99",
+                          profileZoneName(static_cast<ProfileZone>(z)), m_stats[z].avgMs, m_stats[z].p99Ms);
+            sf::Text row(*font, line, 12);
+            row.setPosition({x0 + 8.0f, y0 + 28.0f + lineH * static_cast<float>(z)});
+            row.setFillColor(sf::Color(200, 200, 210));
+            target.draw(row);
+        }
+    }
+
+    // Frame-time graph, oldest on the left
+    const float gx = x0 + 8.0f;
+    const float gy = y0 + panelH - GRAPH_H - 8.0f;
+    const float gw = PANEL_W - 16.0f;
+    auto yFor = [&](float ms) { return gy + GRAPH_H - std::min(ms, GRAPH_MAX_MS) / GRAPH_MAX_MS * GRAPH_H; };
+
+    sf::RectangleShape budget({gw, 1.0f});
+    budget.setPosition({gx, yFor(BUDGET_MS)});
+    budget.setFillColor(sf::Color(255, 200, 80, 140));
+    target.draw(budget);
+
+    m_graph.resize(static_cast<size_t>(m_filled));
+    int oldest = (m_cursor - m_filled + HISTORY) % HISTORY;
+    for (int i = 0; i < m_filled; i++) {
+        float ms = m_frameMs[(oldest + i) % HISTORY];
+        sf::Vertex& v = m_graph[static_cast<size_t>(i)];
+        v.position = {gx + gw * static_cast<float>(i) / static_cast<float>(HISTORY - 1), yFor(ms)};
+        v.color = ms > BUDGET_MS ? sf::Color(255, 90, 80) : sf::Color(120, 230, 140);
+    }
+    target.draw(m_graph);
+}
+
+#endif
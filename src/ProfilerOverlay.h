@@ -0,0 +1,50 @@
+#pragma once
+#ifdef STICKBRAWL_PROFILE
+#include "Profiler.h"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <vector>
+
+// F3 overlay for the profiler: per-zone rolling average and p99 over the
+// last HISTORY frames, and a frame-time graph against the 60 Hz budget.
+// Samples are drained every frame even while hidden, so the numbers are
+// warm the moment it is shown.
+class ProfilerOverlay {
+public:
+    static constexpr int HISTORY = 240;
+
+    ProfilerOverlay() { Profiler::setLive(true); }
+
+    void toggle() { m_visible = !m_visible; }
+    bool isVisible() const { return m_visible; }
+
+    // Closes the current frame: drains the sample ring into it
+    void endFrame(float frameSeconds);
+
+    void draw(sf::RenderTarget& target, const sf::Font* font);
+
+private:
+    struct ZoneStats {
+        float avgMs = 0.0f;
+        float p99Ms = 0.0f;
+    };
+    void refreshStats();
+
+    bool m_visible = false;
+    std::vector<ProfileSample> m_samples;
+
+    // Per-frame totals, ring-indexed by m_cursor
+    std::array<std::array<float, HISTORY>, PROFILE_ZONE_COUNT> m_zoneMs{};
+    std::array<float, HISTORY> m_frameMs{};
+    int m_cursor = 0;
+    int m_filled = 0;
+
+    // Recomputed a few times a second; sorting every frame is wasted work
+    std::array<ZoneStats, PROFILE_ZONE_COUNT> m_stats{};
+    ZoneStats m_frameStats;
+    int m_framesSinceRefresh = 0;
+    std::vector<float> m_sortScratch;
+
+    sf::VertexArray m_graph{sf::PrimitiveType::LineStrip};
+};
+#endif
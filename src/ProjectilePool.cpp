@@ -0,0 +1,218 @@
+#include "ProjectilePool.h"
+#include <algorithm>
+#include <iostream>
+
+// Parked bodies are disabled (out of the broadphase), so where they sit does
+// not matter; keep them well below the kill plane anyway.
+constexpr float PARK_Y = -1000.0f;
+constexpr float DEFAULT_RADIUS = 0.15f;
+constexpr float DEFAULT_DENSITY = 0.1f;
+
+void ProjectilePool::init(Physics& physics, int capacity) {
+    m_physics = &physics;
+    m_slots.clear();
+    m_slots.resize(static_cast<size_t>(std::max(0, capacity)));
+    m_active.clear();
+    m_active.reserve(m_slots.size());
+    m_free.clear();
+    m_free.reserve(m_slots.size());
+    m_loadActive.reserve(m_slots.size());
+    m_loadFree.reserve(m_slots.size());
+    m_loadStates.reserve(m_slots.size());
+    m_seen.assign(m_slots.size(), 0);
+
+    createParkedBodies();
+    for (int i = static_cast<int>(m_slots.size()) - 1; i >= 0; i--) m_free.push_back(i);
+
+    std::cout << "[ProjectilePool] " << m_slots.size() << " bullet bodies ready\n";
+}
+
+// One disabled bullet body per slot, in the same order every time so a world
+// rebuilt by loadState lays them out exactly as the last rebuild did
+void ProjectilePool::createParkedBodies() {
+    for (int i = static_cast<int>(m_slots.size()) - 1; i >= 0; i--) {
+        Slot& slot = m_slots[i];
+        b2BodyId body = m_physics->createDynamicCircle(
+            0.0f, PARK_Y, DEFAULT_RADIUS, DEFAULT_DENSITY,
+            CAT_PROJECTILE, CAT_PLATFORM | CAT_PLAYER);
+        b2Body_SetBullet(body, true);
+        b2Body_GetShapes(body, &slot.shapeId, 1);
+        m_physics->tagBody(body, BodyKind::Projectile, i);
+        b2Body_Disable(body);
+
+        slot.proj.bodyId = body;
+        slot.proj.alive = false;
+        slot.radius = DEFAULT_RADIUS;
+        slot.density = DEFAULT_DENSITY;
+    }
+}
+
+// Only touches the shape when the pellet size actually changes
+void ProjectilePool::setShape(Slot& slot, float radius, float density) {
+    if (slot.radius != radius) {
+        b2Circle circle = {{0.0f, 0.0f}, radius};
+        b2Shape_SetCircle(slot.shapeId, &circle);
+        slot.radius = radius;
+    }
+    if (slot.density != density) {
+        b2Shape_SetDensity(slot.shapeId, density, true);
+        slot.density = density;
+    }
+}
+
+Projectile* ProjectilePool::spawn(b2Vec2 pos, b2Vec2 vel, float radius, float density, bool affectedByGravity) {
+    if (m_free.empty()) return nullptr;
+    int idx = m_free.back();
+    m_free.pop_back();
+    Slot& slot = m_slots[idx];
+
+    setShape(slot, radius, density);
+    b2BodyId body = slot.proj.bodyId;
+    applyBody(body, BodyState{pos, b2Rot_identity, vel, 0.0f});
+    b2Body_SetGravityScale(body, affectedByGravity ? 1.0f : 0.0f);
+    b2Body_Enable(body);
+
+    // Reset gameplay state but keep the body handle
+    slot.proj = Projectile{};
+    slot.proj.bodyId = body;
+    m_active.push_back(idx);
+    return &slot.proj;
+}
+
+void ProjectilePool::park(Slot& slot) {
+    b2Body_Disable(slot.proj.bodyId);
+    slot.proj.alive = false;
+}
+
+void ProjectilePool::releaseDead() {
+    size_t out = 0;
+    for (size_t i = 0; i < m_active.size(); i++) {
+        int idx = m_active[i];
+        Slot& slot = m_slots[idx];
+        if (slot.proj.alive) {
+            m_active[out++] = idx;
+        } else {
+            park(slot);
+            m_free.push_back(idx);
+        }
+    }
+    m_active.resize(out);
+}
+
+void ProjectilePool::releaseAll() {
+    for (int idx : m_active) {
+        park(m_slots[idx]);
+        m_free.push_back(idx);
+    }
+    m_active.clear();
+}
+
+// ============================================================
+// STATE CAPTURE
+// ============================================================
+
+void ProjectilePool::SlotState::write(StateWriter& out) const {
+    out.write(weaponId);
+    out.write(ownerIndex);
+    out.write(lifetime);
+    out.write(alive);
+    out.write(isPoison);
+    out.write(poisonDps);
+    out.write(poisonDuration);
+    out.write(radius);
+    out.write(density);
+    out.write(gravityScale);
+    out.write(body);
+}
+
+bool ProjectilePool::SlotState::read(StateReader& in) {
+    in.read(weaponId);
+    in.read(ownerIndex);
+    in.read(lifetime);
+    in.read(alive);
+    in.read(isPoison);
+    in.read(poisonDps);
+    in.read(poisonDuration);
+    in.read(radius);
+    in.read(density);
+    in.read(gravityScale);
+    in.read(body);
+    return in.ok();
+}
+
+void ProjectilePool::saveState(StateWriter& out) const {
+    out.write(static_cast<uint32_t>(m_slots.size()));
+    out.writeVector(m_active);
+    out.writeVector(m_free);
+    for (int idx : m_active) {
+        const Slot& slot = m_slots[idx];
+        const Projectile& p = slot.proj;
+        SlotState{
+            p.weapon ? p.weapon->id : INVALID_WEAPON_ID, p.ownerIndex, p.lifetime,
+            p.alive, p.isPoison, p.poisonDps, p.poisonDuration,
+            slot.radius, slot.density, b2Body_GetGravityScale(p.bodyId),
+            captureBody(p.bodyId)}.write(out);
+    }
+}
+
+bool ProjectilePool::loadState(StateReader& in, const WeaponFactory& weapons) {
+    uint32_t capacity = 0;
+    if (!in.read(capacity) || capacity != m_slots.size()) {
+        std::cerr << "[ProjectilePool] State capacity " << capacity
+                  << " does not match pool of " << m_slots.size() << "\n";
+        return false;
+    }
+    if (!in.readVector(m_loadActive) || !in.readVector(m_loadFree)) return false;
+
+    // Every slot must be either active or free, exactly once
+    bool valid = m_loadActive.size() + m_loadFree.size() == m_slots.size();
+    std::fill(m_seen.begin(), m_seen.end(), 0);
+    auto claim = [&](int idx) {
+        if (idx < 0 || idx >= static_cast<int>(capacity) || m_seen[idx]) return false;
+        m_seen[idx] = 1;
+        return true;
+    };
+    for (int idx : m_loadActive) valid = valid && claim(idx);
+    for (int idx : m_loadFree) valid = valid && claim(idx);
+    if (!valid) {
+        std::cerr << "[ProjectilePool] Active/free lists do not cover the pool\n";
+        return false;
+    }
+
+    m_loadStates.resize(m_loadActive.size());
+    for (SlotState& st : m_loadStates) {
+        if (!st.read(in)) return false;
+        if (st.weaponId == INVALID_WEAPON_ID || !(st.radius > 0.0f) || !(st.density > 0.0f)) {
+            std::cerr << "[ProjectilePool] Bad projectile in state\n";
+            return false;
+        }
+    }
+
+    // Valid: the world was reset, so park a fresh body in every slot and
+    // wake the live ones in active order
+    createParkedBodies();
+    m_active.swap(m_loadActive);
+    m_free.swap(m_loadFree);
+    for (size_t i = 0; i < m_active.size(); i++) {
+        const SlotState& st = m_loadStates[i];
+        Slot& slot = m_slots[m_active[i]];
+        setShape(slot, st.radius, st.density);
+
+        Projectile& p = slot.proj;
+        b2BodyId body = p.bodyId;
+        p = Projectile{};
+        p.bodyId = body;
+        p.weapon = &weapons.getWeaponById(st.weaponId);
+        p.ownerIndex = st.ownerIndex;
+        p.lifetime = st.lifetime;
+        p.alive = st.alive;
+        p.isPoison = st.isPoison;
+        p.poisonDps = st.poisonDps;
+        p.poisonDuration = st.poisonDuration;
+
+        b2Body_SetGravityScale(body, st.gravityScale);
+        applyBody(body, st.body);
+        b2Body_Enable(body);
+    }
+    return true;
+}
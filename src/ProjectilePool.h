@@ -0,0 +1,97 @@
+#pragma once
+#include "Physics.h"
+#include "Weapon.h"
+#include "WeaponFactory.h"
+#include "StateBuffer.h"
+#include <type_traits>
+#include <vector>
+
+struct Projectile {
+    b2BodyId bodyId;
+    const WeaponData* weapon = nullptr;  // interned in WeaponFactory
+    int ownerIndex = -1;
+    float lifetime = 0.0f;
+    bool alive = true;
+    bool isPoison = false;
+    float poisonDps = 0.0f;
+    float poisonDuration = 0.0f;
+};
+static_assert(std::is_trivially_copyable_v<Projectile>, "Projectile must stay trivially copyable");
+
+// Fixed-capacity projectile storage. Every slot owns a bullet body created up
+// front and parked disabled; spawning re-enables one, releasing disables it
+// again. After init() nothing here allocates or creates/destroys Box2D bodies,
+// except loadState, which repopulates a freshly reset world.
+class ProjectilePool {
+public:
+    ProjectilePool() = default;
+    ProjectilePool(const ProjectilePool&) = delete;
+    ProjectilePool& operator=(const ProjectilePool&) = delete;
+
+    void init(Physics& physics, int capacity);
+
+    // Activates a free slot at the given state and returns it, or nullptr when
+    // the pool is exhausted. The caller fills in the gameplay fields.
+    Projectile* spawn(b2Vec2 pos, b2Vec2 vel, float radius, float density, bool affectedByGravity);
+
+    // Disables the bodies of projectiles marked !alive and returns their slots
+    void releaseDead();
+    void releaseAll();
+
+    // Slot indices of live projectiles, in spawn order
+    const std::vector<int>& getActive() const { return m_active; }
+    Projectile&       operator[](int slot)       { return m_slots[slot].proj; }
+    const Projectile& operator[](int slot) const { return m_slots[slot].proj; }
+
+    int getCapacity() const { return static_cast<int>(m_slots.size()); }
+
+    // Live projectiles and the free-list order, so spawns after a restore
+    // land in the same slots. The pool must already be init()ed, and
+    // loadState expects a freshly reset world: it parks a new body in every
+    // slot and enables the live ones. A rejected state leaves the pool
+    // untouched.
+    void saveState(StateWriter& out) const;
+    bool loadState(StateReader& in, const WeaponFactory& weapons);
+
+private:
+    struct Slot {
+        Projectile proj;
+        b2ShapeId  shapeId = b2_nullShapeId;
+        float      radius = 0.0f;
+        float      density = 0.0f;
+    };
+
+    // Serialized form of a live slot (body id left out, it is per-world).
+    // Written field by field: the struct has padding.
+    struct SlotState {
+        WeaponId  weaponId;
+        int       ownerIndex;
+        float     lifetime;
+        bool      alive;
+        bool      isPoison;
+        float     poisonDps;
+        float     poisonDuration;
+        float     radius;
+        float     density;
+        float     gravityScale;
+        BodyState body;
+
+        void write(StateWriter& out) const;
+        bool read(StateReader& in);
+    };
+
+    void createParkedBodies();
+    void setShape(Slot& slot, float radius, float density);
+    void park(Slot& slot);
+
+    Physics*          m_physics = nullptr;
+    std::vector<Slot> m_slots;
+    std::vector<int>  m_active;
+    std::vector<int>  m_free;
+
+    // loadState scratch, validated before anything live changes
+    std::vector<int>       m_loadActive;
+    std::vector<int>       m_loadFree;
+    std::vector<SlotState> m_loadStates;
+    std::vector<uint8_t>   m_seen;
+};
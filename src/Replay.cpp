@@ -0,0 +1,435 @@
+#include "Replay.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+// File layout (little-endian):
+//   "SBRP"  u16 version
+//   u64 seed  i32 level  u8 wrap  u8 playerCount
+//   playerCount x { u8 type, u8 r, u8 g, u8 b, u8 a }
+//   u32 rulesLen  rules JSON
+//   u32 tickCount  u32 streamLen  stream
+//   v2+: u32 keyframeCount  keyframeCount x { u32 tick, streamOffset, stateOffset, stateSize }
+//        u32 statesLen  states (Match::saveState blobs)
+//   v3+: u8 sectionCount  u32 checksumTicks
+//   v3-4:  checksumTicks x sectionCount x u32
+//   v5+:   checksumTicks x u32 combined  u32 sectionInterval
+//          ceil(checksumTicks / sectionInterval) x sectionCount x u32
+//   v4+: keyframes restore exactly (the world is rebuilt from them). Older
+//        keyframes are ignored and seeks re-simulate instead.
+static constexpr char     REPLAY_MAGIC[4] = {'S', 'B', 'R', 'P'};
+static constexpr uint16_t REPLAY_VERSION = 5;
+static constexpr uint16_t EXACT_KEYFRAME_VERSION = 4;
+
+// ============================================================
+// INPUT PACKING
+// ============================================================
+
+uint8_t packInput(const PlayerInput& in) {
+    return static_cast<uint8_t>(
+        (in.moveLeft      ? 0x01 : 0) | (in.moveRight   ? 0x02 : 0) |
+        (in.jump          ? 0x04 : 0) | (in.attack      ? 0x08 : 0) |
+        (in.aimUp         ? 0x10 : 0) | (in.aimDown     ? 0x20 : 0) |
+        (in.jumpPressed   ? 0x40 : 0) | (in.attackPressed ? 0x80 : 0));
+}
+
+PlayerInput unpackInput(uint8_t bits) {
+    PlayerInput in;
+    in.moveLeft      = bits & 0x01;
+    in.moveRight     = bits & 0x02;
+    in.jump          = bits & 0x04;
+    in.attack        = bits & 0x08;
+    in.aimUp         = bits & 0x10;
+    in.aimDown       = bits & 0x20;
+    in.jumpPressed   = bits & 0x40;
+    in.attackPressed = bits & 0x80;
+    return in;
+}
+
+// ============================================================
+// BYTE HELPERS
+// ============================================================
+
+namespace {
+
+void putU8(std::vector<uint8_t>& out, uint8_t v) { out.push_back(v); }
+
+void putU16(std::vector<uint8_t>& out, uint16_t v) {
+    for (int i = 0; i < 2; i++) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; i++) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void putU64(std::vector<uint8_t>& out, uint64_t v) {
+    for (int i = 0; i < 8; i++) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void putVarint(std::vector<uint8_t>& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+// Bounds-checked cursor over a loaded file; any overrun sets `ok` to false
+struct ByteReader {
+    const uint8_t* data;
+    size_t size;
+    size_t pos = 0;
+    bool ok = true;
+
+    bool need(size_t n) {
+        if (!ok || size - pos < n) { ok = false; return false; }
+        return true;
+    }
+    uint64_t readLE(int bytes) {
+        if (!need(static_cast<size_t>(bytes))) return 0;
+        uint64_t v = 0;
+        for (int i = 0; i < bytes; i++) v |= static_cast<uint64_t>(data[pos++]) << (8 * i);
+        return v;
+    }
+    uint8_t  u8()  { return static_cast<uint8_t>(readLE(1)); }
+    uint16_t u16() { return static_cast<uint16_t>(readLE(2)); }
+    uint32_t u32() { return static_cast<uint32_t>(readLE(4)); }
+    uint64_t u64() { return readLE(8); }
+};
+
+uint32_t getU32(const uint8_t* in) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) v |= static_cast<uint32_t>(in[i]) << (8 * i);
+    return v;
+}
+
+bool readVarint(const uint8_t* in, size_t size, size_t& pos, uint32_t& out) {
+    out = 0;
+    for (int shift = 0; shift < 35 && pos < size; shift += 7) {
+        uint8_t b = in[pos++];
+        out |= static_cast<uint32_t>(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// ============================================================
+// WRITER
+// ============================================================
+
+void ReplayWriter::begin(const ReplayHeader& header) {
+    m_header = header;
+    m_stream.clear();
+    m_stream.reserve(64 * 1024);
+    m_runLength = 0;
+    m_ticks = 0;
+    m_keyframes.clear();
+    m_states.clear();
+    m_checksums.clear();
+    m_sectionSums.clear();
+    m_recording = true;
+}
+
+void ReplayWriter::record(const PlayerInputs& inputs, const Match& match) {
+    if (!m_recording) return;
+
+    // Only checkpoint ticks restore exactly (see Match::rebuildWorld)
+    if (m_keyframeInterval > 0 && m_ticks % m_keyframeInterval == 0 && Match::isCheckpoint(match.getTick())) {
+        flushRun();
+        match.saveState(m_stateScratch);
+        m_keyframes.push_back({m_ticks, static_cast<uint32_t>(m_stream.size()),
+                               static_cast<uint32_t>(m_states.size()),
+                               static_cast<uint32_t>(m_stateScratch.size())});
+        m_states.insert(m_states.end(), m_stateScratch.begin(), m_stateScratch.end());
+    }
+
+    // The per-section words only say where a desync is; one combined word
+    // per tick finds when, and sections are kept every few ticks to narrow it
+    StateChecksum sum = m_hasher.compute(match);
+    m_checksums.push_back(sum.combined());
+    if (m_ticks % CHECKSUM_SECTION_INTERVAL == 0)
+        m_sectionSums.insert(m_sectionSums.end(), sum.sections.begin(), sum.sections.begin() + sum.sectionCount);
+
+    std::array<uint8_t, MAX_PLAYERS> frame{};
+    for (size_t i = 0; i < m_header.players.size() && i < frame.size(); i++)
+        frame[i] = packInput(inputs[i]);
+
+    if (m_runLength > 0 && frame == m_runFrame) {
+        m_runLength++;
+    } else {
+        flushRun();
+        m_runFrame = frame;
+        m_runLength = 1;
+    }
+    m_ticks++;
+}
+
+void ReplayWriter::flushRun() {
+    if (m_runLength == 0) return;
+    putVarint(m_stream, m_runLength);
+    for (size_t i = 0; i < m_header.players.size(); i++) putU8(m_stream, m_runFrame[i]);
+    m_runLength = 0;
+}
+
+bool ReplayWriter::save(const std::string& path) {
+    if (!m_recording) return false;
+    flushRun();
+    m_recording = false;
+
+    std::vector<uint8_t> out;
+    out.insert(out.end(), REPLAY_MAGIC, REPLAY_MAGIC + 4);
+    putU16(out, REPLAY_VERSION);
+    putU64(out, m_header.seed);
+    putU32(out, static_cast<uint32_t>(m_header.levelIndex));
+    putU8(out, m_header.wrapAround ? 1 : 0);
+    putU8(out, static_cast<uint8_t>(m_header.players.size()));
+    for (const auto& p : m_header.players) {
+        putU8(out, static_cast<uint8_t>(p.type));
+        putU8(out, p.color.r); putU8(out, p.color.g); putU8(out, p.color.b); putU8(out, p.color.a);
+    }
+    std::string rules = RulesEngine::toJson(m_header.rules).dump();
+    putU32(out, static_cast<uint32_t>(rules.size()));
+    out.insert(out.end(), rules.begin(), rules.end());
+    putU32(out, m_ticks);
+    putU32(out, static_cast<uint32_t>(m_stream.size()));
+    out.insert(out.end(), m_stream.begin(), m_stream.end());
+    putU32(out, static_cast<uint32_t>(m_keyframes.size()));
+    for (const auto& kf : m_keyframes) {
+        putU32(out, kf.tick);
+        putU32(out, kf.streamOffset);
+        putU32(out, kf.stateOffset);
+        putU32(out, kf.stateSize);
+    }
+    putU32(out, static_cast<uint32_t>(m_states.size()));
+    out.insert(out.end(), m_states.begin(), m_states.end());
+    putU8(out, static_cast<uint8_t>(CS_PLAYER + m_header.players.size()));
+    putU32(out, m_ticks);
+    for (uint32_t word : m_checksums) putU32(out, word);
+    putU32(out, CHECKSUM_SECTION_INTERVAL);
+    for (uint32_t word : m_sectionSums) putU32(out, word);
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[Replay] Failed to write: " << path << "\n";
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+
+    std::cout << "[Replay] Saved " << m_ticks << " ticks, " << m_keyframes.size()
+              << " keyframes (" << out.size() << " bytes) to " << path << "\n";
+    return static_cast<bool>(file);
+}
+
+// ============================================================
+// READER
+// ============================================================
+
+bool ReplayReader::load(const std::string& path) {
+    m_keyframes.clear();
+    m_stream = nullptr;
+    m_streamSize = 0;
+    m_states = nullptr;
+    m_statesSize = 0;
+    m_combinedSums = nullptr;
+    m_sectionSums = nullptr;
+    m_checksumTicks = 0;
+    m_checksumSections = 0;
+    m_sectionInterval = 1;
+    if (!m_file.open(path)) return false;
+    const uint8_t* bytes = m_file.data();
+
+    ByteReader r{bytes, m_file.size()};
+    if (!r.need(4) || !std::equal(REPLAY_MAGIC, REPLAY_MAGIC + 4, bytes)) {
+        std::cerr << "[Replay] Not a replay file: " << path << "\n";
+        return false;
+    }
+    r.pos = 4;
+    uint16_t version = r.u16();
+    if (version < 1 || version > REPLAY_VERSION) {
+        std::cerr << "[Replay] Unsupported version " << version << " in " << path << "\n";
+        return false;
+    }
+
+    ReplayHeader header;
+    header.seed = r.u64();
+    header.levelIndex = static_cast<int>(r.u32());
+    header.wrapAround = r.u8() != 0;
+    int playerCount = r.u8();
+    if (playerCount > MAX_PLAYERS) r.ok = false;
+    for (int i = 0; i < playerCount && r.ok; i++) {
+        PlayerSetup setup;
+        setup.type = static_cast<CharacterType>(r.u8());
+        setup.color.r = r.u8(); setup.color.g = r.u8(); setup.color.b = r.u8(); setup.color.a = r.u8();
+        header.players.push_back(setup);
+    }
+
+    uint32_t rulesLen = r.u32();
+    if (r.need(rulesLen)) {
+        try {
+            std::string text(reinterpret_cast<const char*>(bytes + r.pos), rulesLen);
+            auto j = nlohmann::json::parse(text);
+            RulesEngine::applyJson(j, header.rules);
+        } catch (const std::exception& e) {
+            std::cerr << "[Replay] Bad rules block: " << e.what() << "\n";
+            r.ok = false;
+        }
+        r.pos += rulesLen;
+    }
+
+    uint32_t ticks = r.u32();
+    uint32_t streamLen = r.u32();
+    if (!r.need(streamLen)) {
+        std::cerr << "[Replay] Truncated file: " << path << "\n";
+        return false;
+    }
+    m_stream = bytes + r.pos;
+    m_streamSize = streamLen;
+    r.pos += streamLen;
+
+    // v1 files have no keyframes; they play back fine but only seek forwards
+    if (version >= 2) {
+        uint32_t keyframeCount = r.u32();
+        if (r.need(static_cast<size_t>(keyframeCount) * 16)) {
+            m_keyframes.resize(keyframeCount);
+            for (auto& kf : m_keyframes) {
+                kf.tick = r.u32();
+                kf.streamOffset = r.u32();
+                kf.stateOffset = r.u32();
+                kf.stateSize = r.u32();
+            }
+        }
+        uint32_t statesLen = r.u32();
+        if (r.need(statesLen)) {
+            m_states = bytes + r.pos;
+            m_statesSize = statesLen;
+        }
+        for (const auto& kf : m_keyframes) {
+            if (kf.streamOffset > m_streamSize || kf.stateOffset > m_statesSize ||
+                kf.stateSize > m_statesSize - kf.stateOffset) r.ok = false;
+        }
+        if (!r.ok) {
+            std::cerr << "[Replay] Truncated or corrupt keyframes: " << path << "\n";
+            m_keyframes.clear();
+            return false;
+        }
+        if (version < EXACT_KEYFRAME_VERSION && !m_keyframes.empty()) {
+            std::cout << "[Replay] v" << version << " keyframes do not restore exactly; "
+                      << "seeking will re-simulate from the start\n";
+            m_keyframes.clear();
+        }
+    }
+
+    if (version >= 3) {
+        int sections = r.u8();
+        uint32_t checksumTicks = r.u32();
+        bool valid = sections == CS_PLAYER + playerCount;
+        uint32_t interval = 1;  // v3-4 keep every section of every tick
+        if (version >= 5 && valid && r.need(static_cast<size_t>(checksumTicks) * 4)) {
+            m_combinedSums = bytes + r.pos;
+            r.pos += static_cast<size_t>(checksumTicks) * 4;
+            interval = r.u32();
+        }
+        size_t sectionTicks = interval > 0 ? (static_cast<size_t>(checksumTicks) + interval - 1) / interval : 0;
+        size_t sectionBytes = sectionTicks * static_cast<size_t>(sections) * 4;
+        if (!valid || interval == 0 || !r.need(sectionBytes)) {
+            std::cerr << "[Replay] Truncated or corrupt checksums: " << path << "\n";
+            m_combinedSums = nullptr;
+            return false;
+        }
+        m_sectionSums = bytes + r.pos;
+        m_checksumTicks = checksumTicks;
+        m_checksumSections = sections;
+        m_sectionInterval = interval;
+        r.pos += sectionBytes;
+    }
+
+    m_header = std::move(header);
+    m_ticks = ticks;
+    rewind();
+
+    std::cout << "[Replay] Loaded " << path << ": " << m_ticks << " ticks, "
+              << m_header.players.size() << " players, " << m_keyframes.size()
+              << " keyframes, seed " << m_header.seed << "\n";
+    return true;
+}
+
+void ReplayReader::rewind() {
+    m_pos = 0;
+    m_runRemaining = 0;
+    m_runFrame.fill(0);
+    m_tick = 0;
+}
+
+bool ReplayReader::next(PlayerInputs& out) {
+    if (m_runRemaining == 0) {
+        uint32_t len = 0;
+        if (m_pos >= m_streamSize || !readVarint(m_stream, m_streamSize, m_pos, len) || len == 0) return false;
+        if (m_streamSize - m_pos < m_header.players.size()) return false;
+        m_runFrame.fill(0);
+        for (size_t i = 0; i < m_header.players.size(); i++) m_runFrame[i] = m_stream[m_pos++];
+        m_runRemaining = len;
+    }
+    m_runRemaining--;
+    m_tick++;
+
+    for (size_t i = 0; i < out.size(); i++) out[i] = unpackInput(m_runFrame[i]);
+    return true;
+}
+
+bool ReplayReader::getChecksum(uint32_t tick, uint32_t& out) const {
+    if (tick >= m_checksumTicks) return false;
+    if (m_combinedSums) {
+        out = getU32(m_combinedSums + static_cast<size_t>(tick) * 4);
+        return true;
+    }
+    StateChecksum sum;
+    if (!getSections(tick, sum)) return false;
+    out = sum.combined();
+    return true;
+}
+
+bool ReplayReader::getSections(uint32_t tick, StateChecksum& out) const {
+    if (tick >= m_checksumTicks || tick % m_sectionInterval != 0) return false;
+    const uint8_t* src = m_sectionSums + static_cast<size_t>(tick / m_sectionInterval) * m_checksumSections * 4;
+    out = StateChecksum{};
+    out.sectionCount = m_checksumSections;
+    for (int s = 0; s < m_checksumSections; s++) out.sections[s] = getU32(src + s * 4);
+    return true;
+}
+
+bool ReplayReader::seek(Match& match, uint32_t tick) {
+    tick = std::min(tick, m_ticks);
+
+    // Latest keyframe at or before the target
+    auto it = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), tick,
+                               [](uint32_t t, const ReplayKeyframe& kf) { return t < kf.tick; });
+    const ReplayKeyframe* kf = it == m_keyframes.begin() ? nullptr : &*(it - 1);
+
+    // Restoring is only worth it when it skips ticks (or is the only way back)
+    bool restored = false;
+    if (kf && (tick < m_tick || kf->tick > m_tick)) {
+        if (match.loadState(m_states + kf->stateOffset, kf->stateSize)) {
+            m_pos = kf->streamOffset;
+            m_runRemaining = 0;
+            m_tick = kf->tick;
+            restored = true;
+        } else {
+            std::cerr << "[Replay] Keyframe at tick " << kf->tick << " failed to load, re-simulating\n";
+        }
+    }
+
+    // No usable keyframe behind us: start the match over from the header
+    if (!restored && tick < m_tick) {
+        match.start(m_header.levelIndex, m_header.players, m_header.wrapAround, m_header.seed);
+        rewind();
+    }
+
+    PlayerInputs inputs;
+    while (m_tick < tick && !match.isRoundOver()) {
+        if (!next(inputs)) return false;
+        match.update(FIXED_DT, inputs);
+    }
+    return m_tick == tick;
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include "Match.h"
+#include "MappedFile.h"
+#include "StateChecksum.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Packs the eight PlayerInput flags into one byte, bit i = i-th field
+uint8_t     packInput(const PlayerInput& in);
+constexpr uint8_t INPUT_PRESS_EDGES = 0x40 | 0x80;  // jumpPressed | attackPressed
+PlayerInput unpackInput(uint8_t bits);
+
+// Everything needed to rebuild a match before its first tick
+struct ReplayHeader {
+    uint64_t  seed = 0;
+    int       levelIndex = 0;
+    bool      wrapAround = false;
+    std::vector<PlayerSetup> players;
+    GameRules rules;
+};
+
+// Match state captured just before `tick` was simulated. Input decoding can
+// restart at streamOffset, which always begins a fresh run.
+struct ReplayKeyframe {
+    uint32_t tick;
+    uint32_t streamOffset;
+    uint32_t stateOffset;  // into the file's state blob
+    uint32_t stateSize;
+};
+
+// Records a match as its header plus one packed byte per player per tick.
+// Runs of identical ticks are collapsed: each run is stored as a varint
+// length followed by the player bytes, so idle stretches cost a few bytes.
+//
+// Every keyframe interval the full match state is captured as well, before
+// that tick is simulated. The open run is closed at each keyframe so playback
+// can resume decoding the input stream exactly there.
+//
+// Every tick also stores the combined StateChecksum of the state its inputs
+// are applied to, so playback on another build or machine can find the first
+// tick where it stops matching the recording. The per-section words, which
+// say what differs, are only kept every CHECKSUM_SECTION_INTERVAL ticks.
+class ReplayWriter {
+public:
+    static constexpr uint32_t DEFAULT_KEYFRAME_INTERVAL = 300;  // 5 s at 60 Hz
+    static_assert(DEFAULT_KEYFRAME_INTERVAL % Match::CHECKPOINT_INTERVAL == 0, "keyframes must land on checkpoints");
+    static constexpr uint32_t CHECKSUM_SECTION_INTERVAL = 60;   // 1 s at 60 Hz
+
+    void begin(const ReplayHeader& header);
+
+    // Call once per tick before match.update(); `match` is the state the
+    // inputs are about to be applied to
+    void record(const PlayerInputs& inputs, const Match& match);
+
+    // Ticks between keyframes; 0 records inputs only. Keyframes land on
+    // Match checkpoint ticks only, so use a multiple of CHECKPOINT_INTERVAL.
+    void setKeyframeInterval(uint32_t ticks) { m_keyframeInterval = ticks; }
+
+    // Writes the file and stops recording
+    bool save(const std::string& path);
+
+    bool     isRecording() const { return m_recording; }
+    uint32_t getTickCount() const { return m_ticks; }
+    const ReplayHeader& getHeader() const { return m_header; }  // of the latest begin()
+
+private:
+    void flushRun();
+
+    ReplayHeader m_header;
+    std::vector<uint8_t> m_stream;
+    std::array<uint8_t, MAX_PLAYERS> m_runFrame{};
+    uint32_t m_runLength = 0;
+    uint32_t m_ticks = 0;
+    bool     m_recording = false;
+
+    uint32_t m_keyframeInterval = DEFAULT_KEYFRAME_INTERVAL;
+    std::vector<ReplayKeyframe> m_keyframes;
+    std::vector<uint8_t>  m_states;
+    std::vector<uint8_t>  m_stateScratch;
+
+    StateHasher m_hasher;
+    std::vector<uint32_t> m_checksums;    // combined word per tick
+    std::vector<uint32_t> m_sectionSums;  // sectionCount words per section tick
+};
+
+// Plays a replay back from a memory-mapped file. Input runs and keyframe
+// states are read in place; nothing is copied out of the mapping.
+class ReplayReader {
+public:
+    bool load(const std::string& path);
+
+    const ReplayHeader& getHeader() const { return m_header; }
+    uint32_t getTickCount() const { return m_ticks; }
+    uint32_t getKeyframeCount() const { return static_cast<uint32_t>(m_keyframes.size()); }
+
+    // Tick whose inputs next() returns next
+    uint32_t getTick() const { return m_tick; }
+
+    // Fills in the next tick's inputs; false once the stream is exhausted
+    bool next(PlayerInputs& out);
+    void rewind();
+
+    // Brings `match` (started from this replay's header and fed by this
+    // reader so far) to the state just before `tick`: restores the nearest
+    // keyframe at or before it, then simulates the remaining ticks. Without a
+    // usable keyframe (pre-v4 files, or one that fails to load) a backwards
+    // seek restarts the match and re-simulates from tick 0.
+    bool seek(Match& match, uint32_t tick);
+
+    // Recorded checksum of the state before `tick` was simulated; false for
+    // files older than v3 and ticks past the end. getChecksum gives the
+    // combined word for any tick; getSections only succeeds every
+    // getSectionInterval() ticks (every tick in v3-4 files).
+    bool hasChecksums() const { return m_checksumTicks > 0; }
+    bool getChecksum(uint32_t tick, uint32_t& out) const;
+    bool getSections(uint32_t tick, StateChecksum& out) const;
+    uint32_t getSectionInterval() const { return m_sectionInterval; }
+
+private:
+    MappedFile     m_file;
+    ReplayHeader   m_header;
+    const uint8_t* m_stream = nullptr;
+    size_t         m_streamSize = 0;
+    size_t   m_pos = 0;
+    std::array<uint8_t, MAX_PLAYERS> m_runFrame{};
+    uint32_t m_runRemaining = 0;
+    uint32_t m_ticks = 0;
+    uint32_t m_tick = 0;
+
+    std::vector<ReplayKeyframe> m_keyframes;
+    const uint8_t* m_states = nullptr;
+    size_t         m_statesSize = 0;
+
+    const uint8_t* m_combinedSums = nullptr;  // v5+; older files combine the sections
+    const uint8_t* m_sectionSums = nullptr;
+    uint32_t       m_checksumTicks = 0;
+    int            m_checksumSections = 0;
+    uint32_t       m_sectionInterval = 1;
+};
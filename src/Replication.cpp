@@ -0,0 +1,401 @@
+#include "Replication.h"
+#include "BitStream.h"
+#include <algorithm>
+#include <cmath>
+
+// ============================================================
+// QUANTIZATION
+// ============================================================
+
+namespace {
+
+constexpr float PI = 3.14159265f;
+constexpr int   ANGLE_BITS = 10;
+constexpr float AIM_STEP = 0.05f;  // StickFigure::aimUp/aimDown increment
+
+// Bit width of each player field, and of its "small delta" form (0 = always
+// sent in full when changed). Deltas are taken modulo the field width, so
+// angles wrap around correctly.
+struct FieldSpec {
+    uint8_t bits;
+    uint8_t deltaBits;
+};
+
+constexpr std::array<FieldSpec, PLAYER_FIELD_COUNT> makeFieldSpecs() {
+    std::array<FieldSpec, PLAYER_FIELD_COUNT> specs{};
+    for (int part = 0; part < StickFigure::PART_COUNT; part++) {
+        specs[PF_PARTS + part * 3 + 0] = {ReplicationBounds::POS_BITS, 7};
+        specs[PF_PARTS + part * 3 + 1] = {ReplicationBounds::POS_BITS, 7};
+        specs[PF_PARTS + part * 3 + 2] = {ANGLE_BITS, 5};
+    }
+    specs[PF_HEALTH] = {10, 0};
+    specs[PF_LIVES]  = {6, 0};
+    specs[PF_FACING] = {1, 0};
+    specs[PF_AIM]    = {6, 2};
+    specs[PF_WEAPON] = {16, 0};
+    specs[PF_AMMO]   = {10, 0};
+    specs[PF_FLAGS]  = {2, 0};
+    return specs;
+}
+constexpr auto FIELD_SPECS = makeFieldSpecs();
+
+constexpr int EPOCH_BITS = 8;
+constexpr int TIMER_BITS = 16;
+constexpr int PROJECTILE_COUNT_BITS = 10;
+constexpr int PICKUP_COUNT_BITS = 3;
+constexpr int EXPLOSION_COUNT_BITS = 5;
+constexpr int EXPLOSION_RADIUS_BITS = 9;
+constexpr int EXPLOSION_AGE_BITS = 8;
+constexpr int CARVE_COUNT_BITS = 7;
+
+int32_t clampBits(long value, int bits) {
+    return static_cast<int32_t>(std::clamp(value, 0L, (1L << bits) - 1));
+}
+
+int32_t quantizeAngle(float radians) {
+    long q = std::lround(radians / (2.0f * PI) * (1 << ANGLE_BITS));
+    return static_cast<int32_t>(q & ((1 << ANGLE_BITS) - 1));
+}
+
+int32_t signExtend(uint32_t value, int bits) {
+    if (bits < 32 && (value & (1u << (bits - 1)))) value |= ~((1u << bits) - 1);
+    return static_cast<int32_t>(value);
+}
+
+uint32_t fieldMask(int bits) { return bits < 32 ? (1u << bits) - 1 : 0xFFFFFFFFu; }
+
+} // namespace
+
+int32_t ReplicationBounds::quantizeX(float v) const {
+    return clampBits(std::lround((v - minX) * POS_SCALE), POS_BITS);
+}
+
+int32_t ReplicationBounds::quantizeY(float v) const {
+    return clampBits(std::lround((v - minY) * POS_SCALE), POS_BITS);
+}
+
+float partAngle(const PlayerFields& fields, int part) {
+    float a = fields[PF_PARTS + part * 3 + 2] * (2.0f * PI / (1 << ANGLE_BITS));
+    return a > PI ? a - 2.0f * PI : a;
+}
+
+float aimAngle(const PlayerFields& fields) {
+    return (fields[PF_AIM] - 32) * AIM_STEP;
+}
+
+float health(const PlayerFields& fields) {
+    return fields[PF_HEALTH] * 0.5f;
+}
+
+void ReplicatedState::capture(const Match& match, const ReplicationBounds& bounds) {
+    tick = match.getTick();
+    roundTimer = clampBits(std::lround(match.getRoundTimer() * 10.0f), TIMER_BITS);
+    roundOver = match.isRoundOver();
+    winner = match.getWinner();
+
+    const auto& ps = match.getPlayers();
+    playerCount = std::min(static_cast<int>(ps.size()), MAX_PLAYERS);
+    for (int i = 0; i < playerCount; i++) {
+        const StickFigure& p = *ps[i];
+        PlayerFields& f = players[i];
+        auto parts = p.getPartBodyIds();
+        for (int part = 0; part < StickFigure::PART_COUNT; part++) {
+            b2Transform xf = b2Body_GetTransform(parts[part]);
+            f[PF_PARTS + part * 3 + 0] = bounds.quantizeX(xf.p.x);
+            f[PF_PARTS + part * 3 + 1] = bounds.quantizeY(xf.p.y);
+            f[PF_PARTS + part * 3 + 2] = quantizeAngle(b2Rot_GetAngle(xf.q));
+        }
+        f[PF_HEALTH] = clampBits(std::lround(p.getHealth() * 2.0f), FIELD_SPECS[PF_HEALTH].bits);
+        f[PF_LIVES]  = clampBits(p.getLives(), FIELD_SPECS[PF_LIVES].bits);
+        f[PF_FACING] = p.getFacingDirection() > 0 ? 1 : 0;
+        f[PF_AIM]    = clampBits(std::lround(p.getAimAngle() / AIM_STEP) + 32, FIELD_SPECS[PF_AIM].bits);
+        f[PF_WEAPON] = p.getCurrentWeapon().id;
+        f[PF_AMMO]   = clampBits(p.getAmmo() + 1L, FIELD_SPECS[PF_AMMO].bits);
+        f[PF_FLAGS]  = (p.isWaitingToRespawn() ? 1 : 0) | (p.isPoisoned() ? 2 : 0);
+    }
+
+    const auto& pool = match.getProjectiles();
+    const auto& active = pool.getActive();
+    projectiles.clear();
+    for (size_t i = 0; i < active.size() && i < (1u << PROJECTILE_COUNT_BITS) - 1; i++) {
+        const Projectile& proj = pool[active[i]];
+        b2Vec2 pos = b2Body_GetPosition(proj.bodyId);
+        projectiles.push_back({bounds.quantizeX(pos.x), bounds.quantizeY(pos.y), proj.weapon->id});
+    }
+
+    pickups.clear();
+    for (const auto& pk : match.getPickups()) {
+        if (!pk.alive || !pk.weapon) continue;
+        if (pickups.size() == (1u << PICKUP_COUNT_BITS) - 1) break;
+        pickups.push_back({bounds.quantizeX(pk.position.x), bounds.quantizeY(pk.position.y), pk.weapon->id});
+    }
+
+    explosions.clear();
+    for (const auto& fx : match.getExplosions()) {
+        if (explosions.size() == (1u << EXPLOSION_COUNT_BITS) - 1) break;
+        explosions.push_back({bounds.quantizeX(fx.x), bounds.quantizeY(fx.y),
+                              clampBits(std::lround(fx.radius * 16.0f), EXPLOSION_RADIUS_BITS),
+                              clampBits(std::lround(fx.timer / FIXED_DT), EXPLOSION_AGE_BITS),
+                              fx.isNuke});
+    }
+}
+
+bool ReplicatedState::samePayload(const ReplicatedState& o) const {
+    if (tick != o.tick || roundTimer != o.roundTimer || roundOver != o.roundOver ||
+        winner != o.winner || playerCount != o.playerCount)
+        return false;
+    for (int i = 0; i < playerCount; i++)
+        if (players[i] != o.players[i]) return false;
+
+    auto eqProj = [](const ReplicatedProjectile& a, const ReplicatedProjectile& b) {
+        return a.x == b.x && a.y == b.y && a.weapon == b.weapon;
+    };
+    auto eqPickup = [](const ReplicatedPickup& a, const ReplicatedPickup& b) {
+        return a.x == b.x && a.y == b.y && a.weapon == b.weapon;
+    };
+    auto eqFx = [](const ReplicatedExplosion& a, const ReplicatedExplosion& b) {
+        return a.x == b.x && a.y == b.y && a.radius == b.radius && a.age == b.age && a.isNuke == b.isNuke;
+    };
+    return std::equal(projectiles.begin(), projectiles.end(), o.projectiles.begin(), o.projectiles.end(), eqProj) &&
+           std::equal(pickups.begin(), pickups.end(), o.pickups.begin(), o.pickups.end(), eqPickup) &&
+           std::equal(explosions.begin(), explosions.end(), o.explosions.begin(), o.explosions.end(), eqFx);
+}
+
+// ============================================================
+// ENCODER
+// ============================================================
+
+// Packet layout, LSB-first bit stream:
+//   u16 seq, u8 match epoch, bit hasBaseline [u16 baselineSeq], u32 tick,
+//   u16 roundTimer, bit roundOver, u3 winner+1, u3 playerCount
+//   per player, per field: with a baseline, bit changed [bit small, then a
+//     deltaBits signed delta or the full value]; without, the full value
+//   u10 projectile count, each { x, y, bit sameWeaponAsPrevious [u16 weapon] }
+//   u3 pickup count, each { x, y, u16 weapon }
+//   u5 explosion count, each { x, y, u9 radius, u8 age, bit nuke }
+//   u7 carve count [u32 number of the first], each { f32 x, f32 y, f32 radius }
+void ReplicationEncoder::encode(const ReplicatedState& state, const std::vector<CarveEvent>& newCarves,
+                                std::vector<uint8_t>& out) {
+    m_carves.insert(m_carves.end(), newCarves.begin(), newCarves.end());
+
+    const ReplicatedState* base = nullptr;
+    if (m_hasAck) {
+        const Sent& s = m_history[m_ackSeq % HISTORY];
+        if (s.valid && s.seq == m_ackSeq && static_cast<uint16_t>(m_nextSeq - m_ackSeq) < HISTORY)
+            base = &s.state;
+    }
+
+    BitWriter w(out);
+    uint16_t seq = m_nextSeq++;
+    w.write(seq, 16);
+    w.write(m_epoch, EPOCH_BITS);
+    w.writeBool(base != nullptr);
+    if (base) w.write(m_ackSeq, 16);
+    w.write(state.tick, 32);
+    w.write(state.roundTimer, TIMER_BITS);
+    w.writeBool(state.roundOver);
+    w.write(static_cast<uint32_t>(state.winner + 1), 3);
+    w.write(state.playerCount, 3);
+
+    for (int i = 0; i < state.playerCount; i++) {
+        const PlayerFields& f = state.players[i];
+        bool delta = base && i < base->playerCount;
+        for (int k = 0; k < PLAYER_FIELD_COUNT; k++) {
+            const FieldSpec& spec = FIELD_SPECS[k];
+            if (!delta) { w.write(f[k], spec.bits); continue; }
+
+            uint32_t diff = static_cast<uint32_t>(f[k] - base->players[i][k]) & fieldMask(spec.bits);
+            w.writeBool(diff != 0);
+            if (diff == 0) continue;
+            int32_t d = signExtend(diff, spec.bits);
+            bool small = spec.deltaBits > 0 && d >= -(1 << (spec.deltaBits - 1)) && d < (1 << (spec.deltaBits - 1));
+            if (spec.deltaBits > 0) w.writeBool(small);
+            if (small) w.writeSigned(d, spec.deltaBits);
+            else       w.write(f[k], spec.bits);
+        }
+    }
+
+    w.write(static_cast<uint32_t>(state.projectiles.size()), PROJECTILE_COUNT_BITS);
+    WeaponId prevWeapon = INVALID_WEAPON_ID;
+    for (const auto& p : state.projectiles) {
+        w.write(p.x, ReplicationBounds::POS_BITS);
+        w.write(p.y, ReplicationBounds::POS_BITS);
+        w.writeBool(p.weapon == prevWeapon);
+        if (p.weapon != prevWeapon) w.write(p.weapon, 16);
+        prevWeapon = p.weapon;
+    }
+
+    w.write(static_cast<uint32_t>(state.pickups.size()), PICKUP_COUNT_BITS);
+    for (const auto& pk : state.pickups) {
+        w.write(pk.x, ReplicationBounds::POS_BITS);
+        w.write(pk.y, ReplicationBounds::POS_BITS);
+        w.write(pk.weapon, 16);
+    }
+
+    w.write(static_cast<uint32_t>(state.explosions.size()), EXPLOSION_COUNT_BITS);
+    for (const auto& fx : state.explosions) {
+        w.write(fx.x, ReplicationBounds::POS_BITS);
+        w.write(fx.y, ReplicationBounds::POS_BITS);
+        w.write(fx.radius, EXPLOSION_RADIUS_BITS);
+        w.write(fx.age, EXPLOSION_AGE_BITS);
+        w.writeBool(fx.isNuke);
+    }
+
+    int carveCount = std::min(static_cast<int>(m_carves.size()), MAX_CARVES_PER_PACKET);
+    w.write(carveCount, CARVE_COUNT_BITS);
+    if (carveCount > 0) w.write(m_carveBase, 32);
+    for (int i = 0; i < carveCount; i++) {
+        w.writeFloat(m_carves[i].x);
+        w.writeFloat(m_carves[i].y);
+        w.writeFloat(m_carves[i].radius);
+    }
+    w.flush();
+
+    Sent& sent = m_history[seq % HISTORY];
+    sent.state.tick = state.tick;
+    sent.state.roundTimer = state.roundTimer;
+    sent.state.roundOver = state.roundOver;
+    sent.state.winner = state.winner;
+    sent.state.playerCount = state.playerCount;
+    sent.state.players = state.players;  // only players are delta-encoded
+    sent.seq = seq;
+    sent.carveEnd = m_carveBase + carveCount;
+    sent.valid = true;
+}
+
+void ReplicationEncoder::acknowledge(uint16_t seq) {
+    const Sent& s = m_history[seq % HISTORY];
+    if (!s.valid || s.seq != seq) return;
+    if (static_cast<uint16_t>(m_nextSeq - seq) > HISTORY) return;  // older than the ring
+    if (m_hasAck && !seqNewer(seq, m_ackSeq)) return;
+
+    m_ackSeq = seq;
+    m_hasAck = true;
+    if (s.carveEnd > m_carveBase) {
+        m_carves.erase(m_carves.begin(), m_carves.begin() + (s.carveEnd - m_carveBase));
+        m_carveBase = s.carveEnd;
+    }
+}
+
+// m_nextSeq carries on, so acks still in flight from the old match are
+// older than anything sent from here on
+void ReplicationEncoder::startMatch() {
+    for (auto& s : m_history) s.valid = false;
+    m_epoch++;
+    m_hasAck = false;
+    m_carves.clear();
+    m_carveBase = 0;
+}
+
+// ============================================================
+// DECODER
+// ============================================================
+
+bool ReplicationDecoder::decode(const uint8_t* data, size_t size) {
+    BitReader r(data, size);
+    uint16_t seq = static_cast<uint16_t>(r.read(16));
+    uint8_t epoch = static_cast<uint8_t>(r.read(EPOCH_BITS));
+    if (!r.ok()) return false;
+    // A newer epoch is a new match: none of our history applies to it
+    bool newMatch = m_hasLatest && epochNewer(epoch, m_epoch);
+    if (m_hasLatest && !newMatch && epoch != m_epoch) return false;  // left over from the last match
+    if (m_hasLatest && !newMatch && !seqNewer(seq, m_history[m_latest].seq)) return false;
+
+    const ReplicatedState* base = nullptr;
+    if (r.readBool()) {
+        uint16_t baseSeq = static_cast<uint16_t>(r.read(16));
+        const Received& b = m_history[baseSeq % ReplicationEncoder::HISTORY];
+        if (!r.ok() || newMatch || !b.valid || b.seq != baseSeq) return false;
+        base = &b.state;
+    }
+
+    // Decode into a scratch state first: the target slot may be the baseline
+    ReplicatedState& st = m_scratch;
+    st.tick = r.read(32);
+    st.roundTimer = static_cast<int32_t>(r.read(TIMER_BITS));
+    st.roundOver = r.readBool();
+    st.winner = static_cast<int>(r.read(3)) - 1;
+    st.playerCount = static_cast<int>(r.read(3));
+    if (st.playerCount > MAX_PLAYERS) return false;
+
+    for (int i = 0; i < st.playerCount; i++) {
+        PlayerFields& f = st.players[i];
+        bool delta = base && i < base->playerCount;
+        for (int k = 0; k < PLAYER_FIELD_COUNT; k++) {
+            const FieldSpec& spec = FIELD_SPECS[k];
+            if (!delta) { f[k] = static_cast<int32_t>(r.read(spec.bits)); continue; }
+
+            int32_t prev = base->players[i][k];
+            if (!r.readBool()) { f[k] = prev; continue; }
+            bool small = spec.deltaBits > 0 && r.readBool();
+            if (small) {
+                int32_t d = r.readSigned(spec.deltaBits);
+                f[k] = static_cast<int32_t>(static_cast<uint32_t>(prev + d) & fieldMask(spec.bits));
+            } else {
+                f[k] = static_cast<int32_t>(r.read(spec.bits));
+            }
+        }
+    }
+
+    st.projectiles.resize(r.read(PROJECTILE_COUNT_BITS));
+    WeaponId prevWeapon = INVALID_WEAPON_ID;
+    for (auto& p : st.projectiles) {
+        p.x = static_cast<int32_t>(r.read(ReplicationBounds::POS_BITS));
+        p.y = static_cast<int32_t>(r.read(ReplicationBounds::POS_BITS));
+        p.weapon = r.readBool() ? prevWeapon : static_cast<WeaponId>(r.read(16));
+        prevWeapon = p.weapon;
+    }
+
+    st.pickups.resize(r.read(PICKUP_COUNT_BITS));
+    for (auto& pk : st.pickups) {
+        pk.x = static_cast<int32_t>(r.read(ReplicationBounds::POS_BITS));
+        pk.y = static_cast<int32_t>(r.read(ReplicationBounds::POS_BITS));
+        pk.weapon = static_cast<WeaponId>(r.read(16));
+    }
+
+    st.explosions.resize(r.read(EXPLOSION_COUNT_BITS));
+    for (auto& fx : st.explosions) {
+        fx.x = static_cast<int32_t>(r.read(ReplicationBounds::POS_BITS));
+        fx.y = static_cast<int32_t>(r.read(ReplicationBounds::POS_BITS));
+        fx.radius = static_cast<int32_t>(r.read(EXPLOSION_RADIUS_BITS));
+        fx.age = static_cast<int32_t>(r.read(EXPLOSION_AGE_BITS));
+        fx.isNuke = r.readBool();
+    }
+
+    int carveCount = static_cast<int>(r.read(CARVE_COUNT_BITS));
+    uint32_t first = carveCount > 0 ? r.read(32) : 0;
+    m_carveScratch.resize(carveCount);
+    for (auto& c : m_carveScratch) {
+        c.x = r.readFloat();
+        c.y = r.readFloat();
+        c.radius = r.readFloat();
+    }
+    if (!r.ok()) return false;
+
+    // Only now that the packet is known to be whole does it touch our state
+    if (newMatch) reset();
+    m_newCarves.clear();
+    for (int i = 0; i < carveCount; i++) {
+        if (first + i < m_carvesApplied) continue;
+        if (first + i > m_carvesApplied) break;  // gap: an earlier carve is still unacked
+        m_newCarves.push_back(m_carveScratch[i]);
+        m_carvesApplied++;
+    }
+
+    m_latest = seq % ReplicationEncoder::HISTORY;
+    m_hasLatest = true;
+    m_epoch = epoch;
+    Received& slot = m_history[m_latest];
+    std::swap(slot.state, m_scratch);
+    slot.seq = seq;
+    slot.valid = true;
+    return true;
+}
+
+void ReplicationDecoder::reset() {
+    for (auto& h : m_history) h.valid = false;
+    m_latest = 0;
+    m_hasLatest = false;
+    m_carvesApplied = 0;
+    m_newCarves.clear();
+}
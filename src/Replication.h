@@ -0,0 +1,186 @@
+#pragma once
+#include "Match.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+// QUANTIZATION
+// ============================================================
+
+// Positions are stored in 1/128 m steps relative to the bottom-left corner of
+// the playable world: the screen width (SCREEN_WIDTH / PPM) plus a margin on
+// either side, and from a little below the fall-death line upwards. Anything
+// outside is clamped, which only affects bodies that are about to die.
+struct ReplicationBounds {
+    static constexpr float POS_SCALE = 128.0f;
+    static constexpr int   POS_BITS = 13;
+    static constexpr float MARGIN = 4.0f;
+
+    float minX = -0.5f * SCREEN_WIDTH / PPM - MARGIN;
+    float minY;
+
+    explicit ReplicationBounds(const GameRules& rules) : minY(rules.fallDeathY - MARGIN) {}
+
+    int32_t quantizeX(float x) const;
+    int32_t quantizeY(float y) const;
+    float   x(int32_t q) const { return minX + q / POS_SCALE; }
+    float   y(int32_t q) const { return minY + q / POS_SCALE; }
+};
+static_assert((SCREEN_WIDTH / PPM + 2.0f * ReplicationBounds::MARGIN) * ReplicationBounds::POS_SCALE
+                  < (1 << ReplicationBounds::POS_BITS),
+              "screen width does not fit the position range");
+
+// Per-player fields, each packed with its own width (see Replication.cpp)
+enum PlayerField : int {
+    PF_PARTS = 0,                                        // x, y, angle per ragdoll part
+    PF_HEALTH = PF_PARTS + StickFigure::PART_COUNT * 3,  // half hit points
+    PF_LIVES,
+    PF_FACING,    // 1 = right
+    PF_AIM,       // aim angle in AIM_STEP units, offset by 32
+    PF_WEAPON,    // WeaponId
+    PF_AMMO,      // ammo + 1, so -1 (infinite) packs as 0
+    PF_FLAGS,     // 1 = waiting to respawn, 2 = poisoned
+    PLAYER_FIELD_COUNT
+};
+
+using PlayerFields = std::array<int32_t, PLAYER_FIELD_COUNT>;
+
+struct ReplicatedProjectile {
+    int32_t  x, y;
+    WeaponId weapon;
+};
+
+struct ReplicatedPickup {
+    int32_t  x, y;
+    WeaponId weapon;
+};
+
+struct ReplicatedExplosion {
+    int32_t x, y;
+    int32_t radius;  // 1/16 m
+    int32_t age;     // ticks since detonation
+    bool    isNuke;
+};
+
+// Everything a client needs to draw one tick, already quantized. Players are
+// delta-encoded against a snapshot the client acknowledged; the short-lived
+// lists are small and sent whole.
+struct ReplicatedState {
+    uint32_t tick = 0;
+    int32_t  roundTimer = 0;  // tenths of a second
+    bool     roundOver = false;
+    int      winner = -1;
+    int      playerCount = 0;
+    std::array<PlayerFields, MAX_PLAYERS> players{};
+    std::vector<ReplicatedProjectile> projectiles;
+    std::vector<ReplicatedPickup> pickups;
+    std::vector<ReplicatedExplosion> explosions;
+
+    // Quantizes `match` into this state, reusing the vectors' capacity
+    void capture(const Match& match, const ReplicationBounds& bounds);
+
+    bool samePayload(const ReplicatedState& other) const;
+};
+
+// Dequantization helpers for clients
+float   partAngle(const PlayerFields& fields, int part);
+float   aimAngle(const PlayerFields& fields);
+float   health(const PlayerFields& fields);
+
+// ============================================================
+// ENCODER / DECODER
+// ============================================================
+
+// Newer-than for wrapping 16-bit sequence numbers
+inline bool seqNewer(uint16_t a, uint16_t b) { return static_cast<int16_t>(a - b) > 0; }
+inline bool epochNewer(uint8_t a, uint8_t b) { return static_cast<int8_t>(a - b) > 0; }
+
+// Server side, one per client. Each packet carries a sequence number and
+// names the snapshot it is delta-encoded against: the newest one the client
+// acknowledged that is still in the history ring. With no usable baseline
+// every player field is sent in full.
+//
+// Terrain carves are reliable events rather than state: each carries a
+// running number and is resent in every packet until a packet containing it
+// is acknowledged. Carve coordinates go out as raw floats so the client's
+// Arena::carveCircle produces exactly the server's terrain.
+//
+// Packets also carry a match epoch. Carve numbers restart with every match,
+// so a client that sees a newer epoch drops its history and starts the new
+// match's terrain over; sequence numbers keep counting across matches so a
+// late ack from the old match never names a new packet.
+class ReplicationEncoder {
+public:
+    static constexpr int HISTORY = 32;
+    static constexpr int MAX_CARVES_PER_PACKET = 64;
+
+    // Appends one packet for `state` (plus this tick's carves) to `out`
+    void encode(const ReplicatedState& state, const std::vector<CarveEvent>& newCarves,
+                std::vector<uint8_t>& out);
+
+    // The client received packet `seq`
+    void acknowledge(uint16_t seq);
+
+    // A new match begins: bumps the epoch, drops baselines and pending carves
+    void startMatch();
+    bool hasBaseline() const { return m_hasAck; }
+    uint16_t getNextSeq() const { return m_nextSeq; }
+
+private:
+    struct Sent {
+        ReplicatedState state;
+        uint16_t seq = 0;
+        uint32_t carveEnd = 0;  // carves [0, carveEnd) were in this packet
+        bool     valid = false;
+    };
+
+    std::array<Sent, HISTORY> m_history;
+    uint16_t m_nextSeq = 0;
+    uint16_t m_ackSeq = 0;
+    bool     m_hasAck = false;
+    uint8_t  m_epoch = 0;
+
+    std::vector<CarveEvent> m_carves;  // unacknowledged, oldest first
+    uint32_t m_carveBase = 0;          // number of m_carves[0]
+};
+
+// Client side. Keeps the same history ring so later packets can name any
+// recent snapshot as their baseline.
+class ReplicationDecoder {
+public:
+    // Returns false for malformed or stale packets (including any from an
+    // older match) and for packets whose baseline is unknown; those are
+    // dropped and must not be acknowledged. A packet from a newer match
+    // resets the decoder first.
+    bool decode(const uint8_t* data, size_t size);
+
+    const ReplicatedState& getState() const { return m_history[m_latest].state; }
+    uint16_t getAckSeq() const { return m_history[m_latest].seq; }
+
+    // Carves first seen in the latest decode(), to apply to the local arena
+    const std::vector<CarveEvent>& getNewCarves() const { return m_newCarves; }
+
+    // Changes when the server starts a new match; the local arena must then
+    // be rebuilt before applying getNewCarves()
+    uint8_t getEpoch() const { return m_epoch; }
+
+    void reset();
+
+private:
+    struct Received {
+        ReplicatedState state;
+        uint16_t seq = 0;
+        bool     valid = false;
+    };
+
+    std::array<Received, ReplicationEncoder::HISTORY> m_history;
+    int      m_latest = 0;
+    bool     m_hasLatest = false;
+    uint8_t  m_epoch = 0;
+    uint32_t m_carvesApplied = 0;
+    std::vector<CarveEvent> m_newCarves;
+
+    ReplicatedState m_scratch;
+    std::vector<CarveEvent> m_carveScratch;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+
+// Per-match random stream (PCG32). All gameplay randomness draws from the
+// Match's instance, so a match replays bit-for-bit from its seed and input
+// stream. The distributions are implemented here rather than via <random>,
+// whose distribution algorithms differ between standard libraries. The state
+// is two integers, so snapshots can copy it directly.
+class Rng {
+public:
+    Rng() { seed(0); }
+    explicit Rng(uint64_t s) { seed(s); }
+
+    void seed(uint64_t s) {
+        m_state = 0;
+        m_inc = (s << 1) | 1u;
+        next();
+        m_state += 0x853C49E6748FEA9BULL ^ s;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = m_state;
+        m_state = old * 6364136223846793005ULL + m_inc;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = static_cast<uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    // Uniform in [0, 1)
+    float uniform01() { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+
+    // Uniform in [lo, hi)
+    float uniform(float lo, float hi) { return lo + (hi - lo) * uniform01(); }
+
+    // Uniform integer in [lo, hi] (inclusive); bias is negligible for the
+    // small ranges gameplay uses
+    int uniformInt(int lo, int hi) {
+        if (hi <= lo) return lo;
+        uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(hi) - lo) + 1;
+        return lo + static_cast<int>((static_cast<uint64_t>(next()) * range) >> 32);
+    }
+
+private:
+    uint64_t m_state = 0;
+    uint64_t m_inc = 1;
+};
@@ -0,0 +1,352 @@
+#include "RollbackSession.h"
+#include "Replay.h"
+#include <algorithm>
+#include <iostream>
+
+// Packet layout (little-endian), all packets start with u16 magic, u8 type,
+// u8 sender player index:
+//   Sync:   u8 gotYours  u64 seed  u32 level  u8 wrap  u8 character
+//   Inputs: u32 ack (remote ticks received)  u32 startTick  u8 count  count x input
+//           u32 checksumTick (UINT32_MAX = none yet)  u32 checksum
+static constexpr uint16_t PACKET_MAGIC = 0x5342;  // "SB"
+static constexpr uint8_t  PACKET_SYNC = 1;
+static constexpr uint8_t  PACKET_INPUTS = 2;
+static constexpr uint32_t MAX_INPUTS_PER_PACKET = 64;
+static constexpr auto     SYNC_RESEND = std::chrono::milliseconds(100);
+
+namespace {
+
+struct PacketWriter {
+    uint8_t* data;
+    size_t size = 0;
+    void put(uint64_t v, int bytes) {
+        for (int i = 0; i < bytes; i++) data[size++] = static_cast<uint8_t>(v >> (8 * i));
+    }
+};
+
+struct PacketReader {
+    const uint8_t* data;
+    size_t size;
+    size_t pos = 0;
+    bool ok = true;
+    uint64_t get(int bytes) {
+        if (!ok || size - pos < static_cast<size_t>(bytes)) { ok = false; return 0; }
+        uint64_t v = 0;
+        for (int i = 0; i < bytes; i++) v |= static_cast<uint64_t>(data[pos++]) << (8 * i);
+        return v;
+    }
+};
+
+} // namespace
+
+// ============================================================
+// SETUP
+// ============================================================
+
+bool RollbackSession::open(const RollbackConfig& config, const SessionParams& localParams) {
+    close();
+    m_config = config;
+    m_config.localPlayer = std::clamp(config.localPlayer, 0, 1);
+    m_config.inputDelay = std::clamp(config.inputDelay, 0, 10);
+    m_config.maxRollback = std::clamp(config.maxRollback, 1, MAX_ROLLBACK_LIMIT);
+    m_params = localParams;
+
+    if (!m_socket.open(config.localPort)) return false;
+
+    m_frame = 0;
+    m_remoteCount = 0;
+    m_peerAck = 0;
+    m_rollbackTo = UINT32_MAX;
+    m_localInputs.fill(0);
+    m_remoteInputs.fill(0);
+    m_predicted.fill(0);
+    m_localSums.fill(TickChecksum{});
+    m_remoteSums.fill(TickChecksum{});
+    m_latestLocalSum = TickChecksum{};
+    // The first inputDelay ticks have no local input yet; they stay neutral
+    m_localCount = static_cast<uint32_t>(m_config.inputDelay);
+    // Enough checkpoints to reach back maxRollback ticks plus a partial interval
+    m_snapshots.assign(static_cast<size_t>(m_config.maxRollback) / Match::CHECKPOINT_INTERVAL + 3, GameSnapshot());
+    m_outgoing.clear();
+    m_netRng.seed(std::random_device{}());
+    m_stats = Stats{};
+
+    m_gotPeerSync = false;
+    m_peerHasOurSync = false;
+    m_synchronized = false;
+    m_lastHeard = Clock::now();
+    m_lastSyncSent = Clock::time_point{};
+    m_open = true;
+
+    std::cout << "[Net] Player " << (m_config.localPlayer + 1) << " on port "
+              << m_socket.getLocalPort() << ", peer " << m_config.peer.toString()
+              << " | delay " << m_config.inputDelay << " | rollback " << m_config.maxRollback << "\n";
+    if (config.conditions.latencyMs > 0 || config.conditions.jitterMs > 0 || config.conditions.lossPercent > 0.0f)
+        std::cout << "[Net] Simulating " << config.conditions.latencyMs << " ms latency, "
+                  << config.conditions.jitterMs << " ms jitter, "
+                  << config.conditions.lossPercent << "% loss\n";
+    return true;
+}
+
+void RollbackSession::close() {
+    m_socket.close();
+    m_open = false;
+    m_synchronized = false;
+}
+
+float RollbackSession::getSilenceSeconds() const {
+    return std::chrono::duration<float>(Clock::now() - m_lastHeard).count();
+}
+
+// ============================================================
+// NETWORK
+// ============================================================
+
+void RollbackSession::poll() {
+    if (!m_open) return;
+    receivePackets();
+    if (!m_synchronized && Clock::now() - m_lastSyncSent >= SYNC_RESEND) sendSync();
+    flushOutgoing();
+}
+
+void RollbackSession::sendSync() {
+    uint8_t buf[32];
+    PacketWriter w{buf};
+    w.put(PACKET_MAGIC, 2);
+    w.put(PACKET_SYNC, 1);
+    w.put(static_cast<uint8_t>(m_config.localPlayer), 1);
+    w.put(m_gotPeerSync ? 1 : 0, 1);
+    w.put(m_params.seed, 8);
+    w.put(static_cast<uint32_t>(m_params.levelIndex), 4);
+    w.put(m_params.wrapAround ? 1 : 0, 1);
+    w.put(static_cast<uint8_t>(m_params.characters[m_config.localPlayer]), 1);
+    sendPacket(buf, w.size);
+    m_lastSyncSent = Clock::now();
+}
+
+void RollbackSession::sendInputs() {
+    uint32_t start = std::min(m_peerAck, m_localCount);
+    uint32_t count = std::min(m_localCount - start, MAX_INPUTS_PER_PACKET);
+
+    uint8_t buf[24 + MAX_INPUTS_PER_PACKET];
+    PacketWriter w{buf};
+    w.put(PACKET_MAGIC, 2);
+    w.put(PACKET_INPUTS, 1);
+    w.put(static_cast<uint8_t>(m_config.localPlayer), 1);
+    w.put(m_remoteCount, 4);
+    w.put(start, 4);
+    w.put(count, 1);
+    for (uint32_t i = 0; i < count; i++) w.put(m_localInputs[(start + i) % INPUT_RING], 1);
+    w.put(m_latestLocalSum.tick, 4);
+    w.put(m_latestLocalSum.sum, 4);
+    sendPacket(buf, w.size);
+}
+
+void RollbackSession::sendPacket(const uint8_t* data, size_t size) {
+    m_stats.packetsSent++;
+    const NetConditions& c = m_config.conditions;
+    if (c.lossPercent > 0.0f &&
+        std::uniform_real_distribution<float>(0.0f, 100.0f)(m_netRng) < c.lossPercent) {
+        m_stats.packetsDropped++;
+        return;
+    }
+    if (c.latencyMs <= 0 && c.jitterMs <= 0) {
+        m_socket.send(m_config.peer, data, size);
+        return;
+    }
+
+    int delayMs = c.latencyMs;
+    if (c.jitterMs > 0) delayMs += std::uniform_int_distribution<int>(0, c.jitterMs)(m_netRng);
+    Pending p;
+    p.deliverAt = Clock::now() + std::chrono::milliseconds(delayMs);
+    p.size = std::min(size, p.data.size());
+    std::copy(data, data + p.size, p.data.begin());
+    m_outgoing.push_back(p);
+}
+
+void RollbackSession::flushOutgoing() {
+    auto now = Clock::now();
+    size_t out = 0;
+    for (size_t i = 0; i < m_outgoing.size(); i++) {
+        if (m_outgoing[i].deliverAt <= now)
+            m_socket.send(m_config.peer, m_outgoing[i].data.data(), m_outgoing[i].size);
+        else
+            m_outgoing[out++] = m_outgoing[i];
+    }
+    m_outgoing.resize(out);
+}
+
+void RollbackSession::receivePackets() {
+    uint8_t buf[512];
+    NetAddress from;
+    int size;
+    const int peerIndex = 1 - m_config.localPlayer;
+
+    while ((size = m_socket.receive(buf, sizeof(buf), from)) >= 0) {
+        if (from != m_config.peer) continue;
+        PacketReader r{buf, static_cast<size_t>(size)};
+        if (r.get(2) != PACKET_MAGIC) continue;
+        uint8_t type = static_cast<uint8_t>(r.get(1));
+        if (static_cast<int>(r.get(1)) != peerIndex || !r.ok) continue;
+
+        m_stats.packetsReceived++;
+        m_lastHeard = Clock::now();
+
+        if (type == PACKET_SYNC) {
+            bool gotYours = r.get(1) != 0;
+            uint64_t seed = r.get(8);
+            int level = static_cast<int>(r.get(4));
+            bool wrap = r.get(1) != 0;
+            uint8_t character = static_cast<uint8_t>(r.get(1));
+            if (!r.ok || character >= CHARACTER_TYPE_COUNT) continue;
+
+            if (m_config.localPlayer != 0) {
+                m_params.seed = seed;
+                m_params.levelIndex = level;
+                m_params.wrapAround = wrap;
+            }
+            m_params.characters[peerIndex] = static_cast<CharacterType>(character);
+            m_gotPeerSync = true;
+            if (gotYours) m_peerHasOurSync = true;
+            // Answer right away so the peer does not wait for our resend timer
+            if (!gotYours || !m_synchronized) sendSync();
+        } else if (type == PACKET_INPUTS) {
+            // Inputs are only sent once the peer has our sync
+            if (m_gotPeerSync) m_peerHasOurSync = true;
+            handleInputs(buf + r.pos, static_cast<size_t>(size) - r.pos);
+        }
+
+        if (!m_synchronized && m_gotPeerSync && m_peerHasOurSync) {
+            m_synchronized = true;
+            std::cout << "[Net] Synchronized with " << m_config.peer.toString() << " (seed "
+                      << m_params.seed << ", level " << m_params.levelIndex << ")\n";
+        }
+    }
+}
+
+void RollbackSession::handleInputs(const uint8_t* data, size_t size) {
+    PacketReader r{data, size};
+    uint32_t ack = static_cast<uint32_t>(r.get(4));
+    uint32_t start = static_cast<uint32_t>(r.get(4));
+    uint32_t count = static_cast<uint32_t>(r.get(1));
+    if (!r.ok || r.size - r.pos < count) return;
+
+    m_peerAck = std::max(m_peerAck, std::min(ack, m_localCount));
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t tick = start + i;
+        if (tick < m_remoteCount) continue;       // already have it
+        if (tick > m_remoteCount) break;          // gap; a resend will fill it
+        if (tick >= m_frame + INPUT_RING / 2) break;  // would overwrite live ring entries
+
+        uint8_t bits = data[r.pos + i];
+        m_remoteInputs[tick % INPUT_RING] = bits;
+        if (tick < m_frame && bits != m_predicted[tick % INPUT_RING])
+            m_rollbackTo = std::min(m_rollbackTo, tick);
+        m_remoteCount++;
+    }
+
+    r.pos += count;
+    uint32_t sumTick = static_cast<uint32_t>(r.get(4));
+    uint32_t sum = static_cast<uint32_t>(r.get(4));
+    if (r.ok && sumTick != UINT32_MAX) {
+        m_remoteSums[sumTick % INPUT_RING] = {sumTick, sum};
+        compareChecksums(sumTick);
+    }
+}
+
+// ============================================================
+// SIMULATION
+// ============================================================
+
+void RollbackSession::simulate(Match& match, uint32_t frame) {
+    const int local = m_config.localPlayer;
+    const int remote = 1 - local;
+
+    uint8_t remoteBits;
+    if (frame < m_remoteCount) {
+        remoteBits = m_remoteInputs[frame % INPUT_RING];
+    } else if (m_remoteCount > 0) {
+        // Held buttons usually stay held; a fresh press is never repeated
+        remoteBits = m_remoteInputs[(m_remoteCount - 1) % INPUT_RING] & ~INPUT_PRESS_EDGES;
+    } else {
+        remoteBits = 0;
+    }
+    m_predicted[frame % INPUT_RING] = remoteBits;
+
+    PlayerInputs inputs{};
+    inputs[local] = unpackInput(m_localInputs[frame % INPUT_RING]);
+    inputs[remote] = unpackInput(remoteBits);
+    match.update(FIXED_DT, inputs);
+
+    // Both inputs were real, and every earlier tick was final before this
+    // one ran, so this state can never be rolled back. Re-simulating from a
+    // checkpoint can pass final ticks again; those were already summed.
+    if (frame < m_remoteCount && m_localSums[frame % INPUT_RING].tick != frame) {
+        m_latestLocalSum = {frame, m_hasher.compute(match).combined()};
+        m_localSums[frame % INPUT_RING] = m_latestLocalSum;
+        compareChecksums(frame);
+    }
+}
+
+void RollbackSession::compareChecksums(uint32_t frame) {
+    const TickChecksum& local = m_localSums[frame % INPUT_RING];
+    const TickChecksum& remote = m_remoteSums[frame % INPUT_RING];
+    if (local.tick != frame || remote.tick != frame) return;
+
+    m_stats.checksumsCompared++;
+    if (local.sum != remote.sum && m_stats.desyncTick == UINT32_MAX) {
+        m_stats.desyncTick = frame;
+        std::cerr << "[Net] Desync at tick " << frame << ": checksum " << std::hex << local.sum
+                  << ", peer " << remote.sum << std::dec << "\n";
+    }
+}
+
+// Frames and match ticks advance together, so checkpoint frames are the
+// match's checkpoint ticks
+GameSnapshot& RollbackSession::snapshotAt(uint32_t checkpoint) {
+    return m_snapshots[(checkpoint / Match::CHECKPOINT_INTERVAL) % m_snapshots.size()];
+}
+
+bool RollbackSession::advance(Match& match, const PlayerInput& local) {
+    if (!m_synchronized) return false;
+    receivePackets();
+
+    if (m_rollbackTo < m_frame) {
+        // Only checkpoint snapshots restore exactly; the ticks between the
+        // checkpoint and the misprediction replay their confirmed inputs
+        uint32_t from = m_rollbackTo - m_rollbackTo % Match::CHECKPOINT_INTERVAL;
+        snapshotAt(from).restore(match);
+        for (uint32_t f = from; f < m_frame; f++) {
+            if (f != from && Match::isCheckpoint(f)) snapshotAt(f).capture(match);
+            simulate(match, f);
+        }
+        uint32_t depth = m_frame - m_rollbackTo;
+        m_stats.rollbacks++;
+        m_stats.rolledBackTicks += m_frame - from;
+        m_stats.maxRollbackDepth = std::max(m_stats.maxRollbackDepth, depth);
+    }
+    m_rollbackTo = UINT32_MAX;
+
+    // Too far ahead of the peer to keep predicting, or of its acks to keep
+    // our inputs in the ring: wait, but keep the peer fed
+    bool aheadOfRemote = m_frame >= m_remoteCount + static_cast<uint32_t>(m_config.maxRollback);
+    bool aheadOfAcks = m_localCount - m_peerAck >= static_cast<uint32_t>(INPUT_RING / 2);
+    if (aheadOfRemote || aheadOfAcks) {
+        m_stats.stalls++;
+        sendInputs();
+        flushOutgoing();
+        return false;
+    }
+
+    m_localInputs[m_localCount % INPUT_RING] = packInput(local);
+    m_localCount++;
+
+    if (Match::isCheckpoint(m_frame)) snapshotAt(m_frame).capture(match);
+    simulate(match, m_frame);
+    m_frame++;
+
+    sendInputs();
+    flushOutgoing();
+    return true;
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include "Match.h"
+#include "GameSnapshot.h"
+#include "StateChecksum.h"
+#include "UdpSocket.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Artificial network conditions applied to outgoing packets, for testing
+// on loopback
+struct NetConditions {
+    int   latencyMs = 0;       // one-way delay added to every packet
+    int   jitterMs = 0;        // extra random delay in [0, jitterMs]
+    float lossPercent = 0.0f;  // chance a packet is dropped outright
+};
+
+struct RollbackConfig {
+    int        localPlayer = 0;  // 0 hosts (picks seed and level), 1 joins
+    uint16_t   localPort = 0;
+    NetAddress peer;
+    int        inputDelay = 2;   // ticks between pressing and simulating
+    int        maxRollback = 8;  // deepest re-simulation before stalling
+    NetConditions conditions;
+};
+
+// Agreed on during the handshake; the host's values win
+struct SessionParams {
+    uint64_t seed = 0;
+    int      levelIndex = 0;
+    bool     wrapAround = false;
+    std::array<CharacterType, 2> characters{CharacterType::Stick, CharacterType::Stick};
+};
+
+// Two-peer rollback netcode (GGPO-style) over UDP. Each peer controls one
+// player of a shared Match.
+//
+// Local inputs are scheduled `inputDelay` ticks ahead and sent redundantly
+// until acknowledged, so loss costs nothing but bandwidth. When the remote
+// input for a tick has not arrived yet, it is predicted by repeating the
+// last one received (minus its press edges). A snapshot is kept for every
+// checkpoint tick (Match::CHECKPOINT_INTERVAL) back past the oldest
+// unconfirmed one; when a late input disagrees with the prediction, the
+// match is restored to the latest checkpoint at or before that tick and
+// re-simulated up to the present. A peer
+// that gets more than `maxRollback` ticks ahead of the last confirmed
+// remote input stalls instead of predicting further.
+//
+// Every tick simulated with confirmed inputs on both sides is final, and its
+// StateChecksum is sent along with the inputs. The first tick whose checksums
+// disagree is reported as a desync.
+//
+// The peers must run the same build with the same weapons and rules.
+// Checkpoint ticks rebuild the Box2D world the same way a restore does (see
+// Match::rebuildWorld), so re-simulated ticks match the originals bit for
+// bit; `StickBrawlSim --check-determinism` tests exactly that.
+class RollbackSession {
+public:
+    static constexpr int INPUT_RING = 128;
+    static constexpr int MAX_ROLLBACK_LIMIT = 30;
+    // A rollback re-simulates from up to CHECKPOINT_INTERVAL - 1 ticks before
+    // the mispredicted one; all of that must still be in the input rings
+    static_assert(MAX_ROLLBACK_LIMIT + static_cast<int>(Match::CHECKPOINT_INTERVAL) + INPUT_RING / 2 <= INPUT_RING,
+                  "input rings too small for the rollback window");
+
+    bool open(const RollbackConfig& config, const SessionParams& localParams);
+    void close();
+
+    // Pumps the network. Call every frame; before synchronization this
+    // drives the handshake.
+    void poll();
+    bool isSynchronized() const { return m_synchronized; }
+    const SessionParams& getParams() const { return m_params; }
+
+    // Advances `match` by one tick with `local` as this peer's input, rolling
+    // back first if late remote inputs invalidated a prediction. Returns
+    // false when the tick was skipped to wait for the peer.
+    bool advance(Match& match, const PlayerInput& local);
+
+    // Seconds since the last packet from the peer
+    float getSilenceSeconds() const;
+
+    int getLocalPlayer() const { return m_config.localPlayer; }
+    uint32_t getFrame() const { return m_frame; }
+    uint32_t getConfirmedFrame() const { return m_remoteCount; }
+
+    struct Stats {
+        uint32_t rollbacks = 0;
+        uint32_t rolledBackTicks = 0;
+        uint32_t maxRollbackDepth = 0;
+        uint32_t stalls = 0;
+        uint32_t packetsSent = 0;
+        uint32_t packetsReceived = 0;
+        uint32_t packetsDropped = 0;  // by the conditioner
+        uint32_t checksumsCompared = 0;
+        uint32_t desyncTick = UINT32_MAX;  // first tick whose checksums disagreed
+    };
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Pending {
+        Clock::time_point deliverAt;
+        std::array<uint8_t, 128> data;
+        size_t size;
+    };
+
+    void sendSync();
+    void sendInputs();
+    void sendPacket(const uint8_t* data, size_t size);
+    void flushOutgoing();
+    void receivePackets();
+    void handleInputs(const uint8_t* data, size_t size);
+    void simulate(Match& match, uint32_t frame);
+    void compareChecksums(uint32_t frame);
+    GameSnapshot& snapshotAt(uint32_t checkpoint);
+
+    RollbackConfig m_config;
+    SessionParams  m_params;
+    UdpSocket      m_socket;
+    bool m_open = false;
+    bool m_synchronized = false;
+    bool m_gotPeerSync = false;
+    bool m_peerHasOurSync = false;
+    Clock::time_point m_lastHeard;
+    Clock::time_point m_lastSyncSent;
+
+    uint32_t m_frame = 0;        // next tick to simulate
+    uint32_t m_localCount = 0;   // local inputs known for ticks [0, m_localCount)
+    uint32_t m_remoteCount = 0;  // remote inputs received for ticks [0, m_remoteCount)
+    uint32_t m_peerAck = 0;      // local ticks the peer has confirmed
+    uint32_t m_rollbackTo = UINT32_MAX;
+
+    std::array<uint8_t, INPUT_RING> m_localInputs{};
+    std::array<uint8_t, INPUT_RING> m_remoteInputs{};
+    std::array<uint8_t, INPUT_RING> m_predicted{};  // remote input each tick was simulated with
+    std::vector<GameSnapshot> m_snapshots;           // state before checkpoint tick f, see snapshotAt
+
+    // Combined checksum of the state after each final tick, by tick % INPUT_RING
+    struct TickChecksum {
+        uint32_t tick = UINT32_MAX;
+        uint32_t sum = 0;
+    };
+    StateHasher m_hasher;
+    std::array<TickChecksum, INPUT_RING> m_localSums{};
+    std::array<TickChecksum, INPUT_RING> m_remoteSums{};
+    TickChecksum m_latestLocalSum;
+
+    std::vector<Pending> m_outgoing;
+    std::mt19937 m_netRng;  // conditioner only, never touches the simulation
+    Stats m_stats;
+};
@@ -13,19 +13,7 @@ bool RulesEngine::loadFromFile(const std::string& path) {
         nlohmann::json j;
         file >> j;
 
-        if (j.contains("max_health"))                  m_rules.maxHealth = j["max_health"];
-        if (j.contains("gravity_x"))                    m_rules.gravityX = j["gravity_x"];
-        if (j.contains("gravity_y"))                    m_rules.gravityY = j["gravity_y"];
-        if (j.contains("round_time_seconds"))           m_rules.roundTimeSeconds = j["round_time_seconds"];
-        if (j.contains("lives_per_player"))             m_rules.livesPerPlayer = j["lives_per_player"];
-        if (j.contains("max_players"))                  m_rules.maxPlayers = j["max_players"];
-        if (j.contains("friendly_fire"))                m_rules.friendlyFire = j["friendly_fire"];
-        if (j.contains("weapon_spawn_interval_seconds"))m_rules.weaponSpawnInterval = j["weapon_spawn_interval_seconds"];
-        if (j.contains("weapon_spawn_max"))             m_rules.weaponSpawnMax = j["weapon_spawn_max"];
-        if (j.contains("fall_death_y"))                 m_rules.fallDeathY = j["fall_death_y"];
-        if (j.contains("respawn_delay_seconds"))        m_rules.respawnDelay = j["respawn_delay_seconds"];
-        if (j.contains("knockback_multiplier"))         m_rules.knockbackMultiplier = j["knockback_multiplier"];
-        if (j.contains("damage_multiplier"))            m_rules.damageMultiplier = j["damage_multiplier"];
+        applyJson(j, m_rules);
 
         std::cout << "[RulesEngine] Loaded rules from: " << path << "\n";
         return true;
@@ -35,3 +23,43 @@ bool RulesEngine::loadFromFile(const std::string& path) {
         return false;
     }
 }
+
+void RulesEngine::applyJson(const nlohmann::json& j, GameRules& rules) {
+    if (j.contains("max_health"))                      rules.maxHealth = j["max_health"];
+    if (j.contains("gravity_x"))                       rules.gravityX = j["gravity_x"];
+    if (j.contains("gravity_y"))                       rules.gravityY = j["gravity_y"];
+    if (j.contains("round_time_seconds"))              rules.roundTimeSeconds = j["round_time_seconds"];
+    if (j.contains("lives_per_player"))                rules.livesPerPlayer = j["lives_per_player"];
+    if (j.contains("max_players"))                     rules.maxPlayers = j["max_players"];
+    if (j.contains("friendly_fire"))                   rules.friendlyFire = j["friendly_fire"];
+    if (j.contains("weapon_spawn_interval_seconds"))   rules.weaponSpawnInterval = j["weapon_spawn_interval_seconds"];
+    if (j.contains("weapon_spawn_max"))                rules.weaponSpawnMax = j["weapon_spawn_max"];
+    if (j.contains("fall_death_y"))                    rules.fallDeathY = j["fall_death_y"];
+    if (j.contains("respawn_delay_seconds"))           rules.respawnDelay = j["respawn_delay_seconds"];
+    if (j.contains("knockback_multiplier"))            rules.knockbackMultiplier = j["knockback_multiplier"];
+    if (j.contains("damage_multiplier"))               rules.damageMultiplier = j["damage_multiplier"];
+    if (j.contains("terrain_fragment_budget"))         rules.terrainFragmentBudget = j["terrain_fragment_budget"];
+    if (j.contains("bitmap_terrain"))                  rules.bitmapTerrain = j["bitmap_terrain"];
+    if (j.contains("max_projectiles"))                 rules.maxProjectiles = j["max_projectiles"];
+}
+
+nlohmann::json RulesEngine::toJson(const GameRules& rules) {
+    nlohmann::json j;
+    j["max_health"]                      = rules.maxHealth;
+    j["gravity_x"]                       = rules.gravityX;
+    j["gravity_y"]                       = rules.gravityY;
+    j["round_time_seconds"]              = rules.roundTimeSeconds;
+    j["lives_per_player"]                = rules.livesPerPlayer;
+    j["max_players"]                     = rules.maxPlayers;
+    j["friendly_fire"]                   = rules.friendlyFire;
+    j["weapon_spawn_interval_seconds"]   = rules.weaponSpawnInterval;
+    j["weapon_spawn_max"]                = rules.weaponSpawnMax;
+    j["fall_death_y"]                    = rules.fallDeathY;
+    j["respawn_delay_seconds"]           = rules.respawnDelay;
+    j["knockback_multiplier"]            = rules.knockbackMultiplier;
+    j["damage_multiplier"]               = rules.damageMultiplier;
+    j["terrain_fragment_budget"]         = rules.terrainFragmentBudget;
+    j["bitmap_terrain"]                  = rules.bitmapTerrain;
+    j["max_projectiles"]                 = rules.maxProjectiles;
+    return j;
+}
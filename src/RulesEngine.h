@@ -16,6 +16,9 @@ struct GameRules {
     float respawnDelay = 2.0f;
     float knockbackMultiplier = 1.0f;
     float damageMultiplier = 1.0f;
+    int   terrainFragmentBudget = 400;  // live platforms before a full re-merge, 0 = off
+    bool  bitmapTerrain = false;        // pixel-mask terrain instead of box platforms
+    int   maxProjectiles = 512;         // pooled bullet bodies per match
 };
 
 class RulesEngine {
@@ -23,6 +26,10 @@ public:
     bool loadFromFile(const std::string& path);
     const GameRules& getRules() const { return m_rules; }
 
+    // Overwrites the fields present in `j`; shared by file loading and replays
+    static void applyJson(const nlohmann::json& j, GameRules& rules);
+    static nlohmann::json toJson(const GameRules& rules);
+
 private:
     GameRules m_rules;
 };
@@ -0,0 +1,391 @@
+// StickBrawlServer — authoritative dedicated server. One process hosts many
+// independent lobbies, each with its own Match, ticked in parallel on a
+// thread pool at the fixed 60 Hz step. Clients join over UDP, send their
+// inputs every tick and receive the lobby's state back.
+#include "Lobby.h"
+#include "Profiler.h"
+#include "Replay.h"
+#include "ServerProtocol.h"
+#include "ThreadPool.h"
+#include "UdpSocket.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Box2D keeps a fixed table of worlds (B2_MAX_WORLDS, 128 by default) and
+// every lobby owns one, so that caps lobbies per process. Larger hosts run
+// one server process per group of cores on separate ports.
+constexpr int MAX_LOBBIES_PER_PROCESS = 128;
+
+// Pause on the round-over state before the next round starts
+constexpr int ROUND_OVER_TICKS = 180;
+constexpr float CLIENT_TIMEOUT_SECONDS = 10.0f;
+
+struct ServerOptions {
+    uint16_t     port = 7777;
+    int          threads = 0;          // 0 = all hardware threads
+    int          botLobbies = 0;       // lobbies filled with 5 bots for load testing
+    int          maxLobbies = MAX_LOBBIES_PER_PROCESS;
+    int          playersToStart = 2;
+    float        reportSeconds = 5.0f;
+    float        durationSeconds = 0.0f;  // 0 = run until killed
+    unsigned int seed = 0;
+    bool         seedGiven = false;
+    std::string  rulesPath = "assets/rules/default.json";
+    std::string  weaponsDir = "assets/weapons";
+    std::string  tracePath;               // non-empty = chrome://tracing JSON, needs --duration
+};
+
+static void printUsage() {
+    std::cout << "Usage: StickBrawlServer [options]\n"
+              << "  --port N          UDP port (default 7777)\n"
+              << "  --threads N       worker threads incl. main, 0 = all cores (default 0)\n"
+              << "  --bot-lobbies N   host N lobbies of " << MAX_PLAYERS << " bots for load testing\n"
+              << "  --max-lobbies N   lobby cap, at most " << MAX_LOBBIES_PER_PROCESS << " (default max)\n"
+              << "  --players N       clients needed before a lobby starts (default 2)\n"
+              << "  --report SEC      stats interval in seconds (default 5)\n"
+              << "  --duration SEC    exit after SEC seconds (default: run forever)\n"
+              << "  --seed N          seed for match seeds and levels\n"
+              << "  --rules PATH      rules JSON (default assets/rules/default.json)\n"
+              << "  --weapons DIR     weapon directory (default assets/weapons)\n"
+              << "  --trace FILE      with --duration, write a chrome://tracing JSON (profiling builds)\n";
+}
+
+static bool parseArgs(int argc, char** argv, ServerOptions& opt) {
+    for (int i = 1; i < argc; i++) {
+        auto next = [&](const char* flag) -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "[Server] Missing value for " << flag << "\n";
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        if (!std::strcmp(argv[i], "--port")) {
+            const char* v = next("--port"); if (!v) return false;
+            opt.port = static_cast<uint16_t>(std::atoi(v));
+        } else if (!std::strcmp(argv[i], "--threads")) {
+            const char* v = next("--threads"); if (!v) return false;
+            opt.threads = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--bot-lobbies")) {
+            const char* v = next("--bot-lobbies"); if (!v) return false;
+            opt.botLobbies = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--max-lobbies")) {
+            const char* v = next("--max-lobbies"); if (!v) return false;
+            opt.maxLobbies = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--players")) {
+            const char* v = next("--players"); if (!v) return false;
+            opt.playersToStart = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--report")) {
+            const char* v = next("--report"); if (!v) return false;
+            opt.reportSeconds = static_cast<float>(std::atof(v));
+        } else if (!std::strcmp(argv[i], "--duration")) {
+            const char* v = next("--duration"); if (!v) return false;
+            opt.durationSeconds = static_cast<float>(std::atof(v));
+        } else if (!std::strcmp(argv[i], "--seed")) {
+            const char* v = next("--seed"); if (!v) return false;
+            opt.seed = static_cast<unsigned int>(std::strtoul(v, nullptr, 10));
+            opt.seedGiven = true;
+        } else if (!std::strcmp(argv[i], "--rules")) {
+            const char* v = next("--rules"); if (!v) return false;
+            opt.rulesPath = v;
+        } else if (!std::strcmp(argv[i], "--weapons")) {
+            const char* v = next("--weapons"); if (!v) return false;
+            opt.weaponsDir = v;
+        } else if (!std::strcmp(argv[i], "--trace")) {
+            const char* v = next("--trace"); if (!v) return false;
+#ifndef STICKBRAWL_PROFILE
+            std::cerr << "[Server] --trace needs a build configured with -DSTICKBRAWL_PROFILE=ON\n";
+            return false;
+#endif
+            opt.tracePath = v;
+        } else {
+            printUsage();
+            return false;
+        }
+    }
+
+    if (opt.maxLobbies < 1 || opt.maxLobbies > MAX_LOBBIES_PER_PROCESS) {
+        std::cerr << "[Server] --max-lobbies must be between 1 and " << MAX_LOBBIES_PER_PROCESS << "\n";
+        return false;
+    }
+    if (!opt.tracePath.empty() && opt.durationSeconds <= 0.0f) {
+        std::cerr << "[Server] --trace needs --duration so the trace can be written on exit\n";
+        return false;
+    }
+    opt.botLobbies = std::clamp(opt.botLobbies, 0, opt.maxLobbies);
+    if (opt.reportSeconds <= 0.0f) opt.reportSeconds = 5.0f;
+    return true;
+}
+
+// ============================================================
+// SERVER
+// ============================================================
+
+class Server {
+public:
+    Server(const ServerOptions& opt, const GameRules& rules, const WeaponFactory& weapons)
+        : m_opt(opt), m_rules(rules), m_weapons(weapons), m_pool(opt.threads), m_rng(opt.seed) {}
+
+    bool init();
+    void run();
+
+private:
+    Lobby* findLobby(uint32_t id);
+    Lobby* createLobby(uint32_t id);
+    void   startLobby(Lobby& lobby);
+    void   receivePackets();
+    void   handleJoin(const NetAddress& from, uint32_t lobbyId, CharacterType character);
+    void   sendJoinAck(const NetAddress& from, uint32_t lobbyId, uint8_t slot);
+    void   manageLobbies();
+    void   report(double elapsedSec);
+
+    const ServerOptions& m_opt;
+    const GameRules&     m_rules;
+    const WeaponFactory& m_weapons;
+    ThreadPool   m_pool;
+    UdpSocket    m_socket;
+    std::mt19937 m_rng;
+
+    std::vector<std::unique_ptr<Lobby>> m_lobbies;
+    uint32_t m_nextLobbyId = 1;
+
+    // Since the last report
+    long long m_frames = 0;
+    long long m_overruns = 0;
+    double    m_frameTotalMs = 0.0;
+    double    m_frameMaxMs = 0.0;
+};
+
+bool Server::init() {
+    if (!m_socket.open(m_opt.port)) return false;
+
+    for (int i = 0; i < m_opt.botLobbies; i++) {
+        Lobby* lobby = createLobby(0);
+        for (int p = 0; p < MAX_PLAYERS; p++)
+            lobby->addBot(static_cast<CharacterType>(m_rng() % CHARACTER_TYPE_COUNT), m_rng());
+        startLobby(*lobby);
+    }
+
+    std::cout << "[Server] Listening on UDP " << m_socket.getLocalPort() << " | "
+              << m_pool.getThreadCount() << " threads | " << m_lobbies.size() << " bot lobbies | "
+              << "max " << m_opt.maxLobbies << " lobbies\n";
+    return true;
+}
+
+Lobby* Server::findLobby(uint32_t id) {
+    for (auto& l : m_lobbies)
+        if (l->getId() == id) return l.get();
+    return nullptr;
+}
+
+Lobby* Server::createLobby(uint32_t id) {
+    if (static_cast<int>(m_lobbies.size()) >= m_opt.maxLobbies) return nullptr;
+    if (id == 0) {
+        while (findLobby(m_nextLobbyId)) m_nextLobbyId++;
+        id = m_nextLobbyId++;
+    }
+    m_lobbies.push_back(std::make_unique<Lobby>(id, m_rules, m_weapons, m_opt.playersToStart));
+    return m_lobbies.back().get();
+}
+
+void Server::startLobby(Lobby& lobby) {
+    uint64_t seed = (static_cast<uint64_t>(m_rng()) << 32) | m_rng();
+    int level = static_cast<int>(m_rng() % static_cast<uint32_t>(Arena::getLevelCount()));
+    lobby.startMatch(seed, level);
+}
+
+void Server::sendJoinAck(const NetAddress& from, uint32_t lobbyId, uint8_t slot) {
+    uint8_t buf[SERVER_HEADER_SIZE + 1];
+    buf[0] = SERVER_MAGIC & 0xFF;
+    buf[1] = SERVER_MAGIC >> 8;
+    buf[2] = static_cast<uint8_t>(ServerPacket::JoinAck);
+    for (int i = 0; i < 4; i++) buf[3 + i] = static_cast<uint8_t>(lobbyId >> (8 * i));
+    buf[7] = slot;
+    m_socket.send(from, buf, sizeof(buf));
+}
+
+// Lobby id 0 means "any": the first lobby still gathering players, or a new one
+void Server::handleJoin(const NetAddress& from, uint32_t lobbyId, CharacterType character) {
+    Lobby* lobby = nullptr;
+    if (lobbyId != 0) {
+        lobby = findLobby(lobbyId);
+        if (!lobby) lobby = createLobby(lobbyId);
+    } else {
+        for (auto& l : m_lobbies) {
+            if (l->isAcceptingPlayers() && l->hasClients()) { lobby = l.get(); break; }
+        }
+        if (!lobby) lobby = createLobby(0);
+    }
+
+    int slot = lobby ? lobby->addClient(from, character) : -1;
+    sendJoinAck(from, lobby ? lobby->getId() : lobbyId,
+                slot >= 0 ? static_cast<uint8_t>(slot) : SERVER_SLOT_NONE);
+}
+
+void Server::receivePackets() {
+    uint8_t buf[256];
+    NetAddress from;
+    int size;
+    while ((size = m_socket.receive(buf, sizeof(buf), from)) >= SERVER_HEADER_SIZE) {
+        if ((buf[0] | (buf[1] << 8)) != SERVER_MAGIC) continue;
+        auto type = static_cast<ServerPacket>(buf[2]);
+        uint32_t lobbyId = buf[3] | (buf[4] << 8) | (buf[5] << 16) | (static_cast<uint32_t>(buf[6]) << 24);
+        const uint8_t* body = buf + SERVER_HEADER_SIZE;
+        int bodySize = size - SERVER_HEADER_SIZE;
+
+        switch (type) {
+            case ServerPacket::Join:
+                if (bodySize >= 1)
+                    handleJoin(from, lobbyId, static_cast<CharacterType>(body[0] % CHARACTER_TYPE_COUNT));
+                break;
+            case ServerPacket::Input:
+                if (bodySize >= 6) {
+                    if (Lobby* lobby = findLobby(lobbyId)) {
+                        lobby->setInput(body[0], from, unpackInput(body[5]));
+                        if (bodySize >= 8)
+                            lobby->acknowledgeState(body[0], from, static_cast<uint16_t>(body[6] | (body[7] << 8)));
+                    }
+                }
+                break;
+            case ServerPacket::Leave:
+                if (bodySize >= 1) {
+                    if (Lobby* lobby = findLobby(lobbyId)) lobby->removeClient(body[0], from);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+// Starts, restarts and retires lobbies; runs between ticks on the main thread
+void Server::manageLobbies() {
+    for (size_t i = 0; i < m_lobbies.size();) {
+        Lobby& lobby = *m_lobbies[i];
+        lobby.dropSilentClients(CLIENT_TIMEOUT_SECONDS);
+        bool empty = lobby.getMemberCount() == 0;
+
+        if (empty) {
+            m_lobbies.erase(m_lobbies.begin() + static_cast<std::ptrdiff_t>(i));
+            continue;
+        }
+        if (lobby.isRunning() && lobby.getRoundOverTicks() >= ROUND_OVER_TICKS) {
+            lobby.endMatch();
+            if (lobby.isReadyToStart()) startLobby(lobby);
+        } else if (lobby.isReadyToStart()) {
+            startLobby(lobby);
+        }
+        i++;
+    }
+}
+
+void Server::report(double elapsedSec) {
+    std::vector<std::pair<double, uint32_t>> lobbyMeans;  // mean tick us, lobby id
+    double worstUs = 0.0;
+    double sumUs = 0.0;
+    int ticks = 0, players = 0, running = 0;
+    for (auto& l : m_lobbies) {
+        Lobby::Timing t = l->takeTiming();
+        players += l->getMemberCount();
+        if (l->isRunning()) running++;
+        if (t.ticks == 0) continue;
+        lobbyMeans.push_back({t.totalUs / t.ticks, l->getId()});
+        worstUs = std::max(worstUs, t.maxUs);
+        sumUs += t.totalUs;
+        ticks += t.ticks;
+    }
+    std::sort(lobbyMeans.begin(), lobbyMeans.end(), std::greater<>());
+
+    double frameMean = m_frames > 0 ? m_frameTotalMs / static_cast<double>(m_frames) : 0.0;
+    std::cout << std::fixed << std::setprecision(2)
+              << "[Server] " << m_lobbies.size() << " lobbies (" << running << " running), "
+              << players << " players | frame mean " << frameMean << " ms, max " << m_frameMaxMs
+              << " ms of " << FIXED_DT * 1000.0f << " | " << m_overruns << " overruns in "
+              << std::setprecision(1) << elapsedSec << " s\n" << std::setprecision(1)
+              << "[Server] lobby tick mean " << (ticks > 0 ? sumUs / ticks : 0.0) << " us, max "
+              << worstUs << " us";
+    if (!lobbyMeans.empty()) {
+        std::cout << " | slowest:";
+        for (size_t i = 0; i < lobbyMeans.size() && i < 3; i++)
+            std::cout << " #" << lobbyMeans[i].second << " " << lobbyMeans[i].first << " us";
+    }
+    std::cout << "\n";
+
+    m_frames = 0;
+    m_overruns = 0;
+    m_frameTotalMs = 0.0;
+    m_frameMaxMs = 0.0;
+}
+
+void Server::run() {
+    using Clock = std::chrono::steady_clock;
+    const auto tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(FIXED_DT));
+    const auto start = Clock::now();
+    auto nextTick = start;
+    auto lastReport = start;
+
+    for (;;) {
+        auto frameStart = Clock::now();
+        receivePackets();
+        manageLobbies();
+        m_pool.parallelFor(static_cast<int>(m_lobbies.size()),
+                           [&](int i) { m_lobbies[static_cast<size_t>(i)]->tick(m_socket); });
+
+        auto now = Clock::now();
+        double frameMs = std::chrono::duration<double, std::milli>(now - frameStart).count();
+        m_frames++;
+        m_frameTotalMs += frameMs;
+        m_frameMaxMs = std::max(m_frameMaxMs, frameMs);
+
+        double sinceReport = std::chrono::duration<double>(now - lastReport).count();
+        if (sinceReport >= m_opt.reportSeconds) {
+            report(sinceReport);
+            lastReport = now;
+        }
+        if (m_opt.durationSeconds > 0.0f &&
+            std::chrono::duration<double>(now - start).count() >= m_opt.durationSeconds) break;
+
+        nextTick += tickDuration;
+        if (now > nextTick) {
+            // Behind schedule: count it and re-anchor rather than bursting to catch up
+            m_overruns++;
+            nextTick = now;
+        } else {
+            std::this_thread::sleep_until(nextTick);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    ServerOptions opt;
+    if (!parseArgs(argc, argv, opt)) return 1;
+    if (!opt.seedGiven) opt.seed = std::random_device{}();
+
+    RulesEngine rulesEngine;
+    rulesEngine.loadFromFile(opt.rulesPath);
+    WeaponFactory weaponFactory;
+    weaponFactory.loadWeaponsFromDirectory(opt.weaponsDir);
+
+    Server server(opt, rulesEngine.getRules(), weaponFactory);
+    if (!server.init()) return 1;
+#ifdef STICKBRAWL_PROFILE
+    if (!opt.tracePath.empty()) {
+        PROFILE_THREAD_NAME("server main");
+        Profiler::beginTrace();
+    }
+#endif
+    server.run();
+#ifdef STICKBRAWL_PROFILE
+    if (!opt.tracePath.empty() && !Profiler::writeTrace(opt.tracePath)) return 1;
+#endif
+    return 0;
+}
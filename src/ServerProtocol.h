@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+
+// Client <-> StickBrawlServer datagrams. Little-endian; every packet starts
+// with u16 SERVER_MAGIC, u8 ServerPacket type, u32 lobby id.
+//
+//   Join     (c->s)  u8 character
+//   JoinAck  (s->c)  u8 slot (0xFF = lobby full or already running)
+//   Input    (c->s)  u8 slot  u32 clientTick  u8 packed input (packInput)
+//                    [u16 seq of the newest State packet received]
+//   State    (s->c)  bit-packed, delta-compressed ReplicatedState (Replication.h)
+//   Leave    (c->s)  u8 slot
+constexpr uint16_t SERVER_MAGIC = 0x5353;  // "SS"
+constexpr uint8_t  SERVER_SLOT_NONE = 0xFF;
+
+enum class ServerPacket : uint8_t {
+    Join = 1,
+    JoinAck = 2,
+    Input = 3,
+    State = 4,
+    Leave = 5,
+};
+
+constexpr int SERVER_HEADER_SIZE = 7;
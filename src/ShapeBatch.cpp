@@ -0,0 +1,146 @@
+#include "ShapeBatch.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace {
+
+constexpr int MAX_CIRCLE_POINTS = 64;
+
+// Unit circle with sf::CircleShape's point order: point 0 at the top, then
+// clockwise on screen. Built on first use for each point count.
+const std::vector<sf::Vector2f>& unitCircle(int points) {
+    static std::array<std::vector<sf::Vector2f>, MAX_CIRCLE_POINTS + 1> tables;
+    points = std::clamp(points, 3, MAX_CIRCLE_POINTS);
+    auto& table = tables[static_cast<size_t>(points)];
+    if (table.empty()) {
+        table.resize(static_cast<size_t>(points));
+        for (int i = 0; i < points; i++) {
+            float angle = static_cast<float>(i) * 2.0f * 3.14159265f / static_cast<float>(points) - 3.14159265f / 2.0f;
+            table[static_cast<size_t>(i)] = {std::cos(angle), std::sin(angle)};
+        }
+    }
+    return table;
+}
+
+sf::Vector2f edgeNormal(sf::Vector2f a, sf::Vector2f b) {
+    sf::Vector2f n = {a.y - b.y, b.x - a.x};
+    float len = std::sqrt(n.x * n.x + n.y * n.y);
+    return len > 0.0f ? sf::Vector2f{n.x / len, n.y / len} : n;
+}
+
+} // namespace
+
+void ShapeBatch::circle(sf::Vector2f center, float radius, sf::Color fill, int points,
+                        sf::Color outline, float outlineThickness) {
+    const auto& unit = unitCircle(points);
+    m_points.resize(unit.size());
+    for (size_t i = 0; i < unit.size(); i++)
+        m_points[i] = {center.x + unit[i].x * radius, center.y + unit[i].y * radius};
+    fan(m_points.data(), m_points.size(), fill);
+    outlineRing(m_points.data(), m_points.size(), outline, outlineThickness);
+}
+
+void ShapeBatch::ellipse(sf::Vector2f center, float radiusX, float radiusY, sf::Color fill,
+                         sf::Color outline, float outlineThickness) {
+    const auto& unit = unitCircle(30);
+    m_points.resize(unit.size());
+    for (size_t i = 0; i < unit.size(); i++)
+        m_points[i] = {center.x + unit[i].x * radiusX, center.y + unit[i].y * radiusY};
+    fan(m_points.data(), m_points.size(), fill);
+    outlineRing(m_points.data(), m_points.size(), outline, outlineThickness);
+}
+
+void ShapeBatch::rect(sf::Vector2f position, sf::Vector2f size, sf::Vector2f origin, float rotationDegrees,
+                      sf::Color fill, sf::Color outline, float outlineThickness) {
+    float rad = rotationDegrees * 3.14159265f / 180.0f;
+    float c = std::cos(rad), s = std::sin(rad);
+    const sf::Vector2f local[4] = {{0.0f, 0.0f}, {size.x, 0.0f}, {size.x, size.y}, {0.0f, size.y}};
+    m_points.resize(4);
+    for (size_t i = 0; i < 4; i++) {
+        float x = local[i].x - origin.x, y = local[i].y - origin.y;
+        m_points[i] = {position.x + x * c - y * s, position.y + x * s + y * c};
+    }
+    fan(m_points.data(), 4, fill);
+    outlineRing(m_points.data(), 4, outline, outlineThickness);
+}
+
+void ShapeBatch::convex(std::initializer_list<sf::Vector2f> points, sf::Color fill,
+                        sf::Color outline, float outlineThickness) {
+    convex(points.begin(), points.size(), fill, outline, outlineThickness);
+}
+
+void ShapeBatch::convex(const sf::Vector2f* points, size_t count, sf::Color fill,
+                        sf::Color outline, float outlineThickness) {
+    fan(points, count, fill);
+    outlineRing(points, count, outline, outlineThickness);
+}
+
+void ShapeBatch::line(sf::Vector2f a, sf::Vector2f b, sf::Color colorA, sf::Color colorB) {
+    float dx = b.x - a.x, dy = b.y - a.y;
+    float len = std::sqrt(dx * dx + dy * dy);
+    if (len <= 0.0f) return;
+    sf::Vector2f half = {-dy / len * 0.5f, dx / len * 0.5f};
+
+    sf::Vertex a0{{a.x + half.x, a.y + half.y}, colorA};
+    sf::Vertex a1{{a.x - half.x, a.y - half.y}, colorA};
+    sf::Vertex b0{{b.x + half.x, b.y + half.y}, colorB};
+    sf::Vertex b1{{b.x - half.x, b.y - half.y}, colorB};
+    m_vertices.insert(m_vertices.end(), {a0, a1, b0, b0, a1, b1});
+}
+
+void ShapeBatch::lineStrip(const sf::Vertex* vertices, size_t count) {
+    for (size_t i = 1; i < count; i++)
+        line(vertices[i - 1].position, vertices[i].position, vertices[i - 1].color, vertices[i].color);
+}
+
+void ShapeBatch::draw(sf::RenderTarget& target, const sf::BlendMode& blend) const {
+    if (m_vertices.empty()) return;
+    sf::RenderStates states;
+    states.blendMode = blend;
+    target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+}
+
+void ShapeBatch::triangle(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Color color) {
+    m_vertices.insert(m_vertices.end(), {sf::Vertex{a, color}, sf::Vertex{b, color}, sf::Vertex{c, color}});
+}
+
+void ShapeBatch::fan(const sf::Vector2f* points, size_t count, sf::Color fill) {
+    if (fill.a == 0 || count < 3) return;
+    for (size_t i = 1; i + 1 < count; i++) triangle(points[0], points[i], points[i + 1], fill);
+}
+
+// sf::Shape's outline: each point moves out along the mitred average of its
+// two edge normals, so every edge ends up exactly `thickness` further out
+void ShapeBatch::outlineRing(const sf::Vector2f* points, size_t count, sf::Color color, float thickness) {
+    if (color.a == 0 || thickness == 0.0f || count < 3) return;
+
+    sf::Vector2f centroid = {0.0f, 0.0f};
+    for (size_t i = 0; i < count; i++) { centroid.x += points[i].x; centroid.y += points[i].y; }
+    centroid.x /= static_cast<float>(count);
+    centroid.y /= static_cast<float>(count);
+
+    auto outward = [&](sf::Vector2f n, sf::Vector2f p) {
+        return (n.x * (centroid.x - p.x) + n.y * (centroid.y - p.y) > 0.0f) ? sf::Vector2f{-n.x, -n.y} : n;
+    };
+    auto outer = [&](size_t i) {
+        sf::Vector2f p0 = points[(i + count - 1) % count];
+        sf::Vector2f p1 = points[i];
+        sf::Vector2f p2 = points[(i + 1) % count];
+        sf::Vector2f n1 = outward(edgeNormal(p0, p1), p1);
+        sf::Vector2f n2 = outward(edgeNormal(p1, p2), p1);
+        float factor = 1.0f + (n1.x * n2.x + n1.y * n2.y);
+        if (factor < 1e-3f) factor = 1.0f;  // hairpin; fall back to the bare sum
+        return sf::Vector2f{p1.x + (n1.x + n2.x) / factor * thickness, p1.y + (n1.y + n2.y) / factor * thickness};
+    };
+
+    sf::Vector2f firstOuter = outer(0);
+    sf::Vector2f prevOuter = firstOuter;
+    for (size_t i = 0; i < count; i++) {
+        size_t next = (i + 1) % count;
+        sf::Vector2f nextOuter = next == 0 ? firstOuter : outer(next);
+        triangle(points[i], prevOuter, points[next], color);
+        triangle(points[next], prevOuter, nextOuter, color);
+        prevOuter = nextOuter;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+// Immediate-mode triangle batch standing in for per-shape sf::Shape draws.
+// Callers push circles, rects, polygons and lines each frame, then draw()
+// submits them all in one call; draw order within a batch is push order.
+// Circles come from unit-circle tables built once per point count, so
+// pushing one is multiplies and adds with no sin/cos. Lines become 1 px
+// quads, matching sf::PrimitiveType::Lines. Outlines grow outward like
+// sf::Shape's. The vertex buffer is cleared but never shrunk, so a warm
+// batch allocates nothing. Use one batch per blend mode.
+class ShapeBatch {
+public:
+    void clear() { m_vertices.clear(); }
+    size_t getVertexCount() const { return m_vertices.size(); }
+
+    void circle(sf::Vector2f center, float radius, sf::Color fill, int points = 30,
+                sf::Color outline = sf::Color::Transparent, float outlineThickness = 0.0f);
+    void ellipse(sf::Vector2f center, float radiusX, float radiusY, sf::Color fill,
+                 sf::Color outline = sf::Color::Transparent, float outlineThickness = 0.0f);
+
+    // Same placement rules as sf::RectangleShape: `origin` is in local
+    // coordinates, rotation is about the origin
+    void rect(sf::Vector2f position, sf::Vector2f size, sf::Vector2f origin, float rotationDegrees,
+              sf::Color fill, sf::Color outline = sf::Color::Transparent, float outlineThickness = 0.0f);
+
+    // Convex polygon, points in order
+    void convex(std::initializer_list<sf::Vector2f> points, sf::Color fill,
+                sf::Color outline = sf::Color::Transparent, float outlineThickness = 0.0f);
+    void convex(const sf::Vector2f* points, size_t count, sf::Color fill,
+                sf::Color outline = sf::Color::Transparent, float outlineThickness = 0.0f);
+
+    void line(sf::Vector2f a, sf::Vector2f b, sf::Color color) { line(a, b, color, color); }
+    void line(sf::Vector2f a, sf::Vector2f b, sf::Color colorA, sf::Color colorB);
+    void lineStrip(const sf::Vertex* vertices, size_t count);
+
+    void draw(sf::RenderTarget& target, const sf::BlendMode& blend = sf::BlendAlpha) const;
+
+private:
+    void fan(const sf::Vector2f* points, size_t count, sf::Color fill);
+    void outlineRing(const sf::Vector2f* points, size_t count, sf::Color color, float thickness);
+    void triangle(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Color color);
+
+    std::vector<sf::Vertex>   m_vertices;
+    std::vector<sf::Vector2f> m_points;   // shape outline scratch
+};
@@ -0,0 +1,677 @@
+// StickBrawlSim — headless bot-vs-bot match runner for balance testing.
+// Ticks Match::update at the fixed step as fast as the CPU allows; no window,
+// no renderer, no SFML libraries linked.
+#include "Match.h"
+#include "BotController.h"
+#include "Replay.h"
+#include "RollbackSession.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct SimOptions {
+    int          matches = 1;
+    int          players = 4;
+    int          level = -1;          // -1 = random per match
+    unsigned int seed = 0;
+    bool         seedGiven = false;
+    bool         wrapAround = false;
+    bool         checkDeterminism = false;
+    std::string  rulesPath = "assets/rules/default.json";
+    std::string  weaponsDir = "assets/weapons";
+    std::string  recordDir;           // empty = don't record
+    std::string  replayPath;          // non-empty = play back instead of simulating
+    long long    seekTick = -1;       // replay: jump here via keyframes before playing
+    std::string  bisectA, bisectB;    // replays to search for the first desync
+    std::string  tracePath;           // non-empty = write a chrome://tracing JSON of the run
+
+    // Rollback loopback harness: one bot per process, two processes
+    bool           net = false;
+    RollbackConfig netConfig;
+};
+
+static void printUsage() {
+    std::cout << "Usage: StickBrawlSim [options]\n"
+              << "  --matches N      number of matches to run (default 1)\n"
+              << "  --players N      bots per match, 2.." << MAX_PLAYERS << " (default 4)\n"
+              << "  --level N        level index, -1 = random (default -1)\n"
+              << "  --seed N         seed for character/level/bot choices\n"
+              << "  --wrap           enable wrap-around mode\n"
+              << "  --check-determinism  run every match twice and compare end states, then\n"
+              << "                   check that restoring snapshots re-simulates bit-exactly\n"
+              << "  --rules PATH     rules JSON (default assets/rules/default.json)\n"
+              << "  --weapons DIR    weapon directory (default assets/weapons)\n"
+              << "  --record DIR     save every match as a replay in DIR\n"
+              << "  --replay FILE    play back a recorded match at unlimited speed\n"
+              << "  --seek TICK      with --replay, jump to TICK through the nearest keyframe first\n"
+              << "  --bisect A [B]   find the first tick where replay A stops matching B\n"
+              << "                   (or, alone, this build's re-simulation of A)\n"
+              << "  --net-port N     run one side of a rollback session on UDP port N\n"
+              << "  --net-peer ADDR  the other side, e.g. 127.0.0.1:7001\n"
+              << "  --net-player N   1 hosts (its seed/level win), 2 joins\n"
+              << "  --delay N        input delay in ticks (default 2)\n"
+              << "  --max-rollback N deepest rollback before stalling (default 8)\n"
+              << "  --latency MS     add one-way latency to outgoing packets\n"
+              << "  --jitter MS      add up to MS random delay per packet\n"
+              << "  --loss PCT       drop PCT% of outgoing packets\n"
+              << "  --trace FILE     write a chrome://tracing JSON of every tick (profiling builds)\n";
+}
+
+static bool parseArgs(int argc, char** argv, SimOptions& opt) {
+    for (int i = 1; i < argc; i++) {
+        auto next = [&](const char* flag) -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "[Sim] Missing value for " << flag << "\n";
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        if (!std::strcmp(argv[i], "--matches")) {
+            const char* v = next("--matches"); if (!v) return false;
+            opt.matches = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--players")) {
+            const char* v = next("--players"); if (!v) return false;
+            opt.players = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--level")) {
+            const char* v = next("--level"); if (!v) return false;
+            opt.level = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--seed")) {
+            const char* v = next("--seed"); if (!v) return false;
+            opt.seed = static_cast<unsigned int>(std::strtoul(v, nullptr, 10));
+            opt.seedGiven = true;
+        } else if (!std::strcmp(argv[i], "--wrap")) {
+            opt.wrapAround = true;
+        } else if (!std::strcmp(argv[i], "--check-determinism")) {
+            opt.checkDeterminism = true;
+        } else if (!std::strcmp(argv[i], "--rules")) {
+            const char* v = next("--rules"); if (!v) return false;
+            opt.rulesPath = v;
+        } else if (!std::strcmp(argv[i], "--weapons")) {
+            const char* v = next("--weapons"); if (!v) return false;
+            opt.weaponsDir = v;
+        } else if (!std::strcmp(argv[i], "--record")) {
+            const char* v = next("--record"); if (!v) return false;
+            opt.recordDir = v;
+        } else if (!std::strcmp(argv[i], "--replay")) {
+            const char* v = next("--replay"); if (!v) return false;
+            opt.replayPath = v;
+        } else if (!std::strcmp(argv[i], "--net-port")) {
+            const char* v = next("--net-port"); if (!v) return false;
+            opt.net = true;
+            opt.netConfig.localPort = static_cast<uint16_t>(std::atoi(v));
+        } else if (!std::strcmp(argv[i], "--net-peer")) {
+            const char* v = next("--net-peer"); if (!v) return false;
+            if (!NetAddress::parse(v, opt.netConfig.peer)) {
+                std::cerr << "[Sim] Bad --net-peer address: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(argv[i], "--net-player")) {
+            const char* v = next("--net-player"); if (!v) return false;
+            opt.netConfig.localPlayer = std::atoi(v) - 1;
+        } else if (!std::strcmp(argv[i], "--delay")) {
+            const char* v = next("--delay"); if (!v) return false;
+            opt.netConfig.inputDelay = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--max-rollback")) {
+            const char* v = next("--max-rollback"); if (!v) return false;
+            opt.netConfig.maxRollback = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--latency")) {
+            const char* v = next("--latency"); if (!v) return false;
+            opt.netConfig.conditions.latencyMs = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--jitter")) {
+            const char* v = next("--jitter"); if (!v) return false;
+            opt.netConfig.conditions.jitterMs = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--loss")) {
+            const char* v = next("--loss"); if (!v) return false;
+            opt.netConfig.conditions.lossPercent = static_cast<float>(std::atof(v));
+        } else if (!std::strcmp(argv[i], "--bisect")) {
+            const char* v = next("--bisect"); if (!v) return false;
+            opt.bisectA = v;
+            if (i + 1 < argc && std::strncmp(argv[i + 1], "--", 2) != 0) opt.bisectB = argv[++i];
+        } else if (!std::strcmp(argv[i], "--trace")) {
+            const char* v = next("--trace"); if (!v) return false;
+#ifndef STICKBRAWL_PROFILE
+            std::cerr << "[Sim] --trace needs a build configured with -DSTICKBRAWL_PROFILE=ON\n";
+            return false;
+#endif
+            opt.tracePath = v;
+        } else if (!std::strcmp(argv[i], "--seek")) {
+            const char* v = next("--seek"); if (!v) return false;
+            opt.seekTick = std::atoll(v);
+        } else {
+            printUsage();
+            return false;
+        }
+    }
+
+    if (opt.players < 2 || opt.players > MAX_PLAYERS) {
+        std::cerr << "[Sim] --players must be between 2 and " << MAX_PLAYERS << "\n";
+        return false;
+    }
+    if (opt.net && (opt.netConfig.peer.port == 0 ||
+                    opt.netConfig.localPlayer < 0 || opt.netConfig.localPlayer > 1)) {
+        std::cerr << "[Sim] --net-port needs --net-peer and --net-player 1|2\n";
+        return false;
+    }
+    if (opt.matches < 1) opt.matches = 1;
+    return true;
+}
+
+// FNV-1a over the raw bits of the end-of-match state. Any divergence between
+// two runs of the same seed and inputs shows up as a different value.
+static uint64_t fingerprint(const Match& match) {
+    uint64_t h = 1469598103934665603ULL;
+    auto mix = [&](const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) { h ^= bytes[i]; h *= 1099511628211ULL; }
+    };
+    float timer = match.getRoundTimer();
+    mix(&timer, sizeof(timer));
+    for (const auto& p : match.getPlayers()) {
+        b2Vec2 pos = p->getPosition();
+        float health = p->getHealth();
+        int lives = p->getLives();
+        mix(&pos, sizeof(pos));
+        mix(&health, sizeof(health));
+        mix(&lives, sizeof(lives));
+    }
+    int projectiles = static_cast<int>(match.getProjectiles().getActive().size());
+    int platforms = match.getArena().getPlatformCount();
+    mix(&projectiles, sizeof(projectiles));
+    mix(&platforms, sizeof(platforms));
+    return h;
+}
+
+struct MatchResult {
+    long long ticks = 0;
+    int       winner = -1;
+    uint64_t  fingerprint = 0;
+    std::vector<StateChecksum> trace;  // state before every tick, when asked for
+};
+
+// Comma-separated sections that differ, e.g. "P2, projectiles"
+static std::string describeMismatch(const StateChecksum& a, const StateChecksum& b) {
+    if (a.sectionCount != b.sectionCount) return "player count";
+    std::string out;
+    for (int s = 0; s < a.sectionCount; s++) {
+        if (a.sections[s] == b.sections[s]) continue;
+        if (!out.empty()) out += ", ";
+        out += StateChecksum::sectionName(s);
+    }
+    return out;
+}
+
+static MatchResult runMatch(const RulesEngine& rulesEngine, const WeaponFactory& weaponFactory,
+                            int level, const std::vector<PlayerSetup>& setups,
+                            const std::vector<unsigned int>& botSeeds, bool wrapAround,
+                            uint64_t matchSeed, ReplayWriter* recorder, bool trace) {
+    std::vector<BotController> bots;
+    for (size_t i = 0; i < botSeeds.size(); i++)
+        bots.emplace_back(static_cast<int>(i), botSeeds[i]);
+
+    auto match = std::make_unique<Match>(rulesEngine.getRules(), weaponFactory);
+    match->start(level, setups, wrapAround, matchSeed);
+
+    if (recorder) {
+        ReplayHeader header;
+        header.seed = matchSeed;
+        header.levelIndex = level;
+        header.wrapAround = wrapAround;
+        header.players = setups;
+        header.rules = rulesEngine.getRules();
+        recorder->begin(header);
+    }
+
+    PlayerInputs inputs;
+    MatchResult result;
+    StateHasher hasher;
+    while (!match->isRoundOver()) {
+        for (size_t i = 0; i < bots.size(); i++) inputs[i] = bots[i].think(*match);
+        if (recorder) recorder->record(inputs, *match);
+        if (trace) result.trace.push_back(hasher.compute(*match));
+        match->update(FIXED_DT, inputs);
+        result.ticks++;
+    }
+    result.winner = match->getWinner();
+    result.fingerprint = fingerprint(*match);
+    return result;
+}
+
+// Rollback check. From every RESTORE_INTERVAL-th tick (a checkpoint, like
+// every tick rollback restores to) the match runs
+// RESTORE_TICKS ticks straight, is restored to the snapshot taken at the
+// start, and re-simulates the same inputs. Both paths must agree on every
+// tick's checksum and on the full state blob at the end. Returns false (and
+// says where) on the first difference.
+static bool checkRestore(const RulesEngine& rulesEngine, const WeaponFactory& weaponFactory,
+                         int level, const std::vector<PlayerSetup>& setups,
+                         const std::vector<unsigned int>& botSeeds, bool wrapAround, uint64_t matchSeed) {
+    constexpr int RESTORE_INTERVAL = 60;
+    constexpr int RESTORE_TICKS = RollbackSession::MAX_ROLLBACK_LIMIT;
+    static_assert(RESTORE_INTERVAL % Match::CHECKPOINT_INTERVAL == 0, "restores must start on checkpoints");
+
+    std::vector<BotController> bots;
+    for (size_t i = 0; i < botSeeds.size(); i++)
+        bots.emplace_back(static_cast<int>(i), botSeeds[i]);
+
+    auto match = std::make_unique<Match>(rulesEngine.getRules(), weaponFactory);
+    match->start(level, setups, wrapAround, matchSeed);
+
+    GameSnapshot snapshot;
+    StateHasher hasher;
+    PlayerInputs inputs;
+    std::vector<PlayerInputs> window;
+    std::vector<StateChecksum> straight;
+    std::vector<uint8_t> straightState, restoredState;
+    auto tickStraight = [&]() {
+        for (size_t i = 0; i < bots.size(); i++) inputs[i] = bots[i].think(*match);
+        match->update(FIXED_DT, inputs);
+    };
+
+    while (!match->isRoundOver()) {
+        snapshot.capture(*match);
+        uint32_t from = snapshot.getTick();
+        window.clear();
+        straight.clear();
+        for (int t = 0; t < RESTORE_TICKS && !match->isRoundOver(); t++) {
+            tickStraight();
+            window.push_back(inputs);
+            straight.push_back(hasher.compute(*match));
+        }
+        match->saveState(straightState);
+
+        if (!snapshot.restore(*match)) {
+            std::cerr << "[Sim]   restore of tick " << from << " failed\n";
+            return false;
+        }
+        for (size_t t = 0; t < window.size(); t++) {
+            match->update(FIXED_DT, window[t]);
+            StateChecksum cs = hasher.compute(*match);
+            if (cs != straight[t]) {
+                std::cerr << "[Sim]   restored from tick " << from << ", differs after tick "
+                          << (from + t + 1) << ": " << describeMismatch(straight[t], cs) << "\n";
+                return false;
+            }
+        }
+        match->saveState(restoredState);
+        if (restoredState != straightState) {
+            std::cerr << "[Sim]   restored from tick " << from << ", state blob differs after tick "
+                      << (from + window.size()) << "\n";
+            return false;
+        }
+
+        for (int t = RESTORE_TICKS; t < RESTORE_INTERVAL && !match->isRoundOver(); t++) tickStraight();
+    }
+    return true;
+}
+
+// Feeds a recorded input stream through a fresh Match as fast as possible.
+// The rules come from the replay; weapons must match the recording's set.
+static int runReplay(const SimOptions& opt, const WeaponFactory& weaponFactory) {
+    ReplayReader reader;
+    if (!reader.load(opt.replayPath)) return 1;
+    const ReplayHeader& header = reader.getHeader();
+
+    auto match = std::make_unique<Match>(header.rules, weaponFactory);
+    match->start(header.levelIndex, header.players, header.wrapAround, header.seed);
+
+    using Clock = std::chrono::steady_clock;
+    if (opt.seekTick >= 0) {
+        auto s0 = Clock::now();
+        uint32_t target = static_cast<uint32_t>(std::min<long long>(opt.seekTick, reader.getTickCount()));
+        if (!reader.seek(*match, target)) {
+            std::cerr << "[Sim] seek to tick " << target << " failed\n";
+            return 2;
+        }
+        double seekMs = std::chrono::duration<double, std::milli>(Clock::now() - s0).count();
+        std::cout << "[Sim] seek to tick " << target << " (" << reader.getKeyframeCount()
+                  << " keyframes) took " << std::fixed << std::setprecision(2) << seekMs << " ms\n";
+    }
+
+    // Every tick is checked against the recorded checksum; the first
+    // mismatch is where this build stopped reproducing the recording. The
+    // sections that differ are named at the first tick that recorded them.
+    PlayerInputs inputs;
+    long long ticks = 0;
+    StateHasher hasher;
+    StateChecksum recordedSections;
+    uint32_t recorded = 0;
+    long long desyncTick = -1;
+    bool sectionsShown = false;
+    auto t0 = Clock::now();
+    while (!match->isRoundOver()) {
+        uint32_t tick = reader.getTick();
+        if (desyncTick < 0 && reader.getChecksum(tick, recorded)) {
+            StateChecksum local = hasher.compute(*match);
+            if (local.combined() != recorded) {
+                desyncTick = tick;
+                std::cerr << "[Sim] desync before tick " << tick << "\n";
+            }
+        }
+        if (desyncTick >= 0 && !sectionsShown && reader.getSections(tick, recordedSections)) {
+            StateChecksum local = hasher.compute(*match);
+            std::cerr << "[Sim]   differing at tick " << tick << ": "
+                      << describeMismatch(recordedSections, local) << "\n";
+            sectionsShown = true;
+        }
+        if (!reader.next(inputs)) break;
+        match->update(FIXED_DT, inputs);
+        ticks++;
+    }
+    double wallSec = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    std::cout << "[Sim] replay | " << Arena::getLevelName(header.levelIndex) << " | "
+              << reader.getTick() << "/" << reader.getTickCount() << " ticks | " << std::fixed
+              << std::setprecision(2) << wallSec * 1000.0 << " ms | " << std::setprecision(0)
+              << (wallSec > 0.0 ? ticks / wallSec : 0.0) << " ticks/s | winner: ";
+    if (match->getWinner() >= 0) std::cout << "P" << (match->getWinner() + 1);
+    else                         std::cout << "draw";
+    std::cout << " | fingerprint " << std::hex << fingerprint(*match) << std::dec << "\n";
+
+    if (reader.getTick() != reader.getTickCount()) {
+        std::cerr << "[Sim] replay ended after " << reader.getTick() << " of " << reader.getTickCount()
+                  << " recorded ticks; the simulation has diverged from the recording\n";
+        return 2;
+    }
+    return desyncTick >= 0 ? 2 : 0;
+}
+
+// Finds the first tick where two recordings of the same match disagree, e.g.
+// the two peers of an online game or runs on two machines. Once two states
+// differ Box2D never brings them back to bit-identical, so the per-tick
+// checksums are binary-searched. The inputs up to that tick are compared
+// too, and this build re-simulates the first file to say which side it
+// agrees with. With one file, the re-simulation is the other side.
+static int runBisect(const SimOptions& opt, const WeaponFactory& weaponFactory) {
+    if (opt.bisectB.empty()) {
+        SimOptions replayOpt = opt;
+        replayOpt.replayPath = opt.bisectA;
+        return runReplay(replayOpt, weaponFactory);
+    }
+
+    ReplayReader a, b;
+    if (!a.load(opt.bisectA) || !b.load(opt.bisectB)) return 1;
+    if (!a.hasChecksums() || !b.hasChecksums()) {
+        std::cerr << "[Sim] --bisect needs replays with checksums (version 3 or later)\n";
+        return 1;
+    }
+    const ReplayHeader& ha = a.getHeader();
+    const ReplayHeader& hb = b.getHeader();
+    if (ha.seed != hb.seed || ha.levelIndex != hb.levelIndex || ha.players.size() != hb.players.size()) {
+        std::cerr << "[Sim] the replays are not recordings of the same match\n";
+        return 1;
+    }
+
+    uint32_t ticks = std::min(a.getTickCount(), b.getTickCount());
+    uint32_t ca = 0, cb = 0;
+    auto same = [&](uint32_t t) {
+        return a.getChecksum(t, ca) && b.getChecksum(t, cb) && ca == cb;
+    };
+    if (ticks == 0 || same(ticks - 1)) {
+        std::cout << "[Sim] no desync in " << ticks << " ticks";
+        if (a.getTickCount() != b.getTickCount())
+            std::cout << " (lengths differ: " << a.getTickCount() << " vs " << b.getTickCount() << ")";
+        std::cout << "\n";
+        return 0;
+    }
+
+    uint32_t lo = 0, hi = ticks - 1;  // hi always mismatches
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (same(mid)) lo = mid + 1;
+        else           hi = mid;
+    }
+    uint32_t first = hi;
+    a.getChecksum(first, ca);
+    b.getChecksum(first, cb);
+    std::cout << "[Sim] first desync before tick " << first << " (" << std::fixed << std::setprecision(2)
+              << first * FIXED_DT << " s)\n";
+
+    // Sections are only recorded every few ticks; the first recorded after
+    // the desync says where the states differ, if not where they started to
+    StateChecksum sa, sb;
+    uint32_t sectionTick = first;
+    while (sectionTick < ticks && !(a.getSections(sectionTick, sa) && b.getSections(sectionTick, sb))) sectionTick++;
+    if (sectionTick < ticks) {
+        std::cout << "[Sim] sections differing at tick " << sectionTick << ": " << describeMismatch(sa, sb) << "\n";
+        for (int s = 0; s < sa.sectionCount; s++) {
+            if (sa.sections[s] == sb.sections[s]) continue;
+            std::cout << "  " << std::setw(12) << StateChecksum::sectionName(s) << "  " << std::hex
+                      << std::setw(8) << sa.sections[s] << " vs " << std::setw(8) << sb.sections[s] << std::dec << "\n";
+        }
+    }
+
+    // Different inputs explain a desync without any simulation bug
+    PlayerInputs ia, ib;
+    for (uint32_t t = 0; t < first; t++) {
+        if (!a.next(ia) || !b.next(ib)) break;
+        for (size_t p = 0; p < ha.players.size(); p++) {
+            if (packInput(ia[p]) == packInput(ib[p])) continue;
+            std::cout << "[Sim] inputs already differ at tick " << t << " (P" << (p + 1)
+                      << "); the recordings did not see the same inputs\n";
+            return 2;
+        }
+    }
+
+    // The verdict re-simulates from tick 0 rather than seeking: a keyframe is
+    // the recording side's state, not something this build produced
+    auto match = std::make_unique<Match>(ha.rules, weaponFactory);
+    match->start(ha.levelIndex, ha.players, ha.wrapAround, ha.seed);
+    a.rewind();
+    while (a.getTick() < first && !match->isRoundOver() && a.next(ia)) match->update(FIXED_DT, ia);
+    if (a.getTick() == first) {
+        uint32_t local = StateHasher().compute(*match).combined();
+        const char* verdict = local == ca ? "the first file" : local == cb ? "the second file" : "neither file";
+        std::cout << "[Sim] this build agrees with " << verdict << " at tick " << first << "\n";
+    }
+    return 2;
+}
+
+// One side of a two-process rollback session over UDP, paced at 60 Hz like
+// the game. A bot plays the local player; the other process's bot arrives as
+// remote input. Both sides print the same fingerprint if they stayed in sync.
+static int runNet(const SimOptions& opt, const RulesEngine& rulesEngine, const WeaponFactory& weaponFactory) {
+    std::mt19937 rng(opt.seed);
+    SessionParams params;
+    params.seed = (static_cast<uint64_t>(rng()) << 32) | rng();
+    params.levelIndex = opt.level >= 0 ? opt.level % Arena::getLevelCount()
+                                       : static_cast<int>(rng() % static_cast<uint32_t>(Arena::getLevelCount()));
+    params.wrapAround = opt.wrapAround;
+    params.characters[opt.netConfig.localPlayer] =
+        static_cast<CharacterType>(rng() % static_cast<uint32_t>(CHARACTER_TYPE_COUNT));
+
+    RollbackSession session;
+    if (!session.open(opt.netConfig, params)) return 1;
+
+    using Clock = std::chrono::steady_clock;
+    auto waitStart = Clock::now();
+    while (!session.isSynchronized()) {
+        session.poll();
+        if (Clock::now() - waitStart > std::chrono::seconds(30)) {
+            std::cerr << "[Sim] no answer from " << opt.netConfig.peer.toString() << "\n";
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const SessionParams& agreed = session.getParams();
+    std::vector<PlayerSetup> setups;
+    for (int i = 0; i < 2; i++) setups.push_back({agreed.characters[i], sf::Color::White});
+    Match match(rulesEngine.getRules(), weaponFactory);
+    match.start(agreed.levelIndex, setups, agreed.wrapAround, agreed.seed);
+    BotController bot(opt.netConfig.localPlayer, static_cast<unsigned int>(rng()));
+
+    // Keep ticking a second past the end so the peer gets our last inputs
+    constexpr int LINGER_TICKS = 60;
+    int linger = -1;
+    long long stalled = 0;
+    auto tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(FIXED_DT));
+    auto nextTick = Clock::now();
+    while (linger != 0) {
+        if (!session.advance(match, bot.think(match))) stalled++;
+
+        bool settled = match.isRoundOver() && session.getConfirmedFrame() >= session.getFrame();
+        if (linger < 0 && settled) linger = LINGER_TICKS;
+        else if (linger > 0) linger--;
+
+        if (session.getSilenceSeconds() > 5.0f) {
+            std::cerr << "[Sim] peer went silent at tick " << session.getFrame() << "\n";
+            return 1;
+        }
+        nextTick += tickDuration;
+        std::this_thread::sleep_until(nextTick);
+    }
+
+    const RollbackSession::Stats& st = session.getStats();
+    std::cout << "[Sim] net P" << (opt.netConfig.localPlayer + 1) << " | "
+              << Arena::getLevelName(agreed.levelIndex) << " | " << match.getTick() << " ticks | "
+              << st.rollbacks << " rollbacks (" << st.rolledBackTicks << " ticks re-simulated, max depth "
+              << st.maxRollbackDepth << ") | " << stalled << " stalled ticks | packets "
+              << st.packetsSent << " sent, " << st.packetsDropped << " dropped, "
+              << st.packetsReceived << " received | " << st.checksumsCompared << " checksums, ";
+    if (st.desyncTick != UINT32_MAX) std::cout << "DESYNC at tick " << st.desyncTick;
+    else                             std::cout << "in sync";
+    std::cout << " | winner: ";
+    if (match.getWinner() >= 0) std::cout << "P" << (match.getWinner() + 1);
+    else                        std::cout << "draw";
+    std::cout << " | fingerprint " << std::hex << fingerprint(match) << std::dec << "\n";
+    return 0;
+}
+
+// Bot-vs-bot batch: the default mode
+static int runMatches(const SimOptions& opt, const RulesEngine& rulesEngine, const WeaponFactory& weaponFactory) {
+    ReplayWriter recorder;
+    if (!opt.recordDir.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(opt.recordDir, ec);
+    }
+
+    std::mt19937 rng(opt.seed);
+    std::uniform_int_distribution<int> charDist(0, CHARACTER_TYPE_COUNT - 1);
+    std::uniform_int_distribution<int> levelDist(0, Arena::getLevelCount() - 1);
+
+    std::cout << "[Sim] seed " << opt.seed << ", " << opt.matches << " match(es), "
+              << opt.players << " bots\n";
+
+    using Clock = std::chrono::steady_clock;
+    long long totalTicks = 0;
+    double    totalWallSec = 0.0;
+    std::vector<int> wins(MAX_PLAYERS + 1, 0);  // last slot counts draws
+    int divergences = 0;
+
+    for (int m = 0; m < opt.matches; m++) {
+        int level = (opt.level >= 0) ? opt.level : levelDist(rng);
+
+        std::vector<PlayerSetup> setups;
+        std::vector<unsigned int> botSeeds;
+        for (int i = 0; i < opt.players; i++) {
+            setups.push_back({static_cast<CharacterType>(charDist(rng)), sf::Color::White});
+            botSeeds.push_back(static_cast<unsigned int>(rng()));
+        }
+        uint64_t matchSeed = rng();
+        matchSeed = (matchSeed << 32) | rng();
+
+        auto t0 = Clock::now();
+        ReplayWriter* rec = opt.recordDir.empty() ? nullptr : &recorder;
+        MatchResult result = runMatch(rulesEngine, weaponFactory, level, setups, botSeeds,
+                                      opt.wrapAround, matchSeed, rec, opt.checkDeterminism);
+        if (rec) rec->save(opt.recordDir + "/match_" + std::to_string(matchSeed) + ".sbr");
+        double wallSec = std::chrono::duration<double>(Clock::now() - t0).count();
+
+        long long ticks = result.ticks;
+        totalTicks += ticks;
+        totalWallSec += wallSec;
+        int winner = result.winner;
+        wins[winner >= 0 ? winner : MAX_PLAYERS]++;
+
+        std::cout << "[Sim] match " << (m + 1) << " | " << Arena::getLevelName(level)
+                  << " | " << ticks << " ticks (" << std::fixed << std::setprecision(1)
+                  << static_cast<double>(ticks) * FIXED_DT << "s sim) | "
+                  << std::setprecision(2) << wallSec * 1000.0 << " ms | "
+                  << std::setprecision(0) << (wallSec > 0.0 ? ticks / wallSec : 0.0)
+                  << " ticks/s | winner: ";
+        if (winner >= 0) std::cout << "P" << (winner + 1) << "\n";
+        else             std::cout << "draw\n";
+
+        if (opt.checkDeterminism) {
+            MatchResult again = runMatch(rulesEngine, weaponFactory, level, setups, botSeeds,
+                                         opt.wrapAround, matchSeed, nullptr, true);
+            if (again.ticks != result.ticks || again.fingerprint != result.fingerprint) {
+                std::cerr << "[Sim] match " << (m + 1) << " DIVERGED on rerun (seed "
+                          << matchSeed << "): " << result.ticks << " vs " << again.ticks
+                          << " ticks, fingerprint " << std::hex << result.fingerprint
+                          << " vs " << again.fingerprint << std::dec << "\n";
+                auto diff = std::mismatch(result.trace.begin(), result.trace.end(),
+                                          again.trace.begin(), again.trace.end());
+                if (diff.first != result.trace.end() && diff.second != again.trace.end())
+                    std::cerr << "[Sim]   first differs before tick " << (diff.first - result.trace.begin())
+                              << ": " << describeMismatch(*diff.first, *diff.second) << "\n";
+                divergences++;
+            } else if (!checkRestore(rulesEngine, weaponFactory, level, setups, botSeeds,
+                                     opt.wrapAround, matchSeed)) {
+                std::cerr << "[Sim] match " << (m + 1) << " DIVERGED after a snapshot restore (seed "
+                          << matchSeed << ")\n";
+                divergences++;
+            }
+        }
+    }
+
+    double tps = totalWallSec > 0.0 ? static_cast<double>(totalTicks) / totalWallSec : 0.0;
+    std::cout << "\n=== Sim summary ===\n"
+              << "  matches:        " << opt.matches << "\n"
+              << "  total ticks:    " << totalTicks << "\n"
+              << std::fixed << std::setprecision(3)
+              << "  wall time:      " << totalWallSec << " s\n"
+              << std::setprecision(0)
+              << "  ticks/second:   " << tps << "\n"
+              << std::setprecision(1)
+              << "  speedup:        " << tps * FIXED_DT << "x real time\n";
+    for (int i = 0; i < opt.players; i++)
+        std::cout << "  P" << (i + 1) << " wins:        " << wins[i] << "\n";
+    std::cout << "  draws:          " << wins[MAX_PLAYERS] << "\n";
+    if (opt.checkDeterminism) {
+        std::cout << "  determinism:    " << (divergences == 0 ? "OK" : "FAILED")
+                  << " (" << divergences << " diverged)\n";
+        if (divergences > 0) return 2;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    SimOptions opt;
+    if (!parseArgs(argc, argv, opt)) return 1;
+    if (!opt.seedGiven) opt.seed = std::random_device{}();
+
+    RulesEngine rulesEngine;
+    rulesEngine.loadFromFile(opt.rulesPath);
+    WeaponFactory weaponFactory;
+    weaponFactory.loadWeaponsFromDirectory(opt.weaponsDir);
+
+#ifdef STICKBRAWL_PROFILE
+    if (!opt.tracePath.empty()) {
+        PROFILE_THREAD_NAME("sim");
+        Profiler::beginTrace();
+    }
+#endif
+
+    int status;
+    if (!opt.bisectA.empty())         status = runBisect(opt, weaponFactory);
+    else if (!opt.replayPath.empty()) status = runReplay(opt, weaponFactory);
+    else if (opt.net)                 status = runNet(opt, rulesEngine, weaponFactory);
+    else                              status = runMatches(opt, rulesEngine, weaponFactory);
+
+#ifdef STICKBRAWL_PROFILE
+    if (!opt.tracePath.empty() && !Profiler::writeTrace(opt.tracePath) && status == 0) status = 1;
+#endif
+    return status;
+}
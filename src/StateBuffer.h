@@ -0,0 +1,111 @@
+#pragma once
+#include "Physics.h"
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Types that may be copied raw into a state blob: every byte is part of the
+// value, so equal states always produce equal blobs (snapshots and keyframes
+// are compared byte for byte). std::has_unique_object_representations covers
+// integers, enums and structs of them without padding; it excludes floats
+// (+0 and -0 differ in bytes but compare equal), so floats and the float-only
+// structs below are admitted explicitly, each checked for padding. Structs
+// with padding are written field by field instead.
+template <typename T>
+struct IsPaddingFree : std::bool_constant<std::has_unique_object_representations_v<T> ||
+                                          std::is_floating_point_v<T>> {};
+template <> struct IsPaddingFree<b2Vec2> : std::true_type {};
+template <> struct IsPaddingFree<b2Rot> : std::true_type {};
+static_assert(sizeof(b2Vec2) == 2 * sizeof(float) && sizeof(b2Rot) == 2 * sizeof(float),
+              "Box2D vectors and rotations must be two packed floats");
+
+// Flat byte stream for match state (replay keyframes, snapshots). Values are
+// copied raw, so a buffer is only valid for the build that wrote it.
+class StateWriter {
+public:
+    explicit StateWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    void writeBytes(const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        m_out.insert(m_out.end(), bytes, bytes + size);
+    }
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "state values must be trivially copyable");
+        static_assert(IsPaddingFree<T>::value, "state values must not have padding; write the fields one by one");
+        writeBytes(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void writeVector(const std::vector<T>& v) {
+        static_assert(IsPaddingFree<T>::value, "state values must not have padding; write the fields one by one");
+        write(static_cast<uint32_t>(v.size()));
+        if (!v.empty()) writeBytes(v.data(), v.size() * sizeof(T));
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+};
+
+// Reads what StateWriter wrote. Any overrun latches ok() to false and leaves
+// the destination untouched, so callers can check once at the end.
+class StateReader {
+public:
+    StateReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    bool readBytes(void* out, size_t size) {
+        if (!m_ok || m_size - m_pos < size) { m_ok = false; return false; }
+        std::memcpy(out, m_data + m_pos, size);
+        m_pos += size;
+        return true;
+    }
+
+    template <typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "state values must be trivially copyable");
+        return readBytes(&value, sizeof(T));
+    }
+
+    template <typename T>
+    bool readVector(std::vector<T>& v) {
+        uint32_t count = 0;
+        if (!read(count) || m_size - m_pos < static_cast<size_t>(count) * sizeof(T)) {
+            m_ok = false;
+            return false;
+        }
+        v.resize(count);
+        return count == 0 || readBytes(v.data(), count * sizeof(T));
+    }
+
+    bool   ok() const { return m_ok; }
+    size_t remaining() const { return m_size - m_pos; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+    bool   m_ok = true;
+};
+
+// Dynamic state of one Box2D body
+struct BodyState {
+    b2Vec2 position;
+    b2Rot  rotation;
+    b2Vec2 linearVelocity;
+    float  angularVelocity;
+};
+template <> struct IsPaddingFree<BodyState> : std::true_type {};
+static_assert(sizeof(BodyState) == 7 * sizeof(float), "BodyState must have no padding");
+
+inline BodyState captureBody(b2BodyId body) {
+    b2Transform xf = b2Body_GetTransform(body);
+    return {xf.p, xf.q, b2Body_GetLinearVelocity(body), b2Body_GetAngularVelocity(body)};
+}
+
+inline void applyBody(b2BodyId body, const BodyState& st) {
+    b2Body_SetTransform(body, st.position, st.rotation);
+    b2Body_SetLinearVelocity(body, st.linearVelocity);
+    b2Body_SetAngularVelocity(body, st.angularVelocity);
+}
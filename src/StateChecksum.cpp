@@ -0,0 +1,161 @@
+#include "StateChecksum.h"
+#include <algorithm>
+#include <cstring>
+
+// ============================================================
+// HASHING
+// ============================================================
+
+namespace {
+
+constexpr uint32_t PRIME1 = 0x9E3779B1u;
+constexpr uint32_t PRIME2 = 0x85EBCA77u;
+constexpr uint32_t PRIME3 = 0xC2B2AE3Du;
+constexpr uint32_t PRIME4 = 0x27D4EB2Fu;
+
+inline uint32_t rotl(uint32_t v, int r) { return (v << r) | (v >> (32 - r)); }
+
+// xxHash32 core: four lanes consume consecutive words independently, so the
+// main loop maps onto one SIMD register
+uint32_t hashWords(const uint32_t* words, size_t count) {
+    uint32_t acc[4] = {PRIME1 + PRIME2, PRIME2, 0u, 0u - PRIME1};
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+        for (int lane = 0; lane < 4; lane++)
+            acc[lane] = rotl(acc[lane] + words[i + lane] * PRIME2, 13) * PRIME1;
+
+    uint32_t h = rotl(acc[0], 1) + rotl(acc[1], 7) + rotl(acc[2], 12) + rotl(acc[3], 18);
+    h += static_cast<uint32_t>(count * 4);
+    for (; i < count; i++) h = rotl(h + words[i] * PRIME3, 17) * PRIME4;
+
+    h ^= h >> 15; h *= PRIME2;
+    h ^= h >> 13; h *= PRIME3;
+    h ^= h >> 16;
+    return h;
+}
+
+struct WordSink {
+    std::vector<uint32_t>& words;
+
+    void u32(uint32_t v) { words.push_back(v); }
+    void i32(int v) { words.push_back(static_cast<uint32_t>(v)); }
+    void f32(float v) {
+        uint32_t u;
+        std::memcpy(&u, &v, sizeof(u));
+        words.push_back(u);
+    }
+    void vec(b2Vec2 v) { f32(v.x); f32(v.y); }
+
+    // Byte blobs are packed four to a word, zero-padded at the end
+    void bytes(const void* data, size_t size) {
+        const auto* src = static_cast<const uint8_t*>(data);
+        size_t start = words.size();
+        words.resize(start + (size + 3) / 4, 0u);
+        std::memcpy(words.data() + start, src, size);
+    }
+
+    void body(b2BodyId id) {
+        b2Transform xf = b2Body_GetTransform(id);
+        vec(xf.p);
+        f32(xf.q.c);
+        f32(xf.q.s);
+        vec(b2Body_GetLinearVelocity(id));
+        f32(b2Body_GetAngularVelocity(id));
+    }
+};
+
+} // namespace
+
+uint32_t StateChecksum::combined() const {
+    return hashWords(sections.data(), static_cast<size_t>(sectionCount));
+}
+
+std::string StateChecksum::sectionName(int section) {
+    switch (section) {
+        case CS_ROUND:       return "round";
+        case CS_PROJECTILES: return "projectiles";
+        case CS_TERRAIN:     return "terrain";
+        default:             return "P" + std::to_string(section - CS_PLAYER + 1);
+    }
+}
+
+uint32_t StateHasher::hashSection() {
+    uint32_t h = hashWords(m_words.data(), m_words.size());
+    m_words.clear();
+    return h;
+}
+
+// ============================================================
+// STATE
+// ============================================================
+
+StateChecksum StateHasher::compute(const Match& match) {
+    StateChecksum sum;
+    WordSink w{m_words};
+    m_words.clear();
+
+    w.u32(match.getTick());
+    w.f32(match.getRoundTimer());
+    w.i32(match.isRoundOver() ? 1 : 0);
+    w.i32(match.getWinner());
+    const Rng& rng = match.getRng();
+    w.bytes(&rng, sizeof(rng));
+    for (const auto& pk : match.getPickups()) {
+        w.vec(pk.position);
+        w.u32(pk.weapon ? pk.weapon->id : INVALID_WEAPON_ID);
+        w.f32(pk.bobTimer);
+        w.i32(pk.alive ? 1 : 0);
+    }
+    for (const auto& fx : match.getExplosions()) {
+        w.f32(fx.x);
+        w.f32(fx.y);
+        w.f32(fx.timer);
+    }
+    sum.sections[CS_ROUND] = hashSection();
+
+    const ProjectilePool& pool = match.getProjectiles();
+    for (int slot : pool.getActive()) {
+        const Projectile& p = pool[slot];
+        w.i32(slot);
+        w.body(p.bodyId);
+        w.f32(p.lifetime);
+        w.i32(p.ownerIndex);
+    }
+    sum.sections[CS_PROJECTILES] = hashSection();
+
+    const Arena& arena = match.getArena();
+    if (const BitmapTerrain* bitmap = arena.getBitmapTerrain()) {
+        const auto& cells = bitmap->getCells();
+        w.bytes(cells.data(), cells.size());
+    } else {
+        const auto& platforms = arena.getPlatforms();
+        for (size_t i = 0; i < platforms.size(); i++) {
+            const Platform& p = platforms[i];
+            if (!p.alive) continue;
+            w.u32(static_cast<uint32_t>(i));
+            w.f32(p.cx);
+            w.f32(p.cy);
+            w.f32(p.halfWidth);
+            w.f32(p.halfHeight);
+        }
+    }
+    sum.sections[CS_TERRAIN] = hashSection();
+
+    const auto& players = match.getPlayers();
+    int playerCount = std::min(static_cast<int>(players.size()), MAX_PLAYERS);
+    for (int i = 0; i < playerCount; i++) {
+        const StickFigure& p = *players[i];
+        for (b2BodyId part : p.getPartBodyIds()) w.body(part);
+        w.f32(p.getHealth());
+        w.f32(p.getMaxHealth());
+        w.i32(p.getLives());
+        w.i32(p.getFacingDirection());
+        w.f32(p.getAimAngle());
+        w.u32(p.getCurrentWeapon().id);
+        w.i32(p.getAmmo());
+        w.i32(p.isWaitingToRespawn() ? 1 : 0);
+        sum.sections[CS_PLAYER + i] = hashSection();
+    }
+    sum.sectionCount = CS_PLAYER + playerCount;
+    return sum;
+}
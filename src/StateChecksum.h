@@ -0,0 +1,48 @@
+#pragma once
+#include "Match.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Sections of a StateChecksum, so a mismatch says where the states differ
+// and not just that they do. Players take one section each from CS_PLAYER.
+enum ChecksumSection : int {
+    CS_ROUND = 0,     // tick, timers, RNG, pickups, explosions
+    CS_PROJECTILES,   // live bullet bodies
+    CS_TERRAIN,       // platform rectangles or the bitmap mask
+    CS_PLAYER,        // ragdoll part transforms/velocities, health, lives, weapon
+    CHECKSUM_SECTION_LIMIT = CS_PLAYER + MAX_PLAYERS
+};
+
+struct StateChecksum {
+    std::array<uint32_t, CHECKSUM_SECTION_LIMIT> sections{};
+    int sectionCount = 0;  // CS_PLAYER + number of players
+
+    uint32_t combined() const;
+    bool operator==(const StateChecksum& o) const {
+        return sectionCount == o.sectionCount &&
+               std::equal(sections.begin(), sections.begin() + sectionCount, o.sections.begin());
+    }
+    bool operator!=(const StateChecksum& o) const { return !(*this == o); }
+
+    static std::string sectionName(int section);
+};
+
+// Hashes the authoritative simulation state of a Match. The values of each
+// section are gathered into one flat word array and hashed with four
+// independent xxHash32-style lanes, which the compiler vectorizes. The word
+// array is reused, so hashing every tick does not allocate once warm.
+//
+// Floats are hashed by their bits: the checksum only agrees between builds
+// that produce bit-identical simulations.
+class StateHasher {
+public:
+    StateChecksum compute(const Match& match);
+
+private:
+    uint32_t hashSection();
+
+    std::vector<uint32_t> m_words;
+};
@@ -1,10 +1,15 @@
 #include "StickFigure.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <iostream>
 
+#ifndef STICKBRAWL_HEADLESS
 static sf::Vector2f toScreen(b2Vec2 pos) {
     return {SCREEN_CX + pos.x * PPM, SCREEN_CY - pos.y * PPM};
 }
+#endif
 
 StickFigure::StickFigure(int playerIndex, Physics& physics, float spawnX, float spawnY,
                          sf::Color color, CharacterType type)
@@ -95,6 +100,70 @@ void StickFigure::createBodies(Physics& physics, float spawnX, float spawnY) {
     };
     createLeg(-1.0f, m_leftLeg, m_leftHipJoint);
     createLeg(1.0f, m_rightLeg, m_rightHipJoint);
+
+    for (b2BodyId part : getPartBodyIds())
+        physics.tagBody(part, BodyKind::Player, m_playerIndex);
+}
+
+// ============================================================
+// STATE CAPTURE
+// ============================================================
+
+void StickFigure::saveState(StateWriter& out) const {
+    for (b2BodyId part : getPartBodyIds())
+        out.write(captureBody(part));
+
+    out.write(m_health);
+    out.write(m_maxHealth);
+    out.write(m_lives);
+    out.write(m_facingDir);
+    out.write(m_aimAngle);
+    out.write(m_attackCooldown);
+    out.write(m_attackAnimTimer);
+    out.write(m_damageFlashTimer);
+    out.write(m_respawnTimer);
+    out.write(m_waitingToRespawn);
+    out.write(m_pendingRespawnX);
+    out.write(m_pendingRespawnY);
+    out.write(m_poisonTimer);
+    out.write(m_poisonDps);
+    out.write(m_poisonTickTimer);
+    out.write(m_weapon->id);
+    out.write(m_currentAmmo);
+    out.write(m_animTime);
+}
+
+void StickFigure::loadState(StateReader& in, const WeaponFactory& weapons) {
+    std::array<BodyState, PART_COUNT> parts;
+    for (BodyState& st : parts) in.read(st);
+    if (!in.ok()) return;
+
+    // The world was reset: build a fresh ragdoll around the torso, then put
+    // every part exactly where the state says
+    createBodies(*m_physics, parts[0].position.x, parts[0].position.y);
+    std::array<b2BodyId, PART_COUNT> ids = getPartBodyIds();
+    for (int i = 0; i < PART_COUNT; i++) applyBody(ids[i], parts[i]);
+
+    in.read(m_health);
+    in.read(m_maxHealth);
+    in.read(m_lives);
+    in.read(m_facingDir);
+    in.read(m_aimAngle);
+    in.read(m_attackCooldown);
+    in.read(m_attackAnimTimer);
+    in.read(m_damageFlashTimer);
+    in.read(m_respawnTimer);
+    in.read(m_waitingToRespawn);
+    in.read(m_pendingRespawnX);
+    in.read(m_pendingRespawnY);
+    in.read(m_poisonTimer);
+    in.read(m_poisonDps);
+    in.read(m_poisonTickTimer);
+    WeaponId weaponId = INVALID_WEAPON_ID;
+    in.read(weaponId);
+    m_weapon = &weapons.getWeaponById(weaponId);
+    in.read(m_currentAmmo);
+    in.read(m_animTime);
 }
 
 bool StickFigure::isOnGround() const {
@@ -126,28 +195,35 @@ void StickFigure::resetAim() { m_aimAngle *= 0.9f; } // slowly return to center
 
 bool StickFigure::canAttack() const {
     if (m_attackCooldown > 0.0f) return false;
-    if (m_weapon.ammo >= 0 && m_currentAmmo <= 0) return false;
+    if (m_weapon->ammo >= 0 && m_currentAmmo <= 0) return false;
     return true;
 }
 
 void StickFigure::attack() {
-    m_attackCooldown = m_weapon.attackRate;
+    m_attackCooldown = m_weapon->attackRate;
     m_attackAnimTimer = 0.2f;
     if (m_currentAmmo > 0) m_currentAmmo--;
 }
 
 void StickFigure::equipWeapon(const WeaponData& weapon) {
-    m_weapon = weapon;
+    m_weapon = &weapon;
     m_currentAmmo = weapon.ammo;
 }
 
 void StickFigure::takeDamage(float amount, float knockbackX, float knockbackY) {
-    m_health -= amount;
-    if (m_health < 0.0f) m_health = 0.0f;
+    loseHealth(amount);
     m_damageFlashTimer = 0.15f;
     b2Body_ApplyLinearImpulseToCenter(m_torso, {knockbackX, knockbackY}, true);
 }
 
+void StickFigure::loseHealth(float amount) {
+    bool wasAlive = isAlive();
+    m_health -= amount;
+    if (m_health < 0.0f) m_health = 0.0f;
+    if (wasAlive && !isAlive())
+        PROFILE_MARK(TraceMarker::Death, getPosition().x, getPosition().y, static_cast<float>(m_playerIndex));
+}
+
 void StickFigure::applyPoison(float dps, float duration) {
     m_poisonDps = dps;
     m_poisonTimer = duration;
@@ -192,7 +268,7 @@ void StickFigure::respawn(float x, float y) {
     b2Body_SetLinearVelocity(m_rightLeg, zero);
     b2Body_SetAngularVelocity(m_rightLeg, 0.0f);
 
-    m_weapon = WeaponData{};
+    m_weapon = &builtinFists();
     m_currentAmmo = -1;
 }
 
@@ -240,8 +316,7 @@ void StickFigure::update(float dt) {
         m_poisonTickTimer += dt;
         if (m_poisonTickTimer >= 0.5f) { // tick every 0.5s
             m_poisonTickTimer -= 0.5f;
-            m_health -= m_poisonDps * 0.5f;
-            if (m_health < 0.0f) m_health = 0.0f;
+            loseHealth(m_poisonDps * 0.5f);
         }
     }
 }
@@ -258,54 +333,59 @@ void StickFigure::startRespawnTimer(float delay, float x, float y) {
 
 b2Vec2 StickFigure::getPosition() const { return b2Body_GetPosition(m_torso); }
 
+// StickLady's purse travels a wide overhead arc; everyone else slashes a
+// 90 degree arc in front
+b2Vec2 StickFigure::getSwingPoint() const {
+    b2Vec2 p = getPosition();
+    float dir = static_cast<float>(m_facingDir);
+    float prog = 1.0f - (m_attackAnimTimer / 0.2f);
+
+    if (m_charType == CharacterType::StickLady) {
+        float swingRad = (-120.0f + 240.0f * prog) * 3.14159f / 180.0f;
+        float swingR = m_weapon->range * 0.5f;
+        return {p.x + dir * std::cos(swingRad) * swingR, p.y + 5.0f / PPM - std::sin(swingRad) * swingR};
+    }
+    float angle = (-45.0f + 90.0f * prog) * 3.14159f / 180.0f;
+    float arcR = m_weapon->range * 0.6f;
+    return {p.x + dir * std::cos(angle) * arcR, p.y + std::sin(angle) * arcR};
+}
+
+#ifndef STICKBRAWL_HEADLESS
+
 void StickFigure::draw(sf::RenderTarget& target) const {
+    // Scratch for drawing one figure on its own (previews, benchmarks); the
+    // match view batches every player through draw(ShapeBatch&) instead
+    static ShapeBatch batch;
+    batch.clear();
+    draw(batch);
+    batch.draw(target);
+}
+
+void StickFigure::draw(ShapeBatch& batch) const {
     if (!isAlive()) return;
 
     switch (m_charType) {
-        case CharacterType::Cat:       drawCat(target); break;
-        case CharacterType::Cobra:     drawCobra(target); break;
-        case CharacterType::Unicorn:   drawUnicorn(target); break;
-        case CharacterType::Crocodile: drawCrocodile(target); break;
-        case CharacterType::StickLady: drawStickLady(target); break;
-        default:                       drawStick(target); break;
+        case CharacterType::Cat:       drawCat(batch); break;
+        case CharacterType::Cobra:     drawCobra(batch); break;
+        case CharacterType::Unicorn:   drawUnicorn(batch); break;
+        case CharacterType::Crocodile: drawCrocodile(batch); break;
+        case CharacterType::StickLady: drawStickLady(batch); break;
+        default:                       drawStick(batch); break;
     }
 
-    if (m_attackAnimTimer > 0.0f) drawAttackEffect(target);
+    if (m_attackAnimTimer > 0.0f) drawAttackEffect(batch);
 
     // Draw aim indicator for ranged weapons
-    if (m_weapon.type != WeaponType::Melee) drawAimIndicator(target);
-
-    // Poison effect - green particles
-    if (m_poisonTimer > 0.0f) {
-        sf::Vector2f pos = toScreen(getPosition());
-        for (int i = 0; i < 3; i++) {
-            float offset = static_cast<float>(i) * 8.0f - 8.0f;
-            sf::CircleShape dot(2.0f);
-            dot.setOrigin({2.0f, 2.0f});
-            dot.setPosition({pos.x + offset, pos.y - 25.0f - static_cast<float>(i) * 4.0f});
-            dot.setFillColor(sf::Color(0, 200, 0, 180));
-            target.draw(dot);
-        }
-    }
+    if (m_weapon->type != WeaponType::Melee) drawAimIndicator(batch);
 }
 
-void StickFigure::drawStick(sf::RenderTarget& target) const {
+void StickFigure::drawStick(ShapeBatch& batch) const {
     sf::Color dc = (m_damageFlashTimer > 0.0f) ? sf::Color::White : m_color;
 
-    sf::CircleShape headShape(m_config.headRadius * PPM);
-    headShape.setOrigin({m_config.headRadius * PPM, m_config.headRadius * PPM});
-    headShape.setPosition(toScreen(b2Body_GetPosition(m_head)));
-    headShape.setFillColor(sf::Color::Transparent);
-    headShape.setOutlineColor(dc);
-    headShape.setOutlineThickness(2.0f);
-    target.draw(headShape);
-
-    auto drawLimb = [&](b2Vec2 s, b2Vec2 e) {
-        sf::VertexArray line(sf::PrimitiveType::Lines, 2);
-        line[0] = sf::Vertex{toScreen(s), dc};
-        line[1] = sf::Vertex{toScreen(e), dc};
-        target.draw(line);
-    };
+    batch.circle(toScreen(b2Body_GetPosition(m_head)), m_config.headRadius * PPM,
+                sf::Color::Transparent, 30, dc, 2.0f);
+
+    auto drawLimb = [&](b2Vec2 s, b2Vec2 e) { batch.line(toScreen(s), toScreen(e), dc); };
 
     b2Vec2 tp = b2Body_GetPosition(m_torso);
     b2Vec2 tTop = {tp.x, tp.y + m_config.bodyHeight / 4.0f};
@@ -318,69 +398,49 @@ void StickFigure::drawStick(sf::RenderTarget& target) const {
     drawLimb(tBot, b2Body_GetPosition(m_rightLeg));
 }
 
-void StickFigure::drawCat(sf::RenderTarget& target) const {
+void StickFigure::drawCat(ShapeBatch& batch) const {
     sf::Color dc = (m_damageFlashTimer > 0.0f) ? sf::Color::White : m_color;
     b2Vec2 tp = b2Body_GetPosition(m_torso);
     sf::Vector2f c = toScreen(tp);
     float dir = static_cast<float>(m_facingDir);
 
     // Body
-    sf::RectangleShape body({28.0f, 16.0f});
-    body.setOrigin({14.0f, 8.0f}); body.setPosition(c);
-    body.setFillColor(dc); body.setOutlineColor(sf::Color::Black); body.setOutlineThickness(1.0f);
-    target.draw(body);
+    batch.rect(c, {28.0f, 16.0f}, {14.0f, 8.0f}, 0.0f, dc, sf::Color::Black, 1.0f);
 
     // Head
-    sf::CircleShape head(10.0f);
-    head.setOrigin({10.0f, 10.0f});
-    head.setPosition({c.x + dir * 19.0f, c.y - 4.0f});
-    head.setFillColor(dc); head.setOutlineColor(sf::Color::Black); head.setOutlineThickness(1.0f);
-    target.draw(head);
+    sf::Vector2f hc = {c.x + dir * 19.0f, c.y - 4.0f};
+    batch.circle(hc, 10.0f, dc, 30, sf::Color::Black, 1.0f);
 
-    sf::Vector2f hc = head.getPosition();
     // Ears
     for (float s : {-1.0f, 1.0f}) {
-        sf::ConvexShape ear(3);
-        ear.setPoint(0, {hc.x + s * 5.0f, hc.y - 8.0f});
-        ear.setPoint(1, {hc.x + s * 2.0f, hc.y - 16.0f});
-        ear.setPoint(2, {hc.x + s * 8.0f, hc.y - 13.0f});
-        ear.setFillColor(dc); ear.setOutlineColor(sf::Color::Black); ear.setOutlineThickness(1.0f);
-        target.draw(ear);
+        batch.convex({{hc.x + s * 5.0f, hc.y - 8.0f},
+                     {hc.x + s * 2.0f, hc.y - 16.0f},
+                     {hc.x + s * 8.0f, hc.y - 13.0f}}, dc, sf::Color::Black, 1.0f);
     }
     // Eyes
-    for (float s : {-1.0f, 1.0f}) {
-        sf::CircleShape eye(2.0f); eye.setOrigin({2.0f, 2.0f});
-        eye.setPosition({hc.x + dir * 3.0f + s * 3.0f, hc.y - 2.0f});
-        eye.setFillColor(sf::Color::Black); target.draw(eye);
-    }
+    for (float s : {-1.0f, 1.0f})
+        batch.circle({hc.x + dir * 3.0f + s * 3.0f, hc.y - 2.0f}, 2.0f, sf::Color::Black);
     // Nose + Whiskers
-    sf::CircleShape nose(1.5f); nose.setOrigin({1.5f, 1.5f});
-    nose.setPosition({hc.x + dir * 7.0f, hc.y + 1.0f});
-    nose.setFillColor(sf::Color(200, 100, 100)); target.draw(nose);
+    batch.circle({hc.x + dir * 7.0f, hc.y + 1.0f}, 1.5f, sf::Color(200, 100, 100));
     for (float wy : {-1.0f, 0.0f, 1.0f}) {
-        sf::VertexArray w(sf::PrimitiveType::Lines, 2);
-        w[0] = sf::Vertex{{hc.x + dir * 8.0f, hc.y + 1.0f + wy * 2.0f}, sf::Color::Black};
-        w[1] = sf::Vertex{{hc.x + dir * 20.0f, hc.y + 1.0f + wy * 5.0f}, sf::Color::Black};
-        target.draw(w);
+        batch.line({hc.x + dir * 8.0f, hc.y + 1.0f + wy * 2.0f},
+                  {hc.x + dir * 20.0f, hc.y + 1.0f + wy * 5.0f}, sf::Color::Black);
     }
     // Tail
-    sf::VertexArray tail(sf::PrimitiveType::LineStrip, 4);
     float tx = c.x - dir * 14.0f;
-    tail[0] = sf::Vertex{{tx, c.y}, dc};
-    tail[1] = sf::Vertex{{tx - dir * 8.0f, c.y - 8.0f}, dc};
-    tail[2] = sf::Vertex{{tx - dir * 12.0f, c.y - 16.0f}, dc};
-    tail[3] = sf::Vertex{{tx - dir * 8.0f, c.y - 22.0f}, dc};
-    target.draw(tail);
+    const sf::Vertex tail[4] = {
+        {{tx, c.y}, dc},
+        {{tx - dir * 8.0f, c.y - 8.0f}, dc},
+        {{tx - dir * 12.0f, c.y - 16.0f}, dc},
+        {{tx - dir * 8.0f, c.y - 22.0f}, dc},
+    };
+    batch.lineStrip(tail, 4);
     // Legs
-    for (float lx : {-0.3f, -0.1f, 0.1f, 0.3f}) {
-        sf::VertexArray leg(sf::PrimitiveType::Lines, 2);
-        leg[0] = sf::Vertex{{c.x + lx * 28.0f, c.y + 8.0f}, dc};
-        leg[1] = sf::Vertex{{c.x + lx * 28.0f, c.y + 18.0f}, dc};
-        target.draw(leg);
-    }
+    for (float lx : {-0.3f, -0.1f, 0.1f, 0.3f})
+        batch.line({c.x + lx * 28.0f, c.y + 8.0f}, {c.x + lx * 28.0f, c.y + 18.0f}, dc);
 }
 
-void StickFigure::drawCobra(sf::RenderTarget& target) const {
+void StickFigure::drawCobra(ShapeBatch& batch) const {
     sf::Color dc = (m_damageFlashTimer > 0.0f) ? sf::Color::White : m_color;
     b2Vec2 tp = b2Body_GetPosition(m_torso);
     sf::Vector2f c = toScreen(tp);
@@ -401,73 +461,74 @@ void StickFigure::drawCobra(sf::RenderTarget& target) const {
     constexpr float coilRadiusY = 6.0f;
     sf::Vector2f coilCenter = {c.x - dir * 2.0f, c.y + 10.0f};
 
-    // Build coil points with per-segment wiggle
-    sf::VertexArray coilLine(sf::PrimitiveType::LineStrip, coilSegs + 1);
+    // The spiral itself never changes; only the wiggle on top is animated
+    struct CoilPoint {
+        float cosA, sinA;
+        float rScale;   // shrinks toward the center to look like a real coil
+        float frac;
+        uint8_t fade;   // darkens toward the tail end
+    };
+    static const auto coilTemplate = [] {
+        std::array<CoilPoint, coilSegs + 1> pts{};
+        for (int i = 0; i <= coilSegs; i++) {
+            float frac = static_cast<float>(i) / static_cast<float>(coilSegs);
+            float angle = frac * coilLoops * 2.0f * 3.14159f;
+            pts[i] = {std::cos(angle), std::sin(angle), 1.0f - frac * 0.3f, frac,
+                      static_cast<uint8_t>(255 - static_cast<int>(frac * 80.0f))};
+        }
+        return pts;
+    }();
+
+    std::array<sf::Vertex, coilSegs + 1> coil;
     for (int i = 0; i <= coilSegs; i++) {
-        float frac = static_cast<float>(i) / static_cast<float>(coilSegs);
-        float angle = frac * coilLoops * 2.0f * 3.14159f;
-        // Shrink radius toward the center to look like a real coil
-        float rScale = 1.0f - frac * 0.3f;
-        float wiggle = std::sin(t * wiggleSpeed + frac * 8.0f) * wiggleAmp * (1.0f - frac * 0.5f);
-        float px = coilCenter.x + std::cos(angle) * coilRadiusX * rScale + wiggle * 0.3f;
-        float py = coilCenter.y + std::sin(angle) * coilRadiusY * rScale + wiggle * 0.15f;
+        const CoilPoint& cp = coilTemplate[i];
+        float wiggle = std::sin(t * wiggleSpeed + cp.frac * 8.0f) * wiggleAmp * (1.0f - cp.frac * 0.5f);
+        float px = coilCenter.x + cp.cosA * coilRadiusX * cp.rScale + wiggle * 0.3f;
         // Stack coils vertically with slight offset
-        py -= frac * 8.0f;
-
-        // Color: darken toward tail end
-        uint8_t fade = static_cast<uint8_t>(255 - static_cast<int>(frac * 80.0f));
+        float py = coilCenter.y + cp.sinA * coilRadiusY * cp.rScale + wiggle * 0.15f - cp.frac * 8.0f;
         sf::Color segColor = {
-            static_cast<uint8_t>(dc.r * fade / 255),
-            static_cast<uint8_t>(dc.g * fade / 255),
-            static_cast<uint8_t>(dc.b * fade / 255),
+            static_cast<uint8_t>(dc.r * cp.fade / 255),
+            static_cast<uint8_t>(dc.g * cp.fade / 255),
+            static_cast<uint8_t>(dc.b * cp.fade / 255),
             dc.a
         };
-        coilLine[i] = sf::Vertex{{px, py}, segColor};
+        coil[i] = sf::Vertex{{px, py}, segColor};
     }
-    target.draw(coilLine);
+    batch.lineStrip(coil.data(), coil.size());
 
     // Draw thicker coil by offsetting and drawing again
-    sf::VertexArray coilLine2(sf::PrimitiveType::LineStrip, coilSegs + 1);
-    for (int i = 0; i <= coilSegs; i++) {
-        coilLine2[i] = coilLine[i];
-        coilLine2[i].position.y += 1.5f;
-    }
-    target.draw(coilLine2);
-    sf::VertexArray coilLine3(sf::PrimitiveType::LineStrip, coilSegs + 1);
-    for (int i = 0; i <= coilSegs; i++) {
-        coilLine3[i] = coilLine[i];
-        coilLine3[i].position.y -= 1.5f;
+    for (float off : {1.5f, -1.5f}) {
+        auto thick = coil;
+        for (auto& v : thick) v.position.y += off;
+        batch.lineStrip(thick.data(), thick.size());
     }
-    target.draw(coilLine3);
 
     // --- Neck: segmented line rising up from coil with S-curve wiggle ---
     constexpr int neckSegs = 12;
     constexpr float neckHeight = 38.0f;
     sf::Vector2f neckBase = {c.x, c.y + 2.0f};
 
-    sf::VertexArray neckLine(sf::PrimitiveType::LineStrip, neckSegs + 1);
-    sf::Vector2f neckTop;
+    std::array<sf::Vertex, neckSegs + 1> neck;
     for (int i = 0; i <= neckSegs; i++) {
         float frac = static_cast<float>(i) / static_cast<float>(neckSegs);
         // S-curve wiggle that travels up the neck
         float sway = std::sin(t * wiggleSpeed * 0.8f + frac * 3.5f) * wiggleAmp * 0.6f * (1.0f - frac * 0.3f);
         float px = neckBase.x + dir * frac * 6.0f + sway;
         float py = neckBase.y - frac * neckHeight;
-        neckLine[i] = sf::Vertex{{px, py}, dc};
-        if (i == neckSegs) neckTop = {px, py};
+        neck[i] = sf::Vertex{{px, py}, dc};
     }
-    target.draw(neckLine);
+    sf::Vector2f neckTop = neck[neckSegs].position;
+    batch.lineStrip(neck.data(), neck.size());
 
     // Thicken the neck with parallel lines, tapering toward the head
     for (float offset : {-2.0f, 2.0f, -1.0f, 1.0f}) {
-        sf::VertexArray neckThick(sf::PrimitiveType::LineStrip, neckSegs + 1);
+        auto thick = neck;
         for (int i = 0; i <= neckSegs; i++) {
             float frac = static_cast<float>(i) / static_cast<float>(neckSegs);
             float thickness = (1.0f - frac * 0.4f); // taper toward head
-            neckThick[i] = neckLine[i];
-            neckThick[i].position.x += offset * thickness;
+            thick[i].position.x += offset * thickness;
         }
-        target.draw(neckThick);
+        batch.lineStrip(thick.data(), thick.size());
     }
 
     // --- Hood: flared shape behind the head, wiggles slightly ---
@@ -475,56 +536,38 @@ void StickFigure::drawCobra(sf::RenderTarget& target) const {
     float hx = neckTop.x + dir * 2.0f + hoodSway * 0.3f;
     float hy = neckTop.y;
 
-    sf::ConvexShape hood(7);
-    hood.setPoint(0, {hx - 14.0f,             hy + 6.0f});
-    hood.setPoint(1, {hx - 12.0f + hoodSway,  hy - 4.0f});
-    hood.setPoint(2, {hx - 6.0f,              hy - 10.0f});
-    hood.setPoint(3, {hx,                     hy - 13.0f});
-    hood.setPoint(4, {hx + 6.0f,              hy - 10.0f});
-    hood.setPoint(5, {hx + 12.0f - hoodSway,  hy - 4.0f});
-    hood.setPoint(6, {hx + 14.0f,             hy + 6.0f});
-    hood.setFillColor(dc);
-    hood.setOutlineColor(sf::Color::Black);
-    hood.setOutlineThickness(1.0f);
-    target.draw(hood);
+    batch.convex({{hx - 14.0f,             hy + 6.0f},
+                 {hx - 12.0f + hoodSway,  hy - 4.0f},
+                 {hx - 6.0f,              hy - 10.0f},
+                 {hx,                     hy - 13.0f},
+                 {hx + 6.0f,              hy - 10.0f},
+                 {hx + 12.0f - hoodSway,  hy - 4.0f},
+                 {hx + 14.0f,             hy + 6.0f}},
+                dc, sf::Color::Black, 1.0f);
 
     // Hood pattern (lighter belly stripe)
-    sf::ConvexShape hoodBelly(5);
     sf::Color bellyColor = {
         static_cast<uint8_t>(std::min(255, dc.r + 60)),
         static_cast<uint8_t>(std::min(255, dc.g + 60)),
         static_cast<uint8_t>(std::min(255, dc.b + 20)),
         dc.a
     };
-    hoodBelly.setPoint(0, {hx - 6.0f, hy + 4.0f});
-    hoodBelly.setPoint(1, {hx - 4.0f, hy - 3.0f});
-    hoodBelly.setPoint(2, {hx,        hy - 6.0f});
-    hoodBelly.setPoint(3, {hx + 4.0f, hy - 3.0f});
-    hoodBelly.setPoint(4, {hx + 6.0f, hy + 4.0f});
-    hoodBelly.setFillColor(bellyColor);
-    target.draw(hoodBelly);
+    batch.convex({{hx - 6.0f, hy + 4.0f},
+                 {hx - 4.0f, hy - 3.0f},
+                 {hx,        hy - 6.0f},
+                 {hx + 4.0f, hy - 3.0f},
+                 {hx + 6.0f, hy + 4.0f}},
+                bellyColor);
 
     // --- Head ---
-    sf::CircleShape head(6.0f);
-    head.setOrigin({6.0f, 6.0f});
-    head.setPosition({hx + dir * 2.0f, hy - 11.0f});
-    head.setFillColor(dc);
-    head.setOutlineColor(sf::Color::Black);
-    head.setOutlineThickness(1.0f);
-    target.draw(head);
+    batch.circle({hx + dir * 2.0f, hy - 11.0f}, 6.0f, dc, 30, sf::Color::Black, 1.0f);
 
     // Eyes (menacing, red with slit pupils)
     for (float s : {-1.0f, 1.0f}) {
-        sf::CircleShape eye(2.0f); eye.setOrigin({2.0f, 2.0f});
-        eye.setPosition({hx + dir * 2.0f + s * 3.5f, hy - 12.0f});
-        eye.setFillColor(sf::Color::Yellow);
-        target.draw(eye);
+        sf::Vector2f eyePos = {hx + dir * 2.0f + s * 3.5f, hy - 12.0f};
+        batch.circle(eyePos, 2.0f, sf::Color::Yellow);
         // Slit pupil
-        sf::RectangleShape pupil({1.0f, 3.0f});
-        pupil.setOrigin({0.5f, 1.5f});
-        pupil.setPosition(eye.getPosition());
-        pupil.setFillColor(sf::Color::Black);
-        target.draw(pupil);
+        batch.rect(eyePos, {1.0f, 3.0f}, {0.5f, 1.5f}, 0.0f, sf::Color::Black);
     }
 
     // --- Tongue: forked, with flicker animation ---
@@ -534,41 +577,29 @@ void StickFigure::drawCobra(sf::RenderTarget& target) const {
         float tongueLen = 8.0f + tongueFlicker * 4.0f;
         sf::Vector2f tongueStart = {hx + dir * 8.0f, hy - 10.0f};
         float forkAngle = 0.25f + tongueFlicker * 0.1f;
+        sf::Vector2f fork = {tongueStart.x + dir * tongueLen, tongueStart.y};
 
-        sf::VertexArray tongue(sf::PrimitiveType::LineStrip, 3);
-        tongue[0] = sf::Vertex{tongueStart, sf::Color::Red};
-        tongue[1] = sf::Vertex{{tongueStart.x + dir * tongueLen, tongueStart.y}, sf::Color::Red};
-        tongue[2] = sf::Vertex{{tongueStart.x + dir * (tongueLen + 4.0f),
-                                tongueStart.y - forkAngle * 8.0f}, sf::Color::Red};
-        target.draw(tongue);
-
-        sf::VertexArray tongue2(sf::PrimitiveType::Lines, 2);
-        tongue2[0] = sf::Vertex{{tongueStart.x + dir * tongueLen, tongueStart.y}, sf::Color::Red};
-        tongue2[1] = sf::Vertex{{tongueStart.x + dir * (tongueLen + 4.0f),
-                                 tongueStart.y + forkAngle * 8.0f}, sf::Color::Red};
-        target.draw(tongue2);
+        batch.line(tongueStart, fork, sf::Color::Red);
+        batch.line(fork, {tongueStart.x + dir * (tongueLen + 4.0f), tongueStart.y - forkAngle * 8.0f}, sf::Color::Red);
+        batch.line(fork, {tongueStart.x + dir * (tongueLen + 4.0f), tongueStart.y + forkAngle * 8.0f}, sf::Color::Red);
     }
 
     // --- Scale pattern along the neck (diamond shapes) ---
+    sf::Color scaleColor = {
+        static_cast<uint8_t>(std::min(255, static_cast<int>(dc.r) + 40)),
+        static_cast<uint8_t>(std::min(255, static_cast<int>(dc.g) + 20)),
+        dc.b, dc.a
+    };
     for (int i = 2; i <= neckSegs - 2; i += 2) {
-        sf::Vector2f pos = neckLine[i].position;
         float frac = static_cast<float>(i) / static_cast<float>(neckSegs);
         float scaleSize = 2.5f * (1.0f - frac * 0.3f);
-        sf::CircleShape scale(scaleSize, 4);
-        scale.setOrigin({scaleSize, scaleSize});
-        scale.setPosition(pos);
-        sf::Color scaleColor = {
-            static_cast<uint8_t>(std::min(255, static_cast<int>(dc.r) + 40)),
-            static_cast<uint8_t>(std::min(255, static_cast<int>(dc.g) + 20)),
-            dc.b, dc.a
-        };
-        scale.setFillColor(scaleColor);
-        target.draw(scale);
+        batch.circle(neck[i].position, scaleSize, scaleColor, 4);
     }
 }
 
-void StickFigure::drawUnicorn(sf::RenderTarget& target) const {
+void StickFigure::drawUnicorn(ShapeBatch& batch) const {
     sf::Color dc = (m_damageFlashTimer > 0.0f) ? sf::Color::White : m_color;
+    sf::Color edge(dc.r / 2, dc.g / 2, dc.b / 2);
     b2Vec2 tp = b2Body_GetPosition(m_torso);
     sf::Vector2f c = toScreen(tp);
     float dir = static_cast<float>(m_facingDir);
@@ -584,34 +615,19 @@ void StickFigure::drawUnicorn(sf::RenderTarget& target) const {
     };
 
     // --- Body (barrel) ---
-    sf::RectangleShape body({36.0f, 20.0f});
-    body.setOrigin({18.0f, 10.0f});
-    body.setPosition(c);
-    body.setFillColor(dc);
-    body.setOutlineColor(sf::Color(dc.r / 2, dc.g / 2, dc.b / 2));
-    body.setOutlineThickness(1.0f);
-    target.draw(body);
+    batch.rect(c, {36.0f, 20.0f}, {18.0f, 10.0f}, 0.0f, dc, edge, 1.0f);
 
     // --- Legs (4 legs with slight animation) ---
-    float gallop = std::sin(t * 8.0f);
     b2Vec2 vel = b2Body_GetLinearVelocity(m_torso);
     float speed = std::sqrt(vel.x * vel.x);
-    float legAnim = speed > 1.0f ? gallop * 6.0f : 0.0f;
     float legOffsets[4] = {-0.35f, -0.12f, 0.12f, 0.35f};
     float legPhases[4] = {0.0f, 3.14159f, 0.0f, 3.14159f}; // diagonal pairs
     for (int i = 0; i < 4; i++) {
         float lx = c.x + legOffsets[i] * 36.0f;
         float anim = speed > 1.0f ? std::sin(t * 8.0f + legPhases[i]) * 6.0f : 0.0f;
-        sf::VertexArray leg(sf::PrimitiveType::Lines, 2);
-        leg[0] = sf::Vertex{{lx, c.y + 10.0f}, dc};
-        leg[1] = sf::Vertex{{lx + anim * 0.3f, c.y + 24.0f}, dc};
-        target.draw(leg);
+        batch.line({lx, c.y + 10.0f}, {lx + anim * 0.3f, c.y + 24.0f}, dc);
         // Hooves
-        sf::CircleShape hoof(2.5f);
-        hoof.setOrigin({2.5f, 2.5f});
-        hoof.setPosition({lx + anim * 0.3f, c.y + 25.0f});
-        hoof.setFillColor(sf::Color(60, 60, 60));
-        target.draw(hoof);
+        batch.circle({lx + anim * 0.3f, c.y + 25.0f}, 2.5f, sf::Color(60, 60, 60));
     }
 
     // --- Neck (angled up from front of body) ---
@@ -619,118 +635,80 @@ void StickFigure::drawUnicorn(sf::RenderTarget& target) const {
     float neckBaseY = c.y - 6.0f;
     float neckTopX = neckBaseX + dir * 12.0f;
     float neckTopY = neckBaseY - 22.0f;
-    // Thick neck with convex shape
-    sf::ConvexShape neck(4);
-    neck.setPoint(0, {neckBaseX - dir * 5.0f, neckBaseY});
-    neck.setPoint(1, {neckBaseX + dir * 3.0f, neckBaseY});
-    neck.setPoint(2, {neckTopX + dir * 2.0f, neckTopY + 4.0f});
-    neck.setPoint(3, {neckTopX - dir * 4.0f, neckTopY + 4.0f});
-    neck.setFillColor(dc);
-    target.draw(neck);
+    batch.convex({{neckBaseX - dir * 5.0f, neckBaseY},
+                 {neckBaseX + dir * 3.0f, neckBaseY},
+                 {neckTopX + dir * 2.0f, neckTopY + 4.0f},
+                 {neckTopX - dir * 4.0f, neckTopY + 4.0f}},
+                dc);
 
     // --- Head (elongated oval) ---
     float headX = neckTopX + dir * 6.0f;
     float headY = neckTopY;
-    sf::CircleShape headShape(8.0f);
-    headShape.setScale({1.4f, 1.0f});
-    headShape.setOrigin({8.0f, 8.0f});
-    headShape.setPosition({headX, headY});
-    headShape.setFillColor(dc);
-    headShape.setOutlineColor(sf::Color(dc.r / 2, dc.g / 2, dc.b / 2));
-    headShape.setOutlineThickness(1.0f);
-    target.draw(headShape);
+    batch.ellipse({headX, headY}, 8.0f * 1.4f, 8.0f, dc, edge, 1.0f);
 
     // Snout extension
-    sf::ConvexShape snout(4);
-    snout.setPoint(0, {headX + dir * 6.0f, headY - 3.0f});
-    snout.setPoint(1, {headX + dir * 16.0f, headY - 1.0f});
-    snout.setPoint(2, {headX + dir * 16.0f, headY + 3.0f});
-    snout.setPoint(3, {headX + dir * 6.0f, headY + 5.0f});
-    snout.setFillColor(dc);
-    snout.setOutlineColor(sf::Color(dc.r / 2, dc.g / 2, dc.b / 2));
-    snout.setOutlineThickness(1.0f);
-    target.draw(snout);
+    batch.convex({{headX + dir * 6.0f, headY - 3.0f},
+                 {headX + dir * 16.0f, headY - 1.0f},
+                 {headX + dir * 16.0f, headY + 3.0f},
+                 {headX + dir * 6.0f, headY + 5.0f}},
+                dc, edge, 1.0f);
 
     // Eye
-    sf::CircleShape eye(2.5f);
-    eye.setOrigin({2.5f, 2.5f});
-    eye.setPosition({headX + dir * 4.0f, headY - 2.0f});
-    eye.setFillColor(sf::Color(50, 0, 100));
-    target.draw(eye);
+    batch.circle({headX + dir * 4.0f, headY - 2.0f}, 2.5f, sf::Color(50, 0, 100));
     // Eye highlight
-    sf::CircleShape eyeHighlight(1.0f);
-    eyeHighlight.setOrigin({1.0f, 1.0f});
-    eyeHighlight.setPosition({headX + dir * 4.5f, headY - 3.0f});
-    eyeHighlight.setFillColor(sf::Color::White);
-    target.draw(eyeHighlight);
+    batch.circle({headX + dir * 4.5f, headY - 3.0f}, 1.0f, sf::Color::White);
 
     // Nostril
-    sf::CircleShape nostril(1.0f);
-    nostril.setOrigin({1.0f, 1.0f});
-    nostril.setPosition({headX + dir * 14.0f, headY + 1.0f});
-    nostril.setFillColor(sf::Color(dc.r / 2, dc.g / 2, dc.b / 2));
-    target.draw(nostril);
+    batch.circle({headX + dir * 14.0f, headY + 1.0f}, 1.0f, edge);
 
     // --- Ear ---
-    sf::ConvexShape ear(3);
-    ear.setPoint(0, {headX - dir * 2.0f, headY - 6.0f});
-    ear.setPoint(1, {headX,              headY - 16.0f});
-    ear.setPoint(2, {headX + dir * 4.0f, headY - 7.0f});
-    ear.setFillColor(dc);
-    ear.setOutlineColor(sf::Color(dc.r / 2, dc.g / 2, dc.b / 2));
-    ear.setOutlineThickness(1.0f);
-    target.draw(ear);
+    batch.convex({{headX - dir * 2.0f, headY - 6.0f},
+                 {headX,              headY - 16.0f},
+                 {headX + dir * 4.0f, headY - 7.0f}},
+                dc, edge, 1.0f);
 
     // --- HORN (magical, spiraling, with rainbow glow) ---
     float hornBaseX = headX + dir * 2.0f;
     float hornBaseY = headY - 12.0f;
     float hornLen = 22.0f;
     float hornAngle = -1.2f; // angled forward-up
+    float hornCos = std::cos(hornAngle), hornSin = std::sin(hornAngle);
 
     // Spiral lines for the horn
     constexpr int hornSegs = 16;
-    sf::VertexArray hornLine(sf::PrimitiveType::LineStrip, hornSegs + 1);
+    std::array<sf::Vertex, hornSegs + 1> horn;
     for (int i = 0; i <= hornSegs; i++) {
         float frac = static_cast<float>(i) / static_cast<float>(hornSegs);
         float spiralOffset = std::sin(frac * 12.0f + t * 3.0f) * (3.0f - frac * 2.5f);
-        float hx = hornBaseX + dir * std::cos(hornAngle) * hornLen * frac;
-        float hy = hornBaseY + std::sin(hornAngle) * hornLen * frac + spiralOffset;
+        float hx = hornBaseX + dir * hornCos * hornLen * frac;
+        float hy = hornBaseY + hornSin * hornLen * frac + spiralOffset;
         sf::Color hc = rainbow(frac * 6.28f);
         // Brighten toward tip
         hc.r = static_cast<uint8_t>(std::min(255, hc.r + static_cast<int>(frac * 100)));
         hc.g = static_cast<uint8_t>(std::min(255, hc.g + static_cast<int>(frac * 100)));
         hc.b = static_cast<uint8_t>(std::min(255, hc.b + static_cast<int>(frac * 100)));
-        hornLine[i] = sf::Vertex{{hx, hy}, hc};
+        horn[i] = sf::Vertex{{hx, hy}, hc};
     }
-    target.draw(hornLine);
+    batch.lineStrip(horn.data(), horn.size());
     // Thicken horn with parallel offsets
     for (float off : {-1.5f, 1.5f, -0.7f, 0.7f}) {
-        sf::VertexArray thick(sf::PrimitiveType::LineStrip, hornSegs + 1);
+        auto thick = horn;
         for (int i = 0; i <= hornSegs; i++) {
             float frac = static_cast<float>(i) / static_cast<float>(hornSegs);
             float taper = 1.0f - frac * 0.8f;
-            thick[i] = hornLine[i];
             thick[i].position.x += off * taper * 0.3f;
             thick[i].position.y += off * taper;
         }
-        target.draw(thick);
+        batch.lineStrip(thick.data(), thick.size());
     }
 
     // Horn tip sparkle
     {
         float sparkle = std::sin(t * 10.0f) * 0.5f + 0.5f;
-        sf::Vector2f tip = hornLine[hornSegs].position;
-        sf::CircleShape spark(2.0f + sparkle * 2.0f);
-        spark.setOrigin({spark.getRadius(), spark.getRadius()});
-        spark.setPosition(tip);
-        spark.setFillColor(sf::Color(255, 255, 255, static_cast<uint8_t>(150 + sparkle * 105)));
-        target.draw(spark);
+        sf::Vector2f tip = horn[hornSegs].position;
+        batch.circle(tip, 2.0f + sparkle * 2.0f, sf::Color(255, 255, 255, static_cast<uint8_t>(150 + sparkle * 105)));
         // Smaller colored spark
-        sf::CircleShape spark2(1.0f + sparkle * 1.5f);
-        spark2.setOrigin({spark2.getRadius(), spark2.getRadius()});
-        spark2.setPosition(tip);
-        spark2.setFillColor(rainbow(t * 3.0f));
-        target.draw(spark2);
+        batch.circle(tip, 1.0f + sparkle * 1.5f, rainbow(t * 3.0f));
     }
 
     // --- Mane (rainbow flowing hair along neck) ---
@@ -740,7 +718,7 @@ void StickFigure::drawUnicorn(sf::RenderTarget& target) const {
         float startX = neckBaseX + (neckTopX - neckBaseX) * sf2;
         float startY = neckBaseY + (neckTopY - neckBaseY) * sf2 - 2.0f;
 
-        sf::VertexArray strand(sf::PrimitiveType::LineStrip, 5);
+        sf::Vertex strand[5];
         for (int j = 0; j < 5; j++) {
             float jf = static_cast<float>(j) / 4.0f;
             float wave = std::sin(t * 3.0f + sf2 * 4.0f + jf * 3.0f) * (4.0f + jf * 6.0f);
@@ -748,7 +726,7 @@ void StickFigure::drawUnicorn(sf::RenderTarget& target) const {
             float py = startY - jf * 4.0f + wave;
             strand[j] = sf::Vertex{{px, py}, rainbow(sf2 * 6.28f + jf * 2.0f)};
         }
-        target.draw(strand);
+        batch.lineStrip(strand, 5);
     }
 
     // --- Tail (flowing rainbow) ---
@@ -757,7 +735,7 @@ void StickFigure::drawUnicorn(sf::RenderTarget& target) const {
     constexpr int tailStrands = 5;
     for (int s = 0; s < tailStrands; s++) {
         float sf2 = static_cast<float>(s) / static_cast<float>(tailStrands);
-        sf::VertexArray strand(sf::PrimitiveType::LineStrip, 6);
+        sf::Vertex strand[6];
         for (int j = 0; j < 6; j++) {
             float jf = static_cast<float>(j) / 5.0f;
             float wave = std::sin(t * 2.5f + sf2 * 3.0f + jf * 4.0f) * (5.0f + jf * 8.0f);
@@ -765,7 +743,7 @@ void StickFigure::drawUnicorn(sf::RenderTarget& target) const {
             float py = tailBaseY + sf2 * 4.0f - 2.0f + wave;
             strand[j] = sf::Vertex{{px, py}, rainbow(sf2 * 6.28f + jf * 1.5f + 3.0f)};
         }
-        target.draw(strand);
+        batch.lineStrip(strand, 6);
     }
 
     // --- Magical particles around the unicorn (subtle sparkles) ---
@@ -774,16 +752,14 @@ void StickFigure::drawUnicorn(sf::RenderTarget& target) const {
         float px = c.x + std::cos(t * 1.5f + phase) * 25.0f;
         float py = c.y - 10.0f + std::sin(t * 2.0f + phase) * 15.0f;
         float sz = 1.0f + std::sin(t * 5.0f + phase) * 0.8f;
-        sf::CircleShape sparkle(sz, 4); // diamond shape
-        sparkle.setOrigin({sz, sz});
-        sparkle.setPosition({px, py});
-        sparkle.setFillColor(sf::Color(255, 255, 255, static_cast<uint8_t>(80 + std::sin(t * 4.0f + phase) * 60)));
-        target.draw(sparkle);
+        batch.circle({px, py}, sz,  // diamond shape
+                    sf::Color(255, 255, 255, static_cast<uint8_t>(80 + std::sin(t * 4.0f + phase) * 60)), 4);
     }
 }
 
-void StickFigure::drawCrocodile(sf::RenderTarget& target) const {
+void StickFigure::drawCrocodile(ShapeBatch& batch) const {
     sf::Color dc = (m_damageFlashTimer > 0.0f) ? sf::Color::White : m_color;
+    sf::Color edge(dc.r / 2, dc.g / 2, dc.b / 2);
     b2Vec2 tp = b2Body_GetPosition(m_torso);
     sf::Vector2f c = toScreen(tp);
     float dir = static_cast<float>(m_facingDir);
@@ -802,7 +778,7 @@ void StickFigure::drawCrocodile(sf::RenderTarget& target) const {
     float tailBaseX = c.x - dir * 20.0f;
     float tailBaseY = c.y + 2.0f;
     constexpr int tailSegs = 10;
-    sf::VertexArray tail(sf::PrimitiveType::LineStrip, tailSegs + 1);
+    std::array<sf::Vertex, tailSegs + 1> tail;
     float swish = speed > 1.0f ? std::sin(t * 6.0f) * 8.0f : std::sin(t * 1.5f) * 3.0f;
     for (int i = 0; i <= tailSegs; i++) {
         float frac = static_cast<float>(i) / static_cast<float>(tailSegs);
@@ -811,73 +787,51 @@ void StickFigure::drawCrocodile(sf::RenderTarget& target) const {
         float ty = tailBaseY + frac * 6.0f + wave;
         tail[i] = sf::Vertex{{tx, ty}, dc};
     }
-    target.draw(tail);
+    batch.lineStrip(tail.data(), tail.size());
     // Tail thickness passes
     for (float off : {-2.5f, 2.5f, -1.2f, 1.2f}) {
-        sf::VertexArray thick(sf::PrimitiveType::LineStrip, tailSegs + 1);
+        auto thick = tail;
         for (int i = 0; i <= tailSegs; i++) {
             float frac = static_cast<float>(i) / static_cast<float>(tailSegs);
             float taper = 1.0f - frac * 0.7f;
-            thick[i] = tail[i];
             thick[i].position.y += off * taper;
         }
-        target.draw(thick);
+        batch.lineStrip(thick.data(), thick.size());
     }
 
     // --- Body (long, low rectangle) ---
-    sf::ConvexShape body(6);
-    body.setPoint(0, {c.x - dir * 20.0f, c.y - 8.0f});
-    body.setPoint(1, {c.x + dir * 12.0f, c.y - 10.0f});
-    body.setPoint(2, {c.x + dir * 20.0f, c.y - 6.0f});
-    body.setPoint(3, {c.x + dir * 20.0f, c.y + 8.0f});
-    body.setPoint(4, {c.x - dir * 10.0f, c.y + 10.0f});
-    body.setPoint(5, {c.x - dir * 20.0f, c.y + 6.0f});
-    body.setFillColor(dc);
-    body.setOutlineColor(sf::Color(dc.r / 2, dc.g / 2, dc.b / 2));
-    body.setOutlineThickness(1.0f);
-    target.draw(body);
+    batch.convex({{c.x - dir * 20.0f, c.y - 8.0f},
+                 {c.x + dir * 12.0f, c.y - 10.0f},
+                 {c.x + dir * 20.0f, c.y - 6.0f},
+                 {c.x + dir * 20.0f, c.y + 8.0f},
+                 {c.x - dir * 10.0f, c.y + 10.0f},
+                 {c.x - dir * 20.0f, c.y + 6.0f}},
+                dc, edge, 1.0f);
 
     // Belly stripe
-    sf::ConvexShape bellyShape(4);
-    bellyShape.setPoint(0, {c.x - dir * 14.0f, c.y + 2.0f});
-    bellyShape.setPoint(1, {c.x + dir * 14.0f, c.y + 1.0f});
-    bellyShape.setPoint(2, {c.x + dir * 12.0f, c.y + 8.0f});
-    bellyShape.setPoint(3, {c.x - dir * 10.0f, c.y + 9.0f});
-    bellyShape.setFillColor(belly);
-    target.draw(bellyShape);
+    batch.convex({{c.x - dir * 14.0f, c.y + 2.0f},
+                 {c.x + dir * 14.0f, c.y + 1.0f},
+                 {c.x + dir * 12.0f, c.y + 8.0f},
+                 {c.x - dir * 10.0f, c.y + 9.0f}},
+                belly);
 
     // Scutes (back ridges)
+    sf::Color scuteColor(dc.r * 3 / 4, dc.g * 3 / 4, dc.b * 3 / 4);
     for (int i = 0; i < 6; i++) {
         float sx = c.x - dir * 14.0f + dir * static_cast<float>(i) * 6.0f;
-        sf::ConvexShape scute(3);
-        scute.setPoint(0, {sx - 2.0f, c.y - 8.0f});
-        scute.setPoint(1, {sx, c.y - 13.0f});
-        scute.setPoint(2, {sx + 2.0f, c.y - 8.0f});
-        scute.setFillColor(sf::Color(dc.r * 3 / 4, dc.g * 3 / 4, dc.b * 3 / 4));
-        target.draw(scute);
+        batch.convex({{sx - 2.0f, c.y - 8.0f}, {sx, c.y - 13.0f}, {sx + 2.0f, c.y - 8.0f}}, scuteColor);
     }
 
     // --- Legs (4 stubby legs) ---
-    float legAnim = speed > 1.0f ? std::sin(t * 8.0f) * 4.0f : 0.0f;
     float legPositions[4] = {-0.30f, -0.10f, 0.15f, 0.35f};
     float legPhases[4] = {0.0f, 3.14159f, 0.0f, 3.14159f};
     for (int i = 0; i < 4; i++) {
         float lx = c.x + dir * legPositions[i] * 45.0f;
         float anim = speed > 1.0f ? std::sin(t * 8.0f + legPhases[i]) * 4.0f : 0.0f;
-        sf::RectangleShape leg({4.0f, 14.0f});
-        leg.setOrigin({2.0f, 0.0f});
-        leg.setPosition({lx, c.y + 8.0f});
-        leg.setRotation(sf::degrees(anim));
-        leg.setFillColor(dc);
-        target.draw(leg);
+        batch.rect({lx, c.y + 8.0f}, {4.0f, 14.0f}, {2.0f, 0.0f}, anim, dc);
         // Claws
-        for (float cx2 : {-1.5f, 0.0f, 1.5f}) {
-            sf::CircleShape claw(1.0f);
-            claw.setOrigin({1.0f, 1.0f});
-            claw.setPosition({lx + cx2, c.y + 22.0f});
-            claw.setFillColor(sf::Color(60, 60, 50));
-            target.draw(claw);
-        }
+        for (float cx2 : {-1.5f, 0.0f, 1.5f})
+            batch.circle({lx + cx2, c.y + 22.0f}, 1.0f, sf::Color(60, 60, 50));
     }
 
     // --- Head / Snout (the distinctive long jaw) ---
@@ -892,84 +846,52 @@ void StickFigure::drawCrocodile(sf::RenderTarget& target) const {
     }
 
     // Upper jaw
-    sf::ConvexShape upperJaw(5);
-    upperJaw.setPoint(0, {headX, headY - 6.0f});
-    upperJaw.setPoint(1, {headX + dir * 8.0f, headY - 7.0f - jawOpen * 0.3f});
-    upperJaw.setPoint(2, {headX + dir * 28.0f, headY - 3.0f - jawOpen * 0.5f});
-    upperJaw.setPoint(3, {headX + dir * 30.0f, headY - jawOpen * 0.2f});
-    upperJaw.setPoint(4, {headX, headY + 2.0f});
-    upperJaw.setFillColor(dc);
-    upperJaw.setOutlineColor(sf::Color(dc.r / 2, dc.g / 2, dc.b / 2));
-    upperJaw.setOutlineThickness(1.0f);
-    target.draw(upperJaw);
+    batch.convex({{headX, headY - 6.0f},
+                 {headX + dir * 8.0f, headY - 7.0f - jawOpen * 0.3f},
+                 {headX + dir * 28.0f, headY - 3.0f - jawOpen * 0.5f},
+                 {headX + dir * 30.0f, headY - jawOpen * 0.2f},
+                 {headX, headY + 2.0f}},
+                dc, edge, 1.0f);
 
     // Lower jaw
-    sf::ConvexShape lowerJaw(4);
-    lowerJaw.setPoint(0, {headX, headY + 2.0f});
-    lowerJaw.setPoint(1, {headX + dir * 26.0f, headY + 2.0f + jawOpen * 0.5f});
-    lowerJaw.setPoint(2, {headX + dir * 24.0f, headY + 7.0f + jawOpen * 0.4f});
-    lowerJaw.setPoint(3, {headX - dir * 2.0f, headY + 8.0f});
-    lowerJaw.setFillColor(belly);
-    lowerJaw.setOutlineColor(sf::Color(dc.r / 2, dc.g / 2, dc.b / 2));
-    lowerJaw.setOutlineThickness(1.0f);
-    target.draw(lowerJaw);
+    batch.convex({{headX, headY + 2.0f},
+                 {headX + dir * 26.0f, headY + 2.0f + jawOpen * 0.5f},
+                 {headX + dir * 24.0f, headY + 7.0f + jawOpen * 0.4f},
+                 {headX - dir * 2.0f, headY + 8.0f}},
+                belly, edge, 1.0f);
 
     // Teeth (upper)
     for (int i = 0; i < 5; i++) {
         float tx = headX + dir * (6.0f + static_cast<float>(i) * 5.0f);
         float ty = headY + 1.0f - jawOpen * 0.15f;
-        sf::ConvexShape tooth(3);
-        tooth.setPoint(0, {tx - 1.0f, ty});
-        tooth.setPoint(1, {tx, ty + 4.0f + jawOpen * 0.1f});
-        tooth.setPoint(2, {tx + 1.0f, ty});
-        tooth.setFillColor(sf::Color(240, 235, 210));
-        target.draw(tooth);
+        batch.convex({{tx - 1.0f, ty}, {tx, ty + 4.0f + jawOpen * 0.1f}, {tx + 1.0f, ty}},
+                    sf::Color(240, 235, 210));
     }
     // Teeth (lower)
     for (int i = 0; i < 4; i++) {
         float tx = headX + dir * (8.0f + static_cast<float>(i) * 5.0f);
         float ty = headY + 3.0f + jawOpen * 0.4f;
-        sf::ConvexShape tooth(3);
-        tooth.setPoint(0, {tx - 1.0f, ty});
-        tooth.setPoint(1, {tx, ty - 3.5f - jawOpen * 0.1f});
-        tooth.setPoint(2, {tx + 1.0f, ty});
-        tooth.setFillColor(sf::Color(230, 225, 200));
-        target.draw(tooth);
+        batch.convex({{tx - 1.0f, ty}, {tx, ty - 3.5f - jawOpen * 0.1f}, {tx + 1.0f, ty}},
+                    sf::Color(230, 225, 200));
     }
 
     // Nostril bumps at tip of snout
-    for (float ns : {-1.5f, 1.5f}) {
-        sf::CircleShape nostril(1.5f);
-        nostril.setOrigin({1.5f, 1.5f});
-        nostril.setPosition({headX + dir * 28.0f, headY - 4.0f + ns});
-        nostril.setFillColor(sf::Color(dc.r * 3 / 4, dc.g * 3 / 4, dc.b / 2));
-        target.draw(nostril);
-    }
+    for (float ns : {-1.5f, 1.5f})
+        batch.circle({headX + dir * 28.0f, headY - 4.0f + ns}, 1.5f, sf::Color(dc.r * 3 / 4, dc.g * 3 / 4, dc.b / 2));
 
     // Eyes (menacing, slit pupils on bumps)
     for (float es : {-1.0f, 1.0f}) {
+        float ex = headX + dir * 4.0f + es * 3.0f * (dir > 0 ? 1.0f : -1.0f);
         // Eye bump
-        sf::CircleShape eyeBump(3.5f);
-        eyeBump.setOrigin({3.5f, 3.5f});
-        eyeBump.setPosition({headX + dir * 4.0f + es * 3.0f * (dir > 0 ? 1.0f : -1.0f), headY - 9.0f});
-        eyeBump.setFillColor(dc);
-        target.draw(eyeBump);
+        batch.circle({ex, headY - 9.0f}, 3.5f, dc);
         // Eye
-        sf::CircleShape eye(2.5f);
-        eye.setOrigin({2.5f, 2.5f});
-        eye.setPosition({headX + dir * 4.0f + es * 3.0f * (dir > 0 ? 1.0f : -1.0f), headY - 10.0f});
-        eye.setFillColor(sf::Color(200, 180, 50));
-        target.draw(eye);
+        batch.circle({ex, headY - 10.0f}, 2.5f, sf::Color(200, 180, 50));
         // Slit pupil
-        sf::RectangleShape pupil({1.0f, 4.0f});
-        pupil.setOrigin({0.5f, 2.0f});
-        pupil.setPosition({headX + dir * 4.0f + es * 3.0f * (dir > 0 ? 1.0f : -1.0f), headY - 10.0f});
-        pupil.setFillColor(sf::Color::Black);
-        target.draw(pupil);
+        batch.rect({ex, headY - 10.0f}, {1.0f, 4.0f}, {0.5f, 2.0f}, 0.0f, sf::Color::Black);
     }
 }
 
-void StickFigure::drawStickLady(sf::RenderTarget& target) const {
+void StickFigure::drawStickLady(ShapeBatch& batch) const {
     sf::Color dc = (m_damageFlashTimer > 0.0f) ? sf::Color::White : m_color;
     float dir = static_cast<float>(m_facingDir);
     float t = m_animTime;
@@ -977,7 +899,6 @@ void StickFigure::drawStickLady(sf::RenderTarget& target) const {
     b2Vec2 tp = b2Body_GetPosition(m_torso);
     b2Vec2 hp = b2Body_GetPosition(m_head);
     sf::Vector2f headSc = toScreen(hp);
-    sf::Vector2f torsoSc = toScreen(tp);
 
     b2Vec2 vel = b2Body_GetLinearVelocity(m_torso);
     float speed = std::sqrt(vel.x * vel.x);
@@ -993,7 +914,7 @@ void StickFigure::drawStickLady(sf::RenderTarget& target) const {
         float ax = headSc.x - dir * std::cos(attachAngle) * m_config.headRadius * PPM * 0.8f;
         float ay = headSc.y - std::sin(attachAngle) * m_config.headRadius * PPM * 0.4f;
 
-        sf::VertexArray strand(sf::PrimitiveType::LineStrip, 6);
+        sf::Vertex strand[6];
         for (int s = 0; s < 6; s++) {
             float sf2 = static_cast<float>(s) / 5.0f;
             float wave = std::sin(t * 3.0f + frac * 2.0f + sf2 * 4.0f) * (3.0f + speed * 0.5f);
@@ -1003,48 +924,30 @@ void StickFigure::drawStickLady(sf::RenderTarget& target) const {
             uint8_t alpha = static_cast<uint8_t>(255 * (1.0f - sf2 * 0.3f));
             strand[s] = sf::Vertex{{sx, sy}, sf::Color(dc.r, dc.g, dc.b, alpha)};
         }
-        target.draw(strand);
+        batch.lineStrip(strand, 6);
     }
 
     // --- Head (circle, same as stick but filled) ---
     float headR = m_config.headRadius * PPM;
-    sf::CircleShape headShape(headR);
-    headShape.setOrigin({headR, headR});
-    headShape.setPosition(headSc);
-    headShape.setFillColor(sf::Color::Transparent);
-    headShape.setOutlineColor(dc);
-    headShape.setOutlineThickness(2.0f);
-    target.draw(headShape);
+    batch.circle(headSc, headR, sf::Color::Transparent, 30, dc, 2.0f);
 
     // --- Eyelashes ---
     float eyeX = headSc.x + dir * headR * 0.4f;
     float eyeY = headSc.y - headR * 0.15f;
     // Eye dot
-    sf::CircleShape eye(2.0f);
-    eye.setOrigin({2.0f, 2.0f});
-    eye.setPosition({eyeX, eyeY});
-    eye.setFillColor(dc);
-    target.draw(eye);
+    batch.circle({eyeX, eyeY}, 2.0f, dc);
     // Three eyelash lines
     for (int i = 0; i < 3; i++) {
         float angle = -0.5f + static_cast<float>(i) * 0.5f; // fan out upward
         float lashLen = 4.0f + static_cast<float>(i == 1) * 2.0f; // middle is longest
-        sf::VertexArray lash(sf::PrimitiveType::Lines, 2);
-        lash[0] = sf::Vertex{{eyeX, eyeY - 2.0f}, dc};
-        lash[1] = sf::Vertex{{eyeX + std::sin(angle) * lashLen * dir,
-                               eyeY - 2.0f - std::cos(angle) * lashLen}, dc};
-        target.draw(lash);
+        batch.line({eyeX, eyeY - 2.0f},
+                  {eyeX + std::sin(angle) * lashLen * dir, eyeY - 2.0f - std::cos(angle) * lashLen}, dc);
     }
 
     // --- Body line (torso) ---
     b2Vec2 tTop = {tp.x, tp.y + m_config.bodyHeight / 4.0f};
     b2Vec2 tBot = {tp.x, tp.y - m_config.bodyHeight / 4.0f};
-    auto drawLine = [&](b2Vec2 s, b2Vec2 e) {
-        sf::VertexArray line(sf::PrimitiveType::Lines, 2);
-        line[0] = sf::Vertex{toScreen(s), dc};
-        line[1] = sf::Vertex{toScreen(e), dc};
-        target.draw(line);
-    };
+    auto drawLine = [&](b2Vec2 s, b2Vec2 e) { batch.line(toScreen(s), toScreen(e), dc); };
     drawLine(tTop, tBot);
 
     // --- Arms ---
@@ -1059,44 +962,28 @@ void StickFigure::drawStickLady(sf::RenderTarget& target) const {
     // Slight sway animation
     float sway = speed > 1.0f ? std::sin(t * 6.0f) * 3.0f : std::sin(t * 1.5f) * 1.0f;
 
-    sf::ConvexShape skirt(4);
-    skirt.setPoint(0, {waist.x - 3.0f, waist.y - 2.0f});
-    skirt.setPoint(1, {waist.x + 3.0f, waist.y - 2.0f});
-    skirt.setPoint(2, {waist.x + skirtWidth + sway, waist.y + skirtLen});
-    skirt.setPoint(3, {waist.x - skirtWidth + sway, waist.y + skirtLen});
     // Slightly lighter fill
     sf::Color skirtColor(
         static_cast<uint8_t>(std::min(255, dc.r + 30)),
         static_cast<uint8_t>(std::min(255, dc.g + 10)),
         static_cast<uint8_t>(std::min(255, dc.b + 40)));
-    skirt.setFillColor(skirtColor);
-    skirt.setOutlineColor(dc);
-    skirt.setOutlineThickness(1.0f);
-    target.draw(skirt);
+    batch.convex({{waist.x - 3.0f, waist.y - 2.0f},
+                 {waist.x + 3.0f, waist.y - 2.0f},
+                 {waist.x + skirtWidth + sway, waist.y + skirtLen},
+                 {waist.x - skirtWidth + sway, waist.y + skirtLen}},
+                skirtColor, dc, 1.0f);
 
     // Skirt hem detail line
-    sf::VertexArray hem(sf::PrimitiveType::Lines, 2);
-    hem[0] = sf::Vertex{{waist.x - skirtWidth * 0.8f + sway, waist.y + skirtLen - 2.0f}, dc};
-    hem[1] = sf::Vertex{{waist.x + skirtWidth * 0.8f + sway, waist.y + skirtLen - 2.0f}, dc};
-    target.draw(hem);
+    batch.line({waist.x - skirtWidth * 0.8f + sway, waist.y + skirtLen - 2.0f},
+              {waist.x + skirtWidth * 0.8f + sway, waist.y + skirtLen - 2.0f}, dc);
 
     // --- Legs (below skirt) ---
     sf::Vector2f leftLegSc = toScreen(b2Body_GetPosition(m_leftLeg));
     sf::Vector2f rightLegSc = toScreen(b2Body_GetPosition(m_rightLeg));
     // Legs start at bottom of skirt
     float legStartY = waist.y + skirtLen;
-    {
-        sf::VertexArray leg(sf::PrimitiveType::Lines, 2);
-        leg[0] = sf::Vertex{{leftLegSc.x, legStartY}, dc};
-        leg[1] = sf::Vertex{leftLegSc, dc};
-        target.draw(leg);
-    }
-    {
-        sf::VertexArray leg(sf::PrimitiveType::Lines, 2);
-        leg[0] = sf::Vertex{{rightLegSc.x, legStartY}, dc};
-        leg[1] = sf::Vertex{rightLegSc, dc};
-        target.draw(leg);
-    }
+    batch.line({leftLegSc.x, legStartY}, leftLegSc, dc);
+    batch.line({rightLegSc.x, legStartY}, rightLegSc, dc);
 
     // --- Purse (hangs from arm, swings during attack) ---
     float purseSwing = 0.0f;
@@ -1111,109 +998,67 @@ void StickFigure::drawStickLady(sf::RenderTarget& target) const {
     float purseY = armSc.y + 4.0f;
 
     // Strap
-    sf::VertexArray strap(sf::PrimitiveType::Lines, 2);
-    strap[0] = sf::Vertex{armSc, dc};
-    strap[1] = sf::Vertex{{purseX, purseY}, dc};
-    target.draw(strap);
+    batch.line(armSc, {purseX, purseY}, dc);
 
     // Purse body (small rectangle with flap)
     float purseAngle = purseSwing + std::sin(t * 2.0f) * 5.0f;
-    sf::RectangleShape purseBody({10.0f, 8.0f});
-    purseBody.setOrigin({5.0f, 0.0f});
-    purseBody.setPosition({purseX, purseY});
-    purseBody.setRotation(sf::degrees(purseAngle));
     // Purse is a contrasting color
     sf::Color purseColor(
         static_cast<uint8_t>(std::min(255, 255 - dc.r / 2)),
         static_cast<uint8_t>(std::min(255, dc.g / 3)),
         static_cast<uint8_t>(std::min(255, dc.b / 2 + 80)));
-    purseBody.setFillColor(purseColor);
-    purseBody.setOutlineColor(sf::Color(purseColor.r / 2, purseColor.g / 2, purseColor.b / 2));
-    purseBody.setOutlineThickness(1.0f);
-    target.draw(purseBody);
+    batch.rect({purseX, purseY}, {10.0f, 8.0f}, {5.0f, 0.0f}, purseAngle, purseColor,
+              sf::Color(purseColor.r / 2, purseColor.g / 2, purseColor.b / 2), 1.0f);
 
     // Clasp
-    sf::CircleShape clasp(1.5f);
-    clasp.setOrigin({1.5f, 1.5f});
-    clasp.setPosition({purseX, purseY + 2.0f});
-    clasp.setFillColor(sf::Color(200, 180, 100));
-    target.draw(clasp);
+    batch.circle({purseX, purseY + 2.0f}, 1.5f, sf::Color(200, 180, 100));
 }
 
-void StickFigure::drawAttackEffect(sf::RenderTarget& target) const {
+void StickFigure::drawAttackEffect(ShapeBatch& batch) const {
     sf::Vector2f sp = toScreen(getPosition());
     float dir = static_cast<float>(m_facingDir);
     float prog = 1.0f - (m_attackAnimTimer / 0.2f);
 
-    if (m_weapon.type == WeaponType::Melee && m_charType == CharacterType::StickLady) {
-        // Purse swing attack — wide arc with purse trail
+    if (m_weapon->type == WeaponType::Melee && m_charType == CharacterType::StickLady) {
+        // Purse swing attack — wide arc; the trail comes from the weapon's
+        // trail_particles
         float swingAngle = -120.0f + 240.0f * prog; // big swing arc
-        float swingRad = swingAngle * 3.14159f / 180.0f;
-        float swingR = m_weapon.range * PPM * 0.5f;
-        float purseX = sp.x + dir * std::cos(swingRad) * swingR;
-        float purseY = sp.y - 5.0f + std::sin(swingRad) * swingR;
-
-        // Trail particles
-        int trailCount = static_cast<int>(prog * 8);
-        for (int i = 0; i < trailCount; i++) {
-            float trailProg = prog - static_cast<float>(i) * 0.04f;
-            if (trailProg < 0.0f) continue;
-            float ta = -120.0f + 240.0f * trailProg;
-            float tr = ta * 3.14159f / 180.0f;
-            float tx = sp.x + dir * std::cos(tr) * swingR;
-            float ty = sp.y - 5.0f + std::sin(tr) * swingR;
-            float sz = 2.0f * (1.0f - static_cast<float>(i) * 0.1f);
-            sf::CircleShape trail(sz);
-            trail.setOrigin({sz, sz});
-            trail.setPosition({tx, ty});
-            uint8_t alpha = static_cast<uint8_t>(180 * (1.0f - static_cast<float>(i) * 0.12f));
-            trail.setFillColor(sf::Color(255, 180, 220, alpha));
-            target.draw(trail);
-        }
+        sf::Vector2f purse = toScreen(getSwingPoint());
+        float purseX = purse.x;
+        float purseY = purse.y;
 
         // Purse at current position
-        sf::RectangleShape purseHit({12.0f, 10.0f});
-        purseHit.setOrigin({6.0f, 5.0f});
-        purseHit.setPosition({purseX, purseY});
-        purseHit.setRotation(sf::degrees(swingAngle));
-        purseHit.setFillColor(sf::Color(200, 80, 150, static_cast<uint8_t>(220 * (1.0f - prog))));
-        purseHit.setOutlineColor(sf::Color(150, 50, 100, static_cast<uint8_t>(200 * (1.0f - prog))));
-        purseHit.setOutlineThickness(1.0f);
-        target.draw(purseHit);
+        batch.rect({purseX, purseY}, {12.0f, 10.0f}, {6.0f, 5.0f}, swingAngle,
+                  sf::Color(200, 80, 150, static_cast<uint8_t>(220 * (1.0f - prog))),
+                  sf::Color(150, 50, 100, static_cast<uint8_t>(200 * (1.0f - prog))), 1.0f);
 
         // Impact star at end of swing
         if (prog > 0.6f && prog < 0.9f) {
             float starSz = 8.0f * (1.0f - (prog - 0.6f) / 0.3f);
             for (int s = 0; s < 4; s++) {
                 float a = static_cast<float>(s) * 0.785f + m_animTime * 3.0f;
-                sf::VertexArray ray(sf::PrimitiveType::Lines, 2);
-                ray[0] = sf::Vertex{{purseX, purseY}, sf::Color(255, 255, 100, 200)};
-                ray[1] = sf::Vertex{{purseX + std::cos(a) * starSz,
-                                      purseY + std::sin(a) * starSz}, sf::Color(255, 255, 100, 60)};
-                target.draw(ray);
+                batch.line({purseX, purseY}, {purseX + std::cos(a) * starSz, purseY + std::sin(a) * starSz},
+                          sf::Color(255, 255, 100, 200), sf::Color(255, 255, 100, 60));
             }
         }
-    } else if (m_weapon.type == WeaponType::Melee && m_charType == CharacterType::Crocodile) {
+    } else if (m_weapon->type == WeaponType::Melee && m_charType == CharacterType::Crocodile) {
         // Jaw snap effect — closing jaws with impact lines
         float snapProg = prog; // 0 = start, 1 = fully snapped
         float jawAngle = (1.0f - std::abs(snapProg * 2.0f - 1.0f)) * 25.0f; // opens then snaps
+        sf::Color jawColor(200, 200, 180, static_cast<uint8_t>(200 * (1.0f - prog)));
 
         // Upper jaw line
-        float jawLen = m_weapon.range * PPM * 0.5f;
-        sf::ConvexShape upperJaw(3);
-        upperJaw.setPoint(0, {sp.x + dir * 10.0f, sp.y - 8.0f});
-        upperJaw.setPoint(1, {sp.x + dir * (10.0f + jawLen), sp.y - 8.0f - jawAngle * 0.5f});
-        upperJaw.setPoint(2, {sp.x + dir * (10.0f + jawLen * 0.8f), sp.y - 2.0f});
-        upperJaw.setFillColor(sf::Color(200, 200, 180, static_cast<uint8_t>(200 * (1.0f - prog))));
-        target.draw(upperJaw);
+        float jawLen = m_weapon->range * PPM * 0.5f;
+        batch.convex({{sp.x + dir * 10.0f, sp.y - 8.0f},
+                     {sp.x + dir * (10.0f + jawLen), sp.y - 8.0f - jawAngle * 0.5f},
+                     {sp.x + dir * (10.0f + jawLen * 0.8f), sp.y - 2.0f}},
+                    jawColor);
 
         // Lower jaw line
-        sf::ConvexShape lowerJaw(3);
-        lowerJaw.setPoint(0, {sp.x + dir * 10.0f, sp.y + 4.0f});
-        lowerJaw.setPoint(1, {sp.x + dir * (10.0f + jawLen), sp.y + 4.0f + jawAngle * 0.5f});
-        lowerJaw.setPoint(2, {sp.x + dir * (10.0f + jawLen * 0.8f), sp.y});
-        lowerJaw.setFillColor(sf::Color(200, 200, 180, static_cast<uint8_t>(200 * (1.0f - prog))));
-        target.draw(lowerJaw);
+        batch.convex({{sp.x + dir * 10.0f, sp.y + 4.0f},
+                     {sp.x + dir * (10.0f + jawLen), sp.y + 4.0f + jawAngle * 0.5f},
+                     {sp.x + dir * (10.0f + jawLen * 0.8f), sp.y}},
+                    jawColor);
 
         // Impact crunch lines at snap moment
         if (snapProg > 0.4f && snapProg < 0.7f) {
@@ -1222,17 +1067,14 @@ void StickFigure::drawAttackEffect(sf::RenderTarget& target) const {
             for (int i = 0; i < 6; i++) {
                 float angle = static_cast<float>(i) / 6.0f * 6.28f;
                 float len2 = 6.0f + std::sin(m_animTime * 10.0f + angle) * 3.0f;
-                sf::VertexArray line(sf::PrimitiveType::Lines, 2);
-                line[0] = sf::Vertex{{impactX, impactY}, sf::Color(255, 255, 200, 200)};
-                line[1] = sf::Vertex{{impactX + std::cos(angle) * len2,
-                                       impactY + std::sin(angle) * len2},
-                                      sf::Color(255, 255, 200, 80)};
-                target.draw(line);
+                batch.line({impactX, impactY},
+                          {impactX + std::cos(angle) * len2, impactY + std::sin(angle) * len2},
+                          sf::Color(255, 255, 200, 200), sf::Color(255, 255, 200, 80));
             }
         }
-    } else if (m_weapon.type == WeaponType::Melee && m_charType == CharacterType::Unicorn) {
+    } else if (m_weapon->type == WeaponType::Melee && m_charType == CharacterType::Unicorn) {
         // Magical horn blast — expanding rainbow ring
-        float arcR = m_weapon.range * PPM * 0.7f * prog;
+        float arcR = m_weapon->range * PPM * 0.7f * prog;
         constexpr int particles = 12;
         for (int i = 0; i < particles; i++) {
             float angle = static_cast<float>(i) / static_cast<float>(particles) * 6.28318f;
@@ -1243,24 +1085,17 @@ void StickFigure::drawAttackEffect(sf::RenderTarget& target) const {
             float r = std::sin(m_animTime * 3.0f + phase) * 0.5f + 0.5f;
             float g = std::sin(m_animTime * 3.0f + phase + 2.094f) * 0.5f + 0.5f;
             float b = std::sin(m_animTime * 3.0f + phase + 4.189f) * 0.5f + 0.5f;
-            sf::CircleShape dot(sz, 4);
-            dot.setOrigin({sz, sz}); dot.setPosition({px, py});
-            dot.setFillColor(sf::Color(
+            batch.circle({px, py}, sz, sf::Color(
                 static_cast<uint8_t>(r * 255),
                 static_cast<uint8_t>(g * 255),
                 static_cast<uint8_t>(b * 255),
-                static_cast<uint8_t>(220 * (1.0f - prog))));
-            target.draw(dot);
+                static_cast<uint8_t>(220 * (1.0f - prog))), 4);
         }
         // Central flash
-        float flashSz = 8.0f * (1.0f - prog);
-        sf::CircleShape flash(flashSz);
-        flash.setOrigin({flashSz, flashSz});
-        flash.setPosition({sp.x + dir * 15.0f, sp.y - 15.0f});
-        flash.setFillColor(sf::Color(255, 255, 255, static_cast<uint8_t>(180 * (1.0f - prog))));
-        target.draw(flash);
-    } else if (m_weapon.type == WeaponType::Melee) {
-        float arcR = m_weapon.range * PPM * 0.6f;
+        batch.circle({sp.x + dir * 15.0f, sp.y - 15.0f}, 8.0f * (1.0f - prog),
+                    sf::Color(255, 255, 255, static_cast<uint8_t>(180 * (1.0f - prog))));
+    } else if (m_weapon->type == WeaponType::Melee) {
+        float arcR = m_weapon->range * PPM * 0.6f;
         int segs = 8;
         for (int i = 0; i <= segs; i++) {
             float t = static_cast<float>(i) / static_cast<float>(segs);
@@ -1269,22 +1104,18 @@ void StickFigure::drawAttackEffect(sf::RenderTarget& target) const {
             float ax = sp.x + dir * std::cos(angle) * arcR;
             float ay = sp.y - std::sin(angle) * arcR;
             float ds = 3.0f * (1.0f - t * 0.5f);
-            sf::CircleShape dot(ds); dot.setOrigin({ds, ds}); dot.setPosition({ax, ay});
-            dot.setFillColor(sf::Color(255, 255, 255, static_cast<uint8_t>(255 * (1.0f - prog))));
-            target.draw(dot);
+            batch.circle({ax, ay}, ds, sf::Color(255, 255, 255, static_cast<uint8_t>(255 * (1.0f - prog))));
         }
     } else {
         // Muzzle flash
         float fs = 6.0f * (1.0f - prog);
-        sf::CircleShape flash(fs); flash.setOrigin({fs, fs});
         float aimY = -std::sin(m_aimAngle) * 20.0f;
-        flash.setPosition({sp.x + dir * 20.0f, sp.y - 5.0f + aimY});
-        flash.setFillColor(sf::Color(255, 255, 0, static_cast<uint8_t>(200 * (1.0f - prog))));
-        target.draw(flash);
+        batch.circle({sp.x + dir * 20.0f, sp.y - 5.0f + aimY}, fs,
+                    sf::Color(255, 255, 0, static_cast<uint8_t>(200 * (1.0f - prog))));
     }
 }
 
-void StickFigure::drawAimIndicator(sf::RenderTarget& target) const {
+void StickFigure::drawAimIndicator(ShapeBatch& batch) const {
     sf::Vector2f sp = toScreen(getPosition());
     float dir = static_cast<float>(m_facingDir);
 
@@ -1297,9 +1128,8 @@ void StickFigure::drawAimIndicator(sf::RenderTarget& target) const {
         float t = static_cast<float>(i) / 4.0f;
         float dx = dir * cosA * len * t;
         float dy = -sinA * len * t; // negative because screen Y is flipped
-        sf::CircleShape dot(1.5f); dot.setOrigin({1.5f, 1.5f});
-        dot.setPosition({sp.x + dx, sp.y - 5.0f + dy});
-        dot.setFillColor(sf::Color(255, 255, 255, 120));
-        target.draw(dot);
+        batch.circle({sp.x + dx, sp.y - 5.0f + dy}, 1.5f, sf::Color(255, 255, 255, 120));
     }
 }
+
+#endif // STICKBRAWL_HEADLESS
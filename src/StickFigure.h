@@ -1,7 +1,15 @@
 #pragma once
 #include "Physics.h"
 #include "Weapon.h"
+#include "WeaponFactory.h"
+#include "StateBuffer.h"
+#include <array>
+#ifdef STICKBRAWL_HEADLESS
+#include <SFML/Graphics/Color.hpp>  // header-only value type, no SFML libs linked
+#else
 #include <SFML/Graphics.hpp>
+#include "ShapeBatch.h"
+#endif
 
 struct StickFigureConfig {
     float bodyHeight = 1.8f;
@@ -54,8 +62,11 @@ public:
 
     bool canAttack() const;
     void attack();
+    bool isAttacking() const { return m_attackAnimTimer > 0.0f; }
+    // Where the current melee swing has reached, in world meters
+    b2Vec2 getSwingPoint() const;
     void equipWeapon(const WeaponData& weapon);
-    const WeaponData& getCurrentWeapon() const { return m_weapon; }
+    const WeaponData& getCurrentWeapon() const { return *m_weapon; }
     int getAmmo() const { return m_currentAmmo; }
 
     void takeDamage(float amount, float knockbackX, float knockbackY);
@@ -80,21 +91,40 @@ public:
     b2Vec2 getPosition() const;
     int getFacingDirection() const { return m_facingDir; }
 
+#ifndef STICKBRAWL_HEADLESS
+    // One draw call for this figure alone
     void draw(sf::RenderTarget& target) const;
+    // Poses this figure into a shared batch; the match view batches all players
+    void draw(ShapeBatch& batch) const;
+#endif
 
     b2BodyId getTorsoBodyId() const { return m_torso; }
+
+    // Ragdoll parts in a fixed order: torso, head, left/right arm, left/right leg
+    static constexpr int PART_COUNT = 6;
+    std::array<b2BodyId, PART_COUNT> getPartBodyIds() const {
+        return {m_torso, m_head, m_leftArm, m_rightArm, m_leftLeg, m_rightLeg};
+    }
     bool isOnGround() const;
 
+    // Ragdoll body states plus every gameplay field that changes during play.
+    // loadState expects a freshly reset world and recreates the ragdoll in it.
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in, const WeaponFactory& weapons);
+
 private:
     void createBodies(Physics& physics, float spawnX, float spawnY);
-    void drawStick(sf::RenderTarget& target) const;
-    void drawCat(sf::RenderTarget& target) const;
-    void drawCobra(sf::RenderTarget& target) const;
-    void drawUnicorn(sf::RenderTarget& target) const;
-    void drawCrocodile(sf::RenderTarget& target) const;
-    void drawStickLady(sf::RenderTarget& target) const;
-    void drawAttackEffect(sf::RenderTarget& target) const;
-    void drawAimIndicator(sf::RenderTarget& target) const;
+    void loseHealth(float amount);  // clamps at zero and marks the death on traces
+#ifndef STICKBRAWL_HEADLESS
+    void drawStick(ShapeBatch& batch) const;
+    void drawCat(ShapeBatch& batch) const;
+    void drawCobra(ShapeBatch& batch) const;
+    void drawUnicorn(ShapeBatch& batch) const;
+    void drawCrocodile(ShapeBatch& batch) const;
+    void drawStickLady(ShapeBatch& batch) const;
+    void drawAttackEffect(ShapeBatch& batch) const;
+    void drawAimIndicator(ShapeBatch& batch) const;
+#endif
 
     int           m_playerIndex;
     sf::Color     m_color;
@@ -123,7 +153,7 @@ private:
     float m_poisonDps = 0.0f;
     float m_poisonTickTimer = 0.0f;
 
-    WeaponData m_weapon;
+    const WeaponData* m_weapon = &builtinFists();  // interned, never null
     int        m_currentAmmo = -1;
 
     float m_moveSpeed = 8.0f;
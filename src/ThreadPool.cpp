@@ -0,0 +1,63 @@
+#include "ThreadPool.h"
+#include "Profiler.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 1; i < threads; i++) m_workers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& t : m_workers) t.join();
+}
+
+void ThreadPool::runItems() {
+    for (int i = m_next.fetch_add(1); i < m_count; i = m_next.fetch_add(1)) (*m_job)(i);
+}
+
+void ThreadPool::workerLoop() {
+    PROFILE_THREAD_NAME("pool worker");
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop) return;
+            seen = m_generation;
+        }
+
+        runItems();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busy == 0) m_done.notify_one();
+    }
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& fn) {
+    if (count <= 0) return;
+    if (m_workers.empty() || count == 1) {
+        for (int i = 0; i < count; i++) fn(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &fn;
+        m_count = count;
+        m_next.store(0);
+        m_busy = static_cast<int>(m_workers.size());
+        m_generation++;
+    }
+    m_wake.notify_all();
+
+    runItems();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [&] { return m_busy == 0; });
+    m_job = nullptr;
+}
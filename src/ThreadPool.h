@@ -0,0 +1,41 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. parallelFor hands out
+// indices one at a time, so uneven items (a lobby mid-explosion next to an
+// idle one) balance themselves. The calling thread works too.
+class ThreadPool {
+public:
+    // 0 = one thread per hardware thread (the caller counts as one)
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Runs fn(i) for every i in [0, count) and returns once all are done
+    void parallelFor(int count, const std::function<void(int)>& fn);
+
+    int getThreadCount() const { return static_cast<int>(m_workers.size()) + 1; }
+
+private:
+    void workerLoop();
+    void runItems();
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+
+    const std::function<void(int)>* m_job = nullptr;
+    std::atomic<int> m_next{0};
+    int      m_count = 0;
+    int      m_busy = 0;        // workers still inside the current job
+    uint64_t m_generation = 0;  // bumped per job so workers run each one once
+    bool     m_stop = false;
+};
@@ -0,0 +1,160 @@
+#include "UdpSocket.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using SocketLen = int;
+using NativeSocket = SOCKET;
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using SocketLen = socklen_t;
+using NativeSocket = int;
+#endif
+
+namespace {
+
+#ifdef _WIN32
+// Winsock must be started once per process before any socket call
+bool ensureWinsock() {
+    static bool started = [] {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    return started;
+}
+constexpr intptr_t INVALID_HANDLE = static_cast<intptr_t>(INVALID_SOCKET);
+#else
+constexpr intptr_t INVALID_HANDLE = -1;
+#endif
+
+NativeSocket native(intptr_t handle) { return static_cast<NativeSocket>(handle); }
+
+sockaddr_in toSockaddr(const NetAddress& addr) {
+    sockaddr_in sa{};
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = htonl(addr.ip);
+    sa.sin_port = htons(addr.port);
+    return sa;
+}
+
+} // namespace
+
+// ============================================================
+// ADDRESS
+// ============================================================
+
+bool NetAddress::parse(const std::string& text, NetAddress& out) {
+    size_t colon = text.rfind(':');
+    if (colon == std::string::npos) return false;
+    std::string host = text.substr(0, colon);
+    int port = std::atoi(text.c_str() + colon + 1);
+    if (port <= 0 || port > 65535) return false;
+    if (host == "localhost") host = "127.0.0.1";
+
+    unsigned a, b, c, d;
+    char tail;
+    if (std::sscanf(host.c_str(), "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4 ||
+        a > 255 || b > 255 || c > 255 || d > 255) return false;
+
+    out.ip = (a << 24) | (b << 16) | (c << 8) | d;
+    out.port = static_cast<uint16_t>(port);
+    return true;
+}
+
+std::string NetAddress::toString() const {
+    return std::to_string((ip >> 24) & 0xFF) + "." + std::to_string((ip >> 16) & 0xFF) + "." +
+           std::to_string((ip >> 8) & 0xFF) + "." + std::to_string(ip & 0xFF) + ":" +
+           std::to_string(port);
+}
+
+// ============================================================
+// SOCKET
+// ============================================================
+
+bool UdpSocket::open(uint16_t port) {
+    close();
+#ifdef _WIN32
+    if (!ensureWinsock()) {
+        std::cerr << "[UdpSocket] WSAStartup failed\n";
+        return false;
+    }
+#endif
+    intptr_t handle = static_cast<intptr_t>(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+    if (handle == INVALID_HANDLE) {
+        std::cerr << "[UdpSocket] socket() failed\n";
+        return false;
+    }
+    m_handle = handle;
+
+    sockaddr_in sa = toSockaddr({INADDR_ANY, port});
+    if (bind(native(m_handle),
+             reinterpret_cast<const sockaddr*>(&sa), sizeof(sa)) != 0) {
+        std::cerr << "[UdpSocket] Failed to bind port " << port << "\n";
+        close();
+        return false;
+    }
+
+#ifdef _WIN32
+    u_long nonBlocking = 1;
+    ioctlsocket(native(m_handle), FIONBIO, &nonBlocking);
+#else
+    fcntl(native(m_handle), F_SETFL, fcntl(native(m_handle), F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+    sockaddr_in bound{};
+    SocketLen len = sizeof(bound);
+    getsockname(native(m_handle), reinterpret_cast<sockaddr*>(&bound), &len);
+    m_port = ntohs(bound.sin_port);
+    return true;
+}
+
+void UdpSocket::close() {
+    if (m_handle == INVALID_HANDLE) return;
+#ifdef _WIN32
+    closesocket(native(m_handle));
+#else
+    ::close(native(m_handle));
+#endif
+    m_handle = INVALID_HANDLE;
+    m_port = 0;
+}
+
+bool UdpSocket::isOpen() const {
+    return m_handle != INVALID_HANDLE;
+}
+
+bool UdpSocket::send(const NetAddress& to, const void* data, size_t size) {
+    if (!isOpen()) return false;
+    sockaddr_in sa = toSockaddr(to);
+    auto sent = sendto(native(m_handle),
+                       static_cast<const char*>(data), static_cast<int>(size), 0,
+                       reinterpret_cast<const sockaddr*>(&sa), sizeof(sa));
+    return sent == static_cast<decltype(sent)>(size);
+}
+
+int UdpSocket::receive(void* buffer, size_t capacity, NetAddress& from) {
+    if (!isOpen()) return -1;
+    sockaddr_in sa{};
+    SocketLen len = sizeof(sa);
+    auto got = recvfrom(native(m_handle),
+                        static_cast<char*>(buffer), static_cast<int>(capacity), 0,
+                        reinterpret_cast<sockaddr*>(&sa), &len);
+    // Would-block, and on Windows ICMP port-unreachable resets, read as "nothing"
+    if (got < 0) return -1;
+    from.ip = ntohl(sa.sin_addr.s_addr);
+    from.port = ntohs(sa.sin_port);
+    return static_cast<int>(got);
+}
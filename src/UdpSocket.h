@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// IPv4 endpoint, host byte order
+struct NetAddress {
+    uint32_t ip = 0;
+    uint16_t port = 0;
+
+    // "a.b.c.d:port" or "localhost:port"
+    static bool parse(const std::string& text, NetAddress& out);
+    std::string toString() const;
+
+    bool operator==(const NetAddress& o) const { return ip == o.ip && port == o.port; }
+    bool operator!=(const NetAddress& o) const { return !(*this == o); }
+};
+
+// Non-blocking IPv4 UDP socket (Winsock on Windows, BSD sockets elsewhere)
+class UdpSocket {
+public:
+    UdpSocket() = default;
+    ~UdpSocket() { close(); }
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    // Binds to `port` on all interfaces; 0 picks an ephemeral port
+    bool open(uint16_t port);
+    void close();
+    bool isOpen() const;
+    uint16_t getLocalPort() const { return m_port; }
+
+    bool send(const NetAddress& to, const void* data, size_t size);
+
+    // Returns the datagram size, or -1 when nothing is waiting
+    int receive(void* buffer, size_t capacity, NetAddress& from);
+
+private:
+    intptr_t m_handle = -1;  // SOCKET on Windows, fd elsewhere
+    uint16_t m_port = 0;
+};
@@ -1,4 +1,5 @@
 #include "Weapon.h"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -8,6 +9,34 @@ WeaponType parseWeaponType(const std::string& s) {
     return WeaponType::Melee;
 }
 
+const WeaponData& builtinFists() {
+    static const WeaponData fists;
+    return fists;
+}
+
+static sf::Color parseColor(const nlohmann::json& j, sf::Color fallback) {
+    if (!j.is_array() || j.size() < 3) return fallback;
+    auto channel = [&](size_t i) { return static_cast<uint8_t>(std::clamp(j[i].get<int>(), 0, 255)); };
+    return {channel(0), channel(1), channel(2), j.size() > 3 ? channel(3) : uint8_t(255)};
+}
+
+ParticleEmitter parseParticleEmitter(const nlohmann::json& j, const ParticleEmitter& defaults) {
+    ParticleEmitter e = defaults;
+    if (j.contains("count"))            e.count = j["count"];
+    if (j.contains("speed"))            e.speed = j["speed"];
+    if (j.contains("speed_jitter"))     e.speedJitter = j["speed_jitter"];
+    if (j.contains("direction_degrees")) e.directionDegrees = j["direction_degrees"];
+    if (j.contains("spread_degrees"))   e.spreadDegrees = j["spread_degrees"];
+    if (j.contains("lifetime"))         e.lifetime = j["lifetime"];
+    if (j.contains("lifetime_jitter"))  e.lifetimeJitter = j["lifetime_jitter"];
+    if (j.contains("size"))             e.size = j["size"];
+    if (j.contains("gravity"))          e.gravity = j["gravity"];
+    if (j.contains("drag"))             e.drag = j["drag"];
+    if (j.contains("color"))            e.color = parseColor(j["color"], e.color);
+    if (j.contains("color_end"))        e.colorEnd = parseColor(j["color_end"], e.colorEnd);
+    return e;
+}
+
 WeaponData loadWeaponFromFile(const std::string& path) {
     WeaponData w;
     std::ifstream file(path);
@@ -37,6 +66,9 @@ WeaponData loadWeaponFromFile(const std::string& path) {
         if (j.contains("env_damage_radius"))             w.envDamageRadius = j["env_damage_radius"];
         if (j.contains("poison_dps"))                   w.poisonDps = j["poison_dps"];
         if (j.contains("poison_duration"))              w.poisonDuration = j["poison_duration"];
+        if (j.contains("hit_particles"))                w.hitParticles = parseParticleEmitter(j["hit_particles"], w.hitParticles);
+        if (j.contains("explosion_particles"))          w.explosionParticles = parseParticleEmitter(j["explosion_particles"], w.explosionParticles);
+        if (j.contains("trail_particles"))              w.trailParticles = parseParticleEmitter(j["trail_particles"], w.trailParticles);
         if (j.contains("sprite"))                       w.sprite = j["sprite"];
         if (j.contains("projectile_sprite"))            w.projectileSprite = j["projectile_sprite"];
         if (j.contains("sound_hit"))                    w.soundHit = j["sound_hit"];
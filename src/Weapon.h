@@ -1,6 +1,12 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <nlohmann/json.hpp>
+#include <SFML/Graphics/Color.hpp>  // header-only value type
+
+// Index into WeaponFactory's table, assigned at load time
+using WeaponId = uint16_t;
+constexpr WeaponId INVALID_WEAPON_ID = 0xFFFF;
 
 enum class WeaponType {
     Melee,
@@ -8,7 +14,25 @@ enum class WeaponType {
     Explosive
 };
 
+// One burst of cosmetic particles, in world units. The direction is mirrored
+// when the effect faces left (hit knockback, swing direction).
+struct ParticleEmitter {
+    int       count = 0;                // particles per burst; 0 = none
+    float     speed = 4.0f;             // m/s
+    float     speedJitter = 0.5f;       // +- fraction of speed
+    float     directionDegrees = 90.0f; // 0 = forward, 90 = up
+    float     spreadDegrees = 360.0f;   // cone around the direction
+    float     lifetime = 0.5f;          // seconds
+    float     lifetimeJitter = 0.3f;    // +- fraction of lifetime
+    float     size = 2.0f;              // half-width in pixels
+    float     gravity = -9.8f;          // m/s^2, world y is up
+    float     drag = 1.0f;              // 1/s
+    sf::Color color = sf::Color::White;
+    sf::Color colorEnd = sf::Color(255, 255, 255, 0);
+};
+
 struct WeaponData {
+    WeaponId    id = INVALID_WEAPON_ID;
     std::string name = "Fists";
     WeaponType  type = WeaponType::Melee;
     float       damage = 10.0f;
@@ -35,6 +59,12 @@ struct WeaponData {
     float       poisonDps = 0.0f;
     float       poisonDuration = 0.0f;
 
+    // Particles: on hitting a player, on detonation, and along a melee swing
+    ParticleEmitter hitParticles = {6, 5.0f, 0.5f, 30.0f, 120.0f, 0.3f, 0.3f, 1.5f, -9.8f, 2.0f,
+                                    sf::Color(255, 240, 180), sf::Color(255, 120, 40, 0)};
+    ParticleEmitter explosionParticles;
+    ParticleEmitter trailParticles;
+
     // Assets
     std::string sprite;
     std::string projectileSprite;
@@ -45,4 +75,10 @@ struct WeaponData {
 };
 
 WeaponType parseWeaponType(const std::string& s);
+
+// Built-in bare fists, used when nothing else is equipped
+const WeaponData& builtinFists();
 WeaponData loadWeaponFromFile(const std::string& path);
+
+// Fields present in `j` override `defaults`; colors are [r, g, b] or [r, g, b, a]
+ParticleEmitter parseParticleEmitter(const nlohmann::json& j, const ParticleEmitter& defaults);
@@ -1,36 +1,49 @@
 #include "WeaponFactory.h"
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
-#include <random>
 
 namespace fs = std::filesystem;
 
+// Character-bound weapons that never spawn as pickups
+static bool isInnateWeapon(const std::string& name) {
+    return name == "Fists" || name == "Poison Spit" || name == "Horn Blast"
+        || name == "Jaw Snap" || name == "Purse Swing";
+}
+
 bool WeaponFactory::loadWeaponsFromDirectory(const std::string& dir) {
     m_weapons.clear();
     m_nameIndex.clear();
+    m_pickupIds.clear();
 
     if (!fs::exists(dir)) {
         std::cerr << "[WeaponFactory] Directory not found: " << dir << "\n";
         return false;
     }
 
-    for (const auto& entry : fs::directory_iterator(dir)) {
-        if (entry.path().extension() == ".json") {
-            WeaponData w = loadWeaponFromFile(entry.path().string());
-            m_nameIndex[w.name] = m_weapons.size();
-            m_weapons.push_back(std::move(w));
-        }
+    // WeaponIds and the pickup table follow file order, and matches, replays
+    // and rollback peers all depend on them: sort instead of trusting
+    // directory_iterator, whose order is unspecified
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::directory_iterator(dir))
+        if (entry.path().extension() == ".json") files.push_back(entry.path());
+    std::sort(files.begin(), files.end());
+
+    for (const auto& path : files) {
+        WeaponData w = loadWeaponFromFile(path.string());
+        w.id = static_cast<WeaponId>(m_weapons.size());
+        m_nameIndex[w.name] = m_weapons.size();
+        if (!isInnateWeapon(w.name)) m_pickupIds.push_back(w.id);
+        m_weapons.push_back(std::move(w));
     }
 
     std::cout << "[WeaponFactory] Loaded " << m_weapons.size() << " weapons from " << dir << "\n";
     return !m_weapons.empty();
 }
 
-const WeaponData& WeaponFactory::getRandomWeapon() const {
-    if (m_weapons.empty()) return m_defaultFists;
-    static std::mt19937 rng(std::random_device{}());
-    std::uniform_int_distribution<size_t> dist(0, m_weapons.size() - 1);
-    return m_weapons[dist(rng)];
+const WeaponData& WeaponFactory::getRandomWeapon(Rng& rng) const {
+    if (m_weapons.empty()) return builtinFists();
+    return m_weapons[rng.uniformInt(0, static_cast<int>(m_weapons.size()) - 1)];
 }
 
 const WeaponData* WeaponFactory::getWeapon(const std::string& name) const {
@@ -39,7 +52,17 @@ const WeaponData* WeaponFactory::getWeapon(const std::string& name) const {
     return nullptr;
 }
 
+const WeaponData* WeaponFactory::getRandomPickupWeapon(Rng& rng) const {
+    if (m_pickupIds.empty()) return nullptr;
+    return &m_weapons[m_pickupIds[rng.uniformInt(0, static_cast<int>(m_pickupIds.size()) - 1)]];
+}
+
+const WeaponData& WeaponFactory::getWeaponById(WeaponId id) const {
+    if (id < m_weapons.size()) return m_weapons[id];
+    return builtinFists();
+}
+
 const WeaponData& WeaponFactory::getDefaultWeapon() const {
     auto* fists = getWeapon("Fists");
-    return fists ? *fists : m_defaultFists;
+    return fists ? *fists : builtinFists();
 }
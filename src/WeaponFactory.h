@@ -1,19 +1,28 @@
 #pragma once
 #include "Weapon.h"
+#include "Rng.h"
 #include <vector>
 #include <string>
 #include <unordered_map>
 
+// Owns the interned weapon definitions. Everything else refers to them by
+// const pointer or WeaponId; both stay valid until the next
+// loadWeaponsFromDirectory call.
 class WeaponFactory {
 public:
     bool loadWeaponsFromDirectory(const std::string& dir);
-    const WeaponData& getRandomWeapon() const;
+    const WeaponData& getRandomWeapon(Rng& rng) const;
     const WeaponData* getWeapon(const std::string& name) const;
+    const WeaponData& getWeaponById(WeaponId id) const;
     const WeaponData& getDefaultWeapon() const;
     const std::vector<WeaponData>& getAllWeapons() const { return m_weapons; }
 
+    // Random weapon that may appear as a pickup (no fists or innate weapons);
+    // nullptr if none are loaded
+    const WeaponData* getRandomPickupWeapon(Rng& rng) const;
+
 private:
     std::vector<WeaponData> m_weapons;
     std::unordered_map<std::string, size_t> m_nameIndex;
-    WeaponData m_defaultFists;
+    std::vector<WeaponId> m_pickupIds;
 };
@@ -1,7 +1,100 @@
 #include "Game.h"
+#include "Profiler.h"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <random>
+#include <string>
+
+// Online versus: StickBrawl --online --port 7000 --peer 127.0.0.1:7001 --player 1
+// Frame trace:   StickBrawl --trace trace.json  (profiling builds only)
+static bool parseArgs(int argc, char** argv, bool& online, RollbackConfig& config, SessionParams& params,
+                      std::string& tracePath) {
+    config.localPlayer = 0;
+    params.seed = (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+    bool peerGiven = false;
+
+    for (int i = 1; i < argc; i++) {
+        auto value = [&](const char* flag) -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << flag << "\n";
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        if (!std::strcmp(argv[i], "--online")) {
+            online = true;
+        } else if (!std::strcmp(argv[i], "--port")) {
+            const char* v = value("--port"); if (!v) return false;
+            config.localPort = static_cast<uint16_t>(std::atoi(v));
+        } else if (!std::strcmp(argv[i], "--peer")) {
+            const char* v = value("--peer"); if (!v) return false;
+            if (!NetAddress::parse(v, config.peer)) {
+                std::cerr << "Bad peer address (want a.b.c.d:port): " << v << "\n";
+                return false;
+            }
+            peerGiven = true;
+        } else if (!std::strcmp(argv[i], "--player")) {
+            const char* v = value("--player"); if (!v) return false;
+            config.localPlayer = std::atoi(v) - 1;
+        } else if (!std::strcmp(argv[i], "--delay")) {
+            const char* v = value("--delay"); if (!v) return false;
+            config.inputDelay = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--rollback")) {
+            const char* v = value("--rollback"); if (!v) return false;
+            config.maxRollback = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--latency")) {
+            const char* v = value("--latency"); if (!v) return false;
+            config.conditions.latencyMs = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--jitter")) {
+            const char* v = value("--jitter"); if (!v) return false;
+            config.conditions.jitterMs = std::atoi(v);
+        } else if (!std::strcmp(argv[i], "--loss")) {
+            const char* v = value("--loss"); if (!v) return false;
+            config.conditions.lossPercent = static_cast<float>(std::atof(v));
+        } else if (!std::strcmp(argv[i], "--char")) {
+            const char* v = value("--char"); if (!v) return false;
+            params.characters[0] = params.characters[1] =
+                static_cast<CharacterType>(std::abs(std::atoi(v)) % CHARACTER_TYPE_COUNT);
+        } else if (!std::strcmp(argv[i], "--level")) {
+            const char* v = value("--level"); if (!v) return false;
+            params.levelIndex = std::atoi(v) % Arena::getLevelCount();
+        } else if (!std::strcmp(argv[i], "--trace")) {
+            const char* v = value("--trace"); if (!v) return false;
+#ifndef STICKBRAWL_PROFILE
+            std::cerr << "--trace needs a build configured with -DSTICKBRAWL_PROFILE=ON\n";
+            return false;
+#endif
+            tracePath = v;
+        } else {
+            std::cerr << "Unknown option " << argv[i] << "\n"
+                      << "Usage: StickBrawl [--trace FILE]\n"
+                      << "                  [--online --port N --peer HOST:PORT --player 1|2\n"
+                      << "                   [--delay TICKS] [--rollback TICKS] [--char N] [--level N]\n"
+                      << "                   [--latency MS] [--jitter MS] [--loss PERCENT]]\n";
+            return false;
+        }
+    }
+
+    if (online && !peerGiven) {
+        std::cerr << "--online needs --peer\n";
+        return false;
+    }
+    if (config.localPlayer < 0 || config.localPlayer > 1) {
+        std::cerr << "--player must be 1 or 2\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    bool online = false;
+    RollbackConfig onlineConfig;
+    SessionParams onlineParams;
+    std::string tracePath;
+    if (!parseArgs(argc, argv, online, onlineConfig, onlineParams, tracePath)) return 1;
 
-int main() {
     std::cout << "=== StickBrawl ===\n";
     std::cout << "Controls:\n";
     std::cout << "  Player 1: WASD move, F attack, E/Q aim up/down\n";
@@ -13,14 +106,25 @@ int main() {
     std::cout << "  Character Select: LEFT/RIGHT to pick character, ATK to ready\n";
     std::cout << "  TAB to cycle levels | ` to toggle wrap-around | ENTER/SPACE to start\n";
     std::cout << "  Walk over glowing boxes to pick up weapons!\n";
-    std::cout << "  ESC to quit, R to restart round, Backspace to return to select\n\n";
+    std::cout << "  ESC to quit, R to restart round, Backspace to return to select\n";
+    std::cout << "  Online: each side plays with the Player 1 keys\n\n";
 
     Game game;
+    if (online) game.configureOnline(onlineConfig, onlineParams);
     if (!game.init()) {
         std::cerr << "Failed to initialize game\n";
         return 1;
     }
 
+#ifdef STICKBRAWL_PROFILE
+    if (!tracePath.empty()) {
+        PROFILE_THREAD_NAME("main");
+        Profiler::beginTrace();
+    }
+#endif
     game.run();
+#ifdef STICKBRAWL_PROFILE
+    if (!tracePath.empty()) Profiler::writeTrace(tracePath);
+#endif
     return 0;
 }